@@ -0,0 +1,117 @@
+// ============================================================
+// AdapterProfile.cpp — Adapter kinds and their RX latency
+// ============================================================
+
+#include "pch.h"
+#include "AdapterProfile.h"
+#include <cstdio>
+
+namespace FuelMaster {
+
+    namespace
+    {
+        struct KindProfile
+        {
+            AdapterKind kind;
+            const char* name;
+            int latencyMs;
+        };
+
+        // Latency with the driver's factory settings (what is paid
+        // when nothing could be tuned)
+        const KindProfile KIND_PROFILES[] = {
+            { AdapterKind::Unknown,  "unknown",   16 },    // assume the slowest common dongle
+            { AdapterKind::Native,   "native",     5 },    // 16550 FIFO timeout: 4 characters, 4.2 ms at 9600
+            { AdapterKind::Ftdi,     "FTDI",      16 },    // latency timer default
+            { AdapterKind::Ch340,    "CH340",      4 },    // flushes RX after a short idle gap
+            { AdapterKind::Pl2303,   "PL2303",     4 },
+            { AdapterKind::Cp210x,   "CP210x",     2 },
+            { AdapterKind::CdcAcm,   "CDC-ACM",    2 },    // firmware-defined, usually immediate
+            { AdapterKind::UsbOther, "USB",       16 },
+            { AdapterKind::Network,  "network",   20 },    // serial server packing timer + LAN
+            { AdapterKind::Virtual,  "virtual",    0 },
+        };
+
+        struct UsbId
+        {
+            uint16_t vendorId;
+            uint16_t productId;     // 0 = any product of the vendor
+            AdapterKind kind;
+        };
+
+        const UsbId USB_IDS[] = {
+            { 0x0403, 0,      AdapterKind::Ftdi },      // FTDI (all VCP chips)
+            { 0x1A86, 0x7523, AdapterKind::Ch340 },
+            { 0x1A86, 0x5523, AdapterKind::Ch340 },     // CH341 in serial mode
+            { 0x1A86, 0x55D4, AdapterKind::Ch340 },     // CH9102
+            { 0x067B, 0,      AdapterKind::Pl2303 },
+            { 0x10C4, 0xEA60, AdapterKind::Cp210x },    // CP2102 / CP2104 / CP2109
+            { 0x10C4, 0xEA70, AdapterKind::Cp210x },    // CP2105
+            { 0x10C4, 0xEA71, AdapterKind::Cp210x },    // CP2108
+        };
+
+        const KindProfile& ProfileOf(AdapterKind kind)
+        {
+            for (const KindProfile& profile : KIND_PROFILES)
+            {
+                if (profile.kind == kind) return profile;
+            }
+            return KIND_PROFILES[0];
+        }
+    } // anonymous namespace
+
+    const char* AdapterKindName(AdapterKind kind)
+    {
+        return ProfileOf(kind).name;
+    }
+
+    AdapterInfo AdapterOfKind(AdapterKind kind)
+    {
+        AdapterInfo info;
+        info.kind = kind;
+        info.vendorId = 0;
+        info.productId = 0;
+        info.latencyMs = ProfileOf(kind).latencyMs;
+        info.tuned = false;
+        return info;
+    }
+
+    AdapterInfo AdapterFromUsbId(uint16_t vendorId, uint16_t productId)
+    {
+        AdapterKind kind = AdapterKind::UsbOther;
+        for (const UsbId& id : USB_IDS)
+        {
+            if (id.vendorId == vendorId && (id.productId == 0 || id.productId == productId))
+            {
+                kind = id.kind;
+                break;
+            }
+        }
+
+        AdapterInfo info = AdapterOfKind(kind);
+        info.vendorId = vendorId;
+        info.productId = productId;
+        return info;
+    }
+
+    std::string AdapterInfo::Describe() const
+    {
+        char line[128];
+        if (vendorId != 0)
+        {
+            snprintf(line, sizeof(line), "%s %04x:%04x, RX latency %d ms%s",
+                AdapterKindName(kind), vendorId, productId, latencyMs, tuned ? " (tuned)" : "");
+        }
+        else
+        {
+            snprintf(line, sizeof(line), "%s, RX latency %d ms%s",
+                AdapterKindName(kind), latencyMs, tuned ? " (tuned)" : "");
+        }
+
+        std::string text = line;
+        if (!driver.empty()) text += " [" + driver + "]";
+        if (!hint.empty()) text += "; " + hint;
+        return text;
+    }
+
+} // namespace FuelMaster
@@ -0,0 +1,60 @@
+// ============================================================
+// AdapterProfile.h — What sits between the UART and the driver
+// ============================================================
+// A reply is only as fast as the adapter hands received bytes to
+// the driver. USB-UART chips buffer RX and flush on a timer
+// (FTDI: latency timer, 16 ms by default); a native UART or a
+// pty delivers at once. Serial backends identify the adapter at
+// Open by USB VID/PID (sysfs on Linux, SetupAPI on Windows),
+// tune it where the driver allows (FTDI latency timer,
+// ASYNC_LOW_LATENCY) and report the latency that is left, which
+// DispenserController adds to the reply budget.
+// ============================================================
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace FuelMaster {
+
+    enum class AdapterKind : int
+    {
+        Unknown = 0,    // not identified: USB-dongle timings
+        Native = 1,     // on-board / PCI UART
+        Ftdi = 2,       // FT232R, FT232H, FT2232, ...
+        Ch340 = 3,      // WCH CH340 / CH341 / CH9102
+        Pl2303 = 4,     // Prolific PL2303
+        Cp210x = 5,     // Silicon Labs CP210x
+        CdcAcm = 6,     // USB CDC-ACM (ttyACM, usbser.sys)
+        UsbOther = 7,   // USB, VID not in the table
+        Network = 8,    // Ethernet serial server
+        Virtual = 9     // pty, no hardware
+    };
+
+    struct AdapterInfo
+    {
+        AdapterKind kind;
+        uint16_t vendorId;          // USB VID/PID (0 when not USB)
+        uint16_t productId;
+        std::string driver;         // driver or device name, as the OS reports it
+        int latencyMs;              // worst-case wire-to-driver delay of received bytes
+        bool tuned;                 // latency lowered by the backend at Open
+        std::string hint;           // how to lower it when the backend could not
+
+        /// One line: kind, VID:PID, driver, latency
+        std::string Describe() const;
+    };
+
+    /// Short name of a kind ("FTDI", "native", ...)
+    const char* AdapterKindName(AdapterKind kind);
+
+    /// Default profile of a kind (latency with the driver's factory settings)
+    AdapterInfo AdapterOfKind(AdapterKind kind);
+
+    /// Profile for a USB VID/PID (UsbOther if the VID is not known)
+    AdapterInfo AdapterFromUsbId(uint16_t vendorId, uint16_t productId);
+
+    /// FTDI latency timer the backends program (ms, 1 is the minimum)
+    constexpr int FTDI_LOW_LATENCY_MS = 1;
+
+} // namespace FuelMaster
@@ -20,9 +20,11 @@ namespace Config {
     /// Response first byte timeout from dispenser
     constexpr int RESPONSE_TIMEOUT_MS = 80;
 
-    /// Inter-byte timeout (end of frame)
-    /// Increased from 3 to 20ms for USB-UART adapters
-    constexpr int INTER_BYTE_TIMEOUT_MS = 20;
+    /// Inter-byte timeout: silence allowed inside a reply once it
+    /// has started. Was raised from 3 to 20ms for USB-UART adapters;
+    /// their RX latency is now added per port (AdapterProfile.h),
+    /// so a native UART keeps the line-level 3ms
+    constexpr int INTER_BYTE_TIMEOUT_MS = 3;
 
     /// Delay between LM and RS commands in transaction
     /// Reduced to 10ms for fast update
@@ -0,0 +1,301 @@
+// ============================================================
+// DeviceWatcher.cpp — Serial adapter arrival notifications
+// ============================================================
+
+#include "pch.h"
+#include "DeviceWatcher.h"
+#include <chrono>
+
+#if defined(_WIN32)
+#include <initguid.h>
+#include <ntddser.h>        // GUID_DEVINTERFACE_COMPORT
+#pragma comment(lib, "cfgmgr32.lib")
+#elif defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace FuelMaster {
+
+#if defined(_WIN32)
+
+    DeviceWatcher::DeviceWatcher()
+        : m_arrived(false)
+        , m_interrupted(false)
+        , m_notification(nullptr)
+    {
+    }
+
+    DeviceWatcher::~DeviceWatcher()
+    {
+        Stop();
+    }
+
+    bool DeviceWatcher::Start()
+    {
+        if (m_notification) return true;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_arrived = false;
+        }
+
+        // Every COM port interface: USB CDC-ACM (usbser), FTDI, CP210x...
+        CM_NOTIFY_FILTER filter = {};
+        filter.cbSize = sizeof(filter);
+        filter.FilterType = CM_NOTIFY_FILTER_TYPE_DEVICEINTERFACE;
+        filter.u.DeviceInterface.ClassGuid = GUID_DEVINTERFACE_COMPORT;
+
+        CONFIGRET result = CM_Register_Notification(&filter, this, &DeviceWatcher::OnNotification,
+            &m_notification);
+        if (result != CR_SUCCESS)
+        {
+            m_notification = nullptr;
+            m_lastError = "CM_Register_Notification failed (" + std::to_string(result) + ")";
+            return false;
+        }
+        m_lastError = "";
+        return true;
+    }
+
+    void DeviceWatcher::Stop()
+    {
+        if (m_notification)
+        {
+            // Waits for a callback in progress
+            CM_Unregister_Notification(m_notification);
+            m_notification = nullptr;
+        }
+    }
+
+    bool DeviceWatcher::IsWatching() const
+    {
+        return m_notification != nullptr;
+    }
+
+    DWORD CALLBACK DeviceWatcher::OnNotification(HCMNOTIFICATION notification, PVOID context,
+        CM_NOTIFY_ACTION action, PCM_NOTIFY_EVENT_DATA eventData, DWORD eventDataSize)
+    {
+        (void)notification;
+        (void)eventData;
+        (void)eventDataSize;
+
+        if (action == CM_NOTIFY_ACTION_DEVICEINTERFACEARRIVAL)
+        {
+            auto* self = static_cast<DeviceWatcher*>(context);
+            std::lock_guard<std::mutex> lock(self->m_mutex);
+            self->m_arrived = true;
+            self->m_signal.notify_all();
+        }
+        return ERROR_SUCCESS;
+    }
+
+    DeviceEvent DeviceWatcher::Wait(int timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_signal.wait_for(lock, std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 0),
+            [this] { return m_arrived || m_interrupted; });
+
+        if (m_interrupted)
+        {
+            m_interrupted = false;
+            return DeviceEvent::Interrupted;
+        }
+        if (m_arrived)
+        {
+            m_arrived = false;
+            return DeviceEvent::Arrived;
+        }
+        return DeviceEvent::Timeout;
+    }
+
+    void DeviceWatcher::Interrupt()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interrupted = true;
+        m_signal.notify_all();
+    }
+
+#elif defined(__linux__)
+
+    DeviceWatcher::DeviceWatcher()
+        : m_arrived(false)
+        , m_interrupted(false)
+        , m_socket(-1)
+        , m_wakeFd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+    {
+    }
+
+    DeviceWatcher::~DeviceWatcher()
+    {
+        Stop();
+        if (m_wakeFd >= 0)
+            ::close(m_wakeFd);
+    }
+
+    bool DeviceWatcher::Start()
+    {
+        if (m_socket >= 0) return true;
+        m_arrived = false;
+
+        int fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+        if (fd < 0)
+        {
+            m_lastError = std::string("uevent socket failed (") + std::strerror(errno) + ")";
+            return false;
+        }
+
+        // Group 1: uevents as sent by the kernel (no udevd needed)
+        sockaddr_nl addr = {};
+        addr.nl_family = AF_NETLINK;
+        addr.nl_groups = 1;
+        if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        {
+            m_lastError = std::string("uevent bind failed (") + std::strerror(errno) + ")";
+            ::close(fd);
+            return false;
+        }
+
+        m_socket = fd;
+        m_lastError = "";
+        return true;
+    }
+
+    void DeviceWatcher::Stop()
+    {
+        if (m_socket >= 0)
+        {
+            ::close(m_socket);
+            m_socket = -1;
+        }
+    }
+
+    bool DeviceWatcher::IsWatching() const
+    {
+        return m_socket >= 0;
+    }
+
+    bool DeviceWatcher::ReadUevents()
+    {
+        // "add@/devices/...\0ACTION=add\0SUBSYSTEM=tty\0DEVNAME=ttyUSB0\0..."
+        bool ttyAdded = false;
+        char msg[4096];
+        while (true)
+        {
+            sockaddr_nl from = {};
+            socklen_t fromLen = sizeof(from);
+            ssize_t n = recvfrom(m_socket, msg, sizeof(msg) - 1, 0,
+                reinterpret_cast<sockaddr*>(&from), &fromLen);
+            if (n < 0)
+            {
+                if (errno == EINTR) continue;
+                break;  // EAGAIN: all read (ENOBUFS: overrun, a retry follows anyway)
+            }
+            if (from.nl_pid != 0) continue;     // only the kernel sends on group 1
+            msg[n] = '\0';
+
+            bool add = false;
+            bool tty = false;
+            for (ssize_t i = 0; i < n; i += static_cast<ssize_t>(std::strlen(msg + i)) + 1)
+            {
+                const char* field = msg + i;
+                if (std::strcmp(field, "ACTION=add") == 0) add = true;
+                else if (std::strcmp(field, "SUBSYSTEM=tty") == 0) tty = true;
+            }
+            ttyAdded = ttyAdded || (add && tty);
+        }
+        return ttyAdded;
+    }
+
+    DeviceEvent DeviceWatcher::Wait(int timeoutMs)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_interrupted)
+                {
+                    m_interrupted = false;
+                    return DeviceEvent::Interrupted;
+                }
+                if (m_arrived)
+                {
+                    m_arrived = false;
+                    return DeviceEvent::Arrived;
+                }
+            }
+
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0) return DeviceEvent::Timeout;
+
+            pollfd fds[2] = { { m_wakeFd, POLLIN, 0 }, { m_socket, POLLIN, 0 } };
+            const nfds_t count = m_socket >= 0 ? 2 : 1;
+            if (poll(fds, count, static_cast<int>(remaining)) < 0 && errno != EINTR)
+                return DeviceEvent::Timeout;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (fds[0].revents & POLLIN)
+            {
+                uint64_t value;
+                if (::read(m_wakeFd, &value, sizeof(value)) == sizeof(value))
+                    m_interrupted = true;
+            }
+            if (count == 2 && (fds[1].revents & POLLIN) && ReadUevents())
+                m_arrived = true;
+        }
+    }
+
+    void DeviceWatcher::Interrupt()
+    {
+        const uint64_t one = 1;
+        if (m_wakeFd >= 0 && ::write(m_wakeFd, &one, sizeof(one)) < 0)
+        {
+            // eventfd counter saturated: a wake-up is pending anyway
+        }
+    }
+
+#else
+
+    DeviceWatcher::DeviceWatcher()
+        : m_arrived(false)
+        , m_interrupted(false)
+    {
+    }
+
+    DeviceWatcher::~DeviceWatcher() = default;
+
+    bool DeviceWatcher::Start()
+    {
+        m_lastError = "Device notifications not supported on this platform";
+        return false;
+    }
+
+    void DeviceWatcher::Stop() {}
+    bool DeviceWatcher::IsWatching() const { return false; }
+
+    DeviceEvent DeviceWatcher::Wait(int timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_signal.wait_for(lock, std::chrono::milliseconds(timeoutMs > 0 ? timeoutMs : 0),
+            [this] { return m_interrupted; });
+        if (!m_interrupted) return DeviceEvent::Timeout;
+        m_interrupted = false;
+        return DeviceEvent::Interrupted;
+    }
+
+    void DeviceWatcher::Interrupt()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interrupted = true;
+        m_signal.notify_all();
+    }
+
+#endif
+
+} // namespace FuelMaster
@@ -0,0 +1,83 @@
+// ============================================================
+// DeviceWatcher.h — Serial adapter arrival notifications
+// ============================================================
+// Used by Transport while its device is lost (USB-UART pulled
+// or reset): the reopen is tried the moment the system reports
+// a new serial device instead of only on a timer.
+//   Windows — CM_Register_Notification, GUID_DEVINTERFACE_COMPORT
+//   Linux   — kernel uevents (NETLINK_KOBJECT_UEVENT), tty subsystem
+// Any serial device arriving counts: re-enumeration may give
+// the adapter another node, and a failed open attempt is cheap.
+// Without notifications (Start failed, other platforms) Wait
+// only sleeps and the caller retries on its timer.
+// ============================================================
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <cfgmgr32.h>
+#endif
+
+namespace FuelMaster {
+
+    enum class DeviceEvent
+    {
+        Timeout,        // nothing reported within the wait
+        Arrived,        // a serial device appeared
+        Interrupted     // Interrupt() called (shutdown)
+    };
+
+    class DeviceWatcher
+    {
+    public:
+        DeviceWatcher();
+        ~DeviceWatcher();
+
+        DeviceWatcher(const DeviceWatcher&) = delete;
+        DeviceWatcher& operator=(const DeviceWatcher&) = delete;
+
+        /// Subscribe to device arrivals. False when the platform refuses
+        /// (Wait then only sleeps); GetLastError tells why.
+        bool Start();
+        void Stop();
+        bool IsWatching() const;
+
+        /// Sleep until a serial device arrives, Interrupt() or timeoutMs.
+        /// Arrivals reported while not waiting are kept for the next call.
+        DeviceEvent Wait(int timeoutMs);
+
+        /// Wake a Wait in progress (or make the next one return at once).
+        /// Callable from any thread.
+        void Interrupt();
+
+        std::string GetLastError() const { return m_lastError; }
+
+    private:
+        std::string m_lastError;
+
+        std::mutex m_mutex;
+        std::condition_variable m_signal;
+        bool m_arrived;
+        bool m_interrupted;
+
+#if defined(_WIN32)
+        HCMNOTIFICATION m_notification;
+
+        /// CM notification callback (thread pool thread)
+        static DWORD CALLBACK OnNotification(HCMNOTIFICATION notification, PVOID context,
+            CM_NOTIFY_ACTION action, PCM_NOTIFY_EVENT_DATA eventData, DWORD eventDataSize);
+#elif defined(__linux__)
+        int m_socket;               // uevent netlink socket, -1 when not watching
+        int m_wakeFd;               // eventfd written by Interrupt
+
+        /// Read all pending uevents; true if one was a tty "add"
+        bool ReadUevents();
+#endif
+    };
+
+} // namespace FuelMaster
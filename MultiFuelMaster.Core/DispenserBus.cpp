@@ -0,0 +1,241 @@
+// ============================================================
+// DispenserBus.cpp — Shared RS-485 line scheduler
+// ============================================================
+
+#include "pch.h"
+#include "DispenserBus.h"
+#include "DispenserController.h"
+#include "Logger.h"
+#include <algorithm>
+
+namespace FuelMaster {
+
+    DispenserBus::DispenserBus()
+        : m_weights(BusWeights::Default())
+        , m_running(false)
+        , m_cycles(0)
+    {
+    }
+
+    DispenserBus::~DispenserBus()
+    {
+        Close();
+    }
+
+    // ============================================================
+    // LINE
+    // ============================================================
+
+    bool DispenserBus::Open(const std::string& portName, const SerialSettings& settings)
+    {
+        return Open(Transport::Create(portName), portName, settings);
+    }
+
+    bool DispenserBus::Open(std::unique_ptr<Transport> transport, const std::string& portName,
+        const SerialSettings& settings)
+    {
+        if (m_running.load())
+        {
+            FM_LOG_WARNING("DispenserBus::Open() called while open, returning false");
+            return false;
+        }
+
+        if (!transport)
+        {
+            m_lastError = "No transport for this platform";
+            return false;
+        }
+
+        if (!transport->IsOpen() && !transport->Open(portName, settings))
+        {
+            m_lastError = transport->GetLastError();
+            FM_LOG_ERROR("DispenserBus::Open() FAILED: %s", m_lastError.c_str());
+            return false;
+        }
+
+        if (!(transport->GetSettings() == settings) && !transport->Configure(settings))
+        {
+            m_lastError = transport->GetLastError();
+            FM_LOG_ERROR("DispenserBus::Open() Configure FAILED: %s", m_lastError.c_str());
+            return false;
+        }
+
+        m_transport = std::move(transport);
+        m_lastError = "";
+        m_running.store(true);
+        m_thread = std::thread(&DispenserBus::SchedulerLoop, this);
+
+        FM_LOG_INFO("DispenserBus: %s open at %d baud, adapter: %s", portName.c_str(), settings.baudRate,
+            m_transport->GetAdapter().Describe().c_str());
+        return true;
+    }
+
+    void DispenserBus::Close()
+    {
+        if (!m_running.load())
+            return;
+
+        m_running.store(false);
+        Wake();
+        if (m_transport) m_transport->InterruptAwaitDevice();
+
+        if (m_thread.joinable())
+            m_thread.join();
+
+        // Controllers still attached keep no pointer to this bus: their
+        // Disconnect() and queued commands must not reach it once destroyed
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const Member& m : m_members)
+                m.controller->OnBusClosed(this);
+            m_members.clear();
+        }
+
+        if (m_transport) m_transport->Close();
+        FM_LOG_INFO("DispenserBus: closed");
+    }
+
+    bool DispenserBus::IsOpen() const
+    {
+        return m_running.load() && m_transport && m_transport->IsOpen();
+    }
+
+    void DispenserBus::SetEchoCancellation(bool enabled)
+    {
+        if (m_transport) m_transport->SetEchoCancellation(enabled);
+    }
+
+    BusWeights DispenserBus::GetWeights() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_weights;
+    }
+
+    void DispenserBus::SetWeights(const BusWeights& weights)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_weights = weights;
+    }
+
+    size_t DispenserBus::GetMemberCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_members.size();
+    }
+
+    // ============================================================
+    // MEMBERSHIP
+    // ============================================================
+
+    bool DispenserBus::Attach(DispenserController* controller, uint8_t address)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running.load() || !m_transport)
+            return false;
+
+        for (const Member& m : m_members)
+        {
+            if (m.controller == controller || m.address == address)
+                return false;
+        }
+
+        // Join at the current minimum pass: no catch-up burst, no starvation
+        uint64_t pass = 0;
+        if (!m_members.empty())
+        {
+            pass = std::min_element(m_members.begin(), m_members.end(),
+                [](const Member& a, const Member& b) { return a.pass < b.pass; })->pass;
+        }
+
+        m_members.push_back({ controller, address, Clock::now(), pass });
+        Wake();
+        return true;
+    }
+
+    void DispenserBus::Detach(DispenserController* controller)
+    {
+        // The scheduler holds m_mutex for the whole poll cycle
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_members.erase(std::remove_if(m_members.begin(), m_members.end(),
+            [controller](const Member& m) { return m.controller == controller; }),
+            m_members.end());
+    }
+
+    void DispenserBus::Wake()
+    {
+        m_wake.Wake();
+    }
+
+    // ============================================================
+    // SCHEDULER
+    // ============================================================
+
+    int DispenserBus::WeightOf(const Member& member) const
+    {
+        int weight;
+        switch (DispenserController::PhaseOf(member.controller->GetCurrentState()))
+        {
+        case PollPhase::Active:
+            weight = m_weights.active;
+            break;
+        case PollPhase::Busy:
+            weight = m_weights.busy;
+            break;
+        default:
+            weight = m_weights.idle;
+            break;
+        }
+        return weight > 0 ? weight : 1;
+    }
+
+    void DispenserBus::SchedulerLoop()
+    {
+        while (m_running.load())
+        {
+            if (m_transport->IsDeviceLost())
+            {
+                // Adapter gone: no post can be polled until it is back
+                FM_LOG_WARNING("DispenserBus: device lost (%s)", m_transport->GetLastError().c_str());
+                while (m_running.load() && !m_transport->AwaitDevice(REOPEN_RETRY_MS)) {}
+                if (m_running.load())
+                    FM_LOG_INFO("DispenserBus: %s reopened", m_transport->GetPortName().c_str());
+                continue;
+            }
+
+            Clock::time_point earliest = (Clock::time_point::max)();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                const Clock::time_point now = Clock::now();
+                Member* next = nullptr;
+                for (Member& m : m_members)
+                {
+                    if (m.due <= now || m.controller->HasPendingCommands())
+                    {
+                        if (!next || m.pass < next->pass)
+                            next = &m;
+                    }
+                    else
+                    {
+                        earliest = (std::min)(earliest, m.due);
+                    }
+                }
+
+                if (next)
+                {
+                    // One poll cycle on the line, under the lock (Detach waits for it)
+                    next->due = next->controller->PollOnce();
+                    next->pass += STRIDE / static_cast<uint64_t>(WeightOf(*next));
+                    m_cycles.fetch_add(1);
+                    continue;
+                }
+            }
+
+            // Nothing due: sleep until the earliest post is, or a command
+            // is queued / the membership changes / the bus closes.
+            // Deadlines are kept to the sub-millisecond (no system tick rounding).
+            m_wake.SleepUntil(earliest);
+        }
+    }
+
+} // namespace FuelMaster
@@ -0,0 +1,141 @@
+// ============================================================
+// DispenserBus.h — Shared RS-485 line, many dispensers
+// ============================================================
+// One port, one scheduler thread, up to 32 addresses. Each
+// DispenserController attached with Connect(bus, address)
+// keeps its own FSM, decoders and statistics; the bus decides
+// whose poll cycle (DispenserController::PollOnce) runs next.
+//
+// Scheduling: a post is eligible once the deadline of its next
+// cycle has passed (its target period by state, PollCadence.h)
+// or it has queued commands. Among eligible
+// posts the one with the lowest stride "pass" runs; each cycle
+// advances the pass by STRIDE / weight, the weight following
+// the post's FSM state. Fuelling posts therefore get most of
+// the line when several compete, idle posts are never starved.
+//
+// A lost adapter (USB-UART pulled / reset) halts the scheduler
+// until Transport::AwaitDevice has reopened the line.
+// ============================================================
+#pragma once
+
+#include "PreciseWait.h"
+#include "Transport.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace FuelMaster {
+
+    class DispenserController;
+
+    // ============================================================
+    // Bus time weights by dispenser state
+    // ============================================================
+    struct BusWeights
+    {
+        int active;     // Fuelling / SuspendedFuelling / Stopped
+        int busy;       // Calling / Authorized / Started / SuspendedStarted / EndOfTransaction
+        int idle;       // Idle / Error / no response
+
+        static BusWeights Default()
+        {
+            return BusWeights{
+                8,      // active - LM/RS updates while fuel flows
+                3,      // busy - nozzle up / preset / end of transaction
+                1       // idle - SR every idlePollDelayMs is enough
+            };
+        }
+    };
+
+    class DispenserBus
+    {
+    public:
+        DispenserBus();
+        ~DispenserBus();
+
+        DispenserBus(const DispenserBus&) = delete;
+        DispenserBus& operator=(const DispenserBus&) = delete;
+
+        /// Open the line and start the scheduler
+        bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default());
+
+        /// Same, over a caller-supplied transport (e.g. PtyTransport in tests)
+        bool Open(std::unique_ptr<Transport> transport, const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default());
+
+        /// Stop the scheduler and close the line. Attached controllers
+        /// are detached (the bus may be destroyed after this) and see
+        /// a closed transport until they Disconnect.
+        void Close();
+        bool IsOpen() const;
+
+        void SetEchoCancellation(bool enabled);
+
+        BusWeights GetWeights() const;
+        void SetWeights(const BusWeights& weights);
+
+        size_t GetMemberCount() const;
+        uint64_t GetCycles() const { return m_cycles.load(); }
+        std::string GetLastError() const { return m_lastError; }
+
+    private:
+        friend class DispenserController;
+
+        // --- Called by DispenserController::Connect / Disconnect ---
+
+        /// The shared line (nullptr until Open)
+        std::shared_ptr<Transport> GetTransport() const { return m_transport; }
+
+        /// Register a controller (false if the bus is closed or the
+        /// address is already taken)
+        bool Attach(DispenserController* controller, uint8_t address);
+
+        /// Unregister; waits for a poll cycle of this controller in progress
+        void Detach(DispenserController* controller);
+
+        /// A controller queued a command: re-evaluate without waiting
+        void Wake();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr uint64_t STRIDE = 1u << 20;
+
+        // Reopen attempt interval while the line's adapter is gone
+        static constexpr int REOPEN_RETRY_MS = 1000;
+
+        struct Member
+        {
+            DispenserController* controller;
+            uint8_t address;
+            Clock::time_point due;      // deadline of the next cycle (PollOnce)
+            uint64_t pass;              // stride scheduling position
+        };
+
+        std::shared_ptr<Transport> m_transport;
+        std::string m_lastError;
+
+        std::vector<Member> m_members;
+        mutable std::mutex m_mutex;     // members, weights; held during a poll cycle
+
+        // Separate from m_mutex so Wake() never waits for a poll cycle
+        WakeableSleep m_wake;
+
+        BusWeights m_weights;
+        std::thread m_thread;
+        std::atomic<bool> m_running;
+        std::atomic<uint64_t> m_cycles;
+
+        void SchedulerLoop();
+
+        /// Weight of a member from its controller's current state
+        int WeightOf(const Member& member) const;
+    };
+
+} // namespace FuelMaster
@@ -6,10 +6,11 @@
 #include "DispenserController.h"
 #include "Logger.h"
 #include "DispenserFSM.h"
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
-#include <windows.h>
+#include "Platform.h"
 
 namespace FuelMaster {
 
@@ -26,12 +27,24 @@ namespace FuelMaster {
         lo = static_cast<uint8_t>(a);
     }
 
+    const Protocol::Frame& DispenserController::FixedFrame(Protocol::FixedCommand cmd) const
+    {
+        return Protocol::GetFixedFrame(m_slaveAddr.load(), cmd);
+    }
+
     // ============================================================
     // CONSTRUCTOR / DESTRUCTOR
     // ============================================================
 
     DispenserController::DispenserController()
-        : m_protocol(0x00, 0x01),
+        : m_protocol(std::in_place_type<Protocol::GasKitProtocol>, 0x00, 0x01),
+        m_maxFrameSize(Protocol::MAX_FRAME_SIZE),
+        m_slaveAddr(0x01),
+        m_bus(nullptr),
+        m_ownsTransport(false),
+        m_echoCancel(false),
+        m_passive(false),
+        m_sessionPassive(false),
         m_fsm(),
         m_currentLiters(0.0),
         m_currentMoney(0.0),
@@ -40,7 +53,23 @@ namespace FuelMaster {
         m_isRunning(false),
         m_noResponseCount(0),
         m_crcErrorCount(0),
-        m_timingParams(TimingParams::Default())
+        m_retriesAvoided(0),
+        m_lateFrames(0),
+        m_exchanges(0),
+        m_failedAttempts(0),
+        m_recoveries(0),
+        m_recoveryUs(0),
+        m_maxRecoveryUs(0),
+        m_linkStatsSinceNs(0),
+        m_recoveryStart(),
+        m_holdOffMs(0),
+        m_cycleDue(),
+        m_lastCycleStart(),
+        m_lastPhase(PollPhase::Idle),
+        m_cadence{},
+        m_currentPhase(PollPhase::Idle),
+        m_timingParams(TimingParams::Default()),
+        m_serialSettings(SerialSettings::Default())
     {
     }
 
@@ -53,21 +82,37 @@ namespace FuelMaster {
     // CONNECTION
     // ============================================================
 
-    bool DispenserController::Connect(const std::string& portName, const std::string& slaveAddress)
+    bool DispenserController::Connect(const std::string& portName, const std::string& slaveAddress,
+                                      Protocol::Dialect dialect)
+    {
+        return Connect(Transport::Create(portName), portName, slaveAddress, dialect);
+    }
+
+    namespace
     {
         // Explicit Logger initialization before any FM_LOG calls.
         // AutoInitialize from variadic FM_LOG_INFO in C++/CLI context
         // can cause SEHException, so initialize here.
-        try
+        void EnsureLogger()
         {
-            if (!Logger::Instance().IsInitialized())
+            try
             {
-                Logger::Instance().AutoInitialize();
+                if (!Logger::Instance().IsInitialized())
+                {
+                    Logger::Instance().AutoInitialize();
+                }
             }
+            catch (...) { /* Logger init failed - continue without logs */ }
         }
-        catch (...) { /* Logger init failed - continue without logs */ }
+    } // anonymous namespace
 
-        FM_LOG_INFO("Connect() START: port=%s addr=%s", portName.c_str(), slaveAddress.c_str());
+    bool DispenserController::Connect(std::unique_ptr<Transport> transport, const std::string& portName,
+                                      const std::string& slaveAddress, Protocol::Dialect dialect)
+    {
+        EnsureLogger();
+
+        FM_LOG_INFO("Connect() START: port=%s addr=%s dialect=%d", portName.c_str(),
+            slaveAddress.c_str(), static_cast<int>(dialect));
 
         // Prevent re-call
         if (m_isRunning.load())
@@ -76,26 +121,148 @@ namespace FuelMaster {
             return false;
         }
 
-        uint8_t hi, lo;
-        ParseAddress(slaveAddress, hi, lo);
+        // Passive or not for the whole session: SetPassiveMode from now on
+        // only affects the next Connect
+        m_sessionPassive.store(m_passive.load());
+
+        SelectDialect(slaveAddress, dialect);
+
+        if (!transport)
         {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            m_protocol.SetAddress(hi, lo);
+            FM_LOG_ERROR("Connect() no transport for this platform");
+            NotifyError("Cannot open COM port: " + portName);
+            return false;
         }
+        m_transport = std::move(transport);
+        m_ownsTransport.store(true);
+        m_transport->SetEchoCancellation(m_echoCancel.load());
+        m_transport->SetReceiveOnly(m_sessionPassive.load());
 
-        if (!m_serialPort.Open(portName, 9600))
+        if (!m_transport->IsOpen() && !m_transport->Open(portName, m_serialSettings))
         {
-            FM_LOG_ERROR("Connect() Open FAILED: %s", m_serialPort.GetLastError().c_str());
+            FM_LOG_ERROR("Connect() Open FAILED: %s", m_transport->GetLastError().c_str());
             NotifyError("Cannot open COM port: " + portName);
             return false;
         }
 
-        if (!m_serialPort.IsOpen())
+        if (!m_transport->IsOpen())
         {
             FM_LOG_ERROR("Connect() Port opened but IsOpen() = false");
             return false;
         }
 
+        // Caller-supplied transport opened with other settings
+        if (!(m_transport->GetSettings() == m_serialSettings) &&
+            !m_transport->Configure(m_serialSettings))
+        {
+            FM_LOG_ERROR("Connect() Configure FAILED: %s", m_transport->GetLastError().c_str());
+            NotifyError("Cannot configure COM port: " + portName);
+            return false;
+        }
+
+        if (m_serialSettings.autoBaud && m_sessionPassive.load())
+        {
+            // Probing transmits SR requests
+            FM_LOG_WARNING("Connect() auto-baud skipped in passive mode, staying at %d",
+                m_serialSettings.baudRate);
+        }
+        else if (m_serialSettings.autoBaud && !ProbeBaudRate())
+        {
+            FM_LOG_WARNING("Connect() auto-baud: no clean replies, staying at %d",
+                m_serialSettings.baudRate);
+        }
+
+        FM_LOG_INFO("Connect() adapter: %s", m_transport->GetAdapter().Describe().c_str());
+
+        StartSession();
+        if (m_sessionPassive.load())
+            m_pollingThread = std::thread(&DispenserController::SniffLoop, this);
+        else
+            m_pollingThread = std::thread(&DispenserController::PollingLoop, this);
+
+        FM_LOG_INFO("Connect() SUCCESS: port=%s open, %s started", portName.c_str(),
+            m_sessionPassive.load() ? "passive monitoring" : "polling");
+        Log("Connected to " + portName + " addr=" + slaveAddress +
+            " " + std::to_string(m_transport->GetSettings().baudRate) + " baud" +
+            (dialect == Protocol::Dialect::Wide ? " (wide fields)" : "") +
+            (m_sessionPassive.load() ? " (passive)" : ""), true);
+        Log("Adapter: " + m_transport->GetAdapter().Describe(), true);
+        return true;
+    }
+
+    bool DispenserController::Connect(DispenserBus& bus, const std::string& slaveAddress,
+                                      Protocol::Dialect dialect)
+    {
+        EnsureLogger();
+
+        FM_LOG_INFO("Connect() START: shared bus addr=%s dialect=%d",
+            slaveAddress.c_str(), static_cast<int>(dialect));
+
+        if (m_isRunning.load())
+        {
+            FM_LOG_WARNING("Connect() called while already running, returning false");
+            return false;
+        }
+
+        m_sessionPassive.store(m_passive.load());
+        if (m_sessionPassive.load())
+        {
+            // The bus scheduler is the line's master
+            FM_LOG_ERROR("Connect() passive mode is not available on a shared bus");
+            NotifyError("Cannot join bus in passive mode: addr=" + slaveAddress);
+            return false;
+        }
+
+        SelectDialect(slaveAddress, dialect);
+
+        // Line and session state first: the scheduler may poll right after Attach.
+        // The bus owns its transport: we never close it
+        m_ownsTransport.store(false);
+        m_transport = bus.GetTransport();
+        StartSession();
+        if (!m_transport || !bus.Attach(this, m_slaveAddr.load()))
+        {
+            m_isRunning.store(false);
+            m_transport.reset();
+            FM_LOG_ERROR("Connect() bus closed or address %s already on it", slaveAddress.c_str());
+            NotifyError("Cannot join bus: addr=" + slaveAddress);
+            return false;
+        }
+        m_bus.store(&bus);
+
+        FM_LOG_INFO("Connect() SUCCESS: addr=%s on shared bus", slaveAddress.c_str());
+        Log("Connected to bus addr=" + slaveAddress +
+            (dialect == Protocol::Dialect::Wide ? " (wide fields)" : ""), true);
+        return true;
+    }
+
+    void DispenserController::SelectDialect(const std::string& slaveAddress, Protocol::Dialect dialect)
+    {
+        uint8_t hi, lo;
+        ParseAddress(slaveAddress, hi, lo);
+        {
+            // Polling thread is not running: the decoder can be switched too
+            std::lock_guard<std::mutex> lock(m_protocolMutex);
+            if (dialect == Protocol::Dialect::Wide)
+            {
+                m_protocol.emplace<Protocol::GasKitWideProtocol>(hi, lo);
+                m_decoder.SetDialect<Protocol::GasKitWideDialect>();
+                m_lateDecoder.SetDialect<Protocol::GasKitWideDialect>();
+                m_maxFrameSize = Protocol::DialectLayout<Protocol::GasKitWideDialect>::MaxFrameSize;
+            }
+            else
+            {
+                m_protocol.emplace<Protocol::GasKitProtocol>(hi, lo);
+                m_decoder.SetDialect<Protocol::GasKitStandardDialect>();
+                m_lateDecoder.SetDialect<Protocol::GasKitStandardDialect>();
+                m_maxFrameSize = Protocol::DialectLayout<Protocol::GasKitStandardDialect>::MaxFrameSize;
+            }
+        }
+        m_slaveAddr.store(lo);
+    }
+
+    void DispenserController::StartSession()
+    {
         // Initialize FSM
         m_fsm.Reset();
         m_fsm.SetTransitionCallback([this](Protocol::DispenserState from,
@@ -105,18 +272,20 @@ namespace FuelMaster {
                 DispenserFSM::StateToString(to).c_str());
         });
 
-        m_isRunning.store(true);
         m_noResponseCount.store(0);
         m_crcErrorCount.store(0);
         m_transactionDataReady.store(false);
         m_currentLiters.store(0.0);
         m_currentMoney.store(0.0);
-
-        m_pollingThread = std::thread(&DispenserController::PollingLoop, this);
-
-        FM_LOG_INFO("Connect() SUCCESS: port=%s open, polling started", portName.c_str());
-        Log("Connected to " + portName + " addr=" + slaveAddress, true);
-        return true;
+        m_holdOffMs = 0;
+        m_lateStatus.reset();
+        m_recoveryStart = {};
+        m_cycleDue = {};
+        m_lastCycleStart = {};
+        m_lastPhase = PollPhase::Idle;
+        ResetLinkStats();
+        ResetPollCadence();
+        m_isRunning.store(true);
     }
 
     void DispenserController::Disconnect()
@@ -126,83 +295,171 @@ namespace FuelMaster {
 
         m_isRunning.store(false);
 
-        if (m_pollingThread.joinable())
-            m_pollingThread.join();
+        if (DispenserBus* bus = m_bus.exchange(nullptr))
+        {
+            // Waits for a poll cycle of ours in progress; the line stays open
+            bus->Detach(this);
+        }
+        else if (m_ownsTransport.load())
+        {
+            // The polling thread may be waiting for a lost device
+            if (m_transport) m_transport->InterruptAwaitDevice();
+            if (m_pollingThread.joinable())
+                m_pollingThread.join();
 
-        // Give time for all port operations to complete
-        Sleep(10);
+            // Give time for all port operations to complete
+            SleepMs(10);
 
-        m_serialPort.Close();
+            if (m_transport) m_transport->Close();
+        }
         m_noResponseCount.store(0);
         m_crcErrorCount.store(0);
 
         Log("Disconnected", true);
     }
 
+    void DispenserController::OnBusClosed(DispenserBus* bus)
+    {
+        // m_transport stays (IsConnected may read it concurrently); not
+        // owning it, Disconnect leaves it alone
+        m_bus.compare_exchange_strong(bus, nullptr);
+    }
+
     bool DispenserController::IsConnected() const
     {
-        return m_serialPort.IsOpen();
+        // A bus member only while attached to it
+        if (!m_ownsTransport.load() && !m_bus.load()) return false;
+        return m_transport && m_transport->IsOpen();
     }
 
     // ============================================================
-    // COMMAND QUEUE (public)
+    // AUTO-BAUD
+    // A rate is kept only if every probe SR gets a CRC-valid,
+    // decodable S reply from our slave; at a wrong rate the
+    // dispenser sees garbage and stays silent (or we do).
     // ============================================================
 
-    void DispenserController::QueueStop()
+    bool DispenserController::ProbeBaudRate()
     {
-        std::vector<uint8_t> cmd;
-        {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            cmd = m_protocol.BuildStop();
-        }
+        const int probesPerRate = 3;
+        const Protocol::Frame& probe = FixedFrame(Protocol::FixedCommand::Status);
+        m_decoder.SetAddressFilter(probe[1], probe[2]);
+        m_decoder.SetExpectedCommand('S');
+
+        for (int rate : AUTO_BAUD_CANDIDATES)
         {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_commandQueue.push({ cmd, "STOP(B)" });
+            SerialSettings candidate = m_serialSettings;
+            candidate.baudRate = rate;
+            if (!m_transport->Configure(candidate))
+                continue;  // rate not supported by the adapter
+
+            const int timeoutMs = candidate.ScaleTimeoutMs(m_timingParams.responseTimeoutMs,
+                probe.size() + m_decoder.ResponseFrameLength('S'));
+
+            int clean = 0;
+            for (; clean < probesPerRate; clean++)
+            {
+                m_transport->SendAndReceive(probe, m_decoder, timeoutMs,
+                    m_timingParams.interByteTimeoutMs, true);
+                if (!m_decoder.HasFrame())
+                    break;
+
+                Protocol::Response decoded = std::visit([&](auto& protocol) {
+                    return protocol.DecodeValidatedFrame(m_decoder.GetFrame());
+                }, m_protocol);
+                if (!std::holds_alternative<Protocol::StatusResponse>(decoded))
+                    break;
+            }
+
+            FM_LOG_INFO("Auto-baud: %d baud, %d/%d clean SR replies", rate, clean, probesPerRate);
+            if (clean == probesPerRate)
+            {
+                m_decoder.SetExpectedCommand(0);
+                m_serialSettings.baudRate = rate;
+                return true;
+            }
         }
-        Log("Queued: Stop", true);
+
+        m_decoder.SetExpectedCommand(0);
+        m_transport->Configure(m_serialSettings);
+        return false;
+    }
+
+    // ============================================================
+    // COMMAND QUEUE (public)
+    // ============================================================
+
+    void DispenserController::QueueStop()
+    {
+        const Protocol::Frame& cmd = FixedFrame(Protocol::FixedCommand::Stop);
+        if (Enqueue(cmd, "STOP(B)"))
+            Log("Queued: Stop", true);
     }
 
     void DispenserController::QueueVolumePreset(double liters, int pricePerLiter)
     {
         int centiliters = static_cast<int>(liters * 100.0);
-        std::vector<uint8_t> cmd;
+        Protocol::Frame cmd;
         {
             std::lock_guard<std::mutex> lock(m_protocolMutex);
-            cmd = m_protocol.BuildVolumePreset(1, centiliters, pricePerLiter);
+            cmd = std::visit([&](auto& protocol) {
+                return protocol.BuildVolumePreset(1, centiliters, pricePerLiter);
+            }, m_protocol);
         }
+        if (cmd.empty())
         {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_commandQueue.push({ cmd, "VOLUME(V)" });
+            NotifyError("Volume preset: value out of range");
+            return;
         }
-        Log("Queued: Volume preset", true);
+        if (Enqueue(cmd, "VOLUME(V)"))
+            Log("Queued: Volume preset", true);
     }
 
     void DispenserController::QueueMoneyPreset(int money, int pricePerLiter)
     {
-        std::vector<uint8_t> cmd;
+        Protocol::Frame cmd;
         {
             std::lock_guard<std::mutex> lock(m_protocolMutex);
-            cmd = m_protocol.BuildMoneyPreset(1, money, pricePerLiter);
+            cmd = std::visit([&](auto& protocol) {
+                return protocol.BuildMoneyPreset(1, money, pricePerLiter);
+            }, m_protocol);
         }
+        if (cmd.empty())
         {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_commandQueue.push({ cmd, "MONEY(M)" });
+            NotifyError("Money preset: value out of range");
+            return;
         }
-        Log("Queued: Money preset", true);
+        if (Enqueue(cmd, "MONEY(M)"))
+            Log("Queued: Money preset", true);
     }
 
     void DispenserController::QueueEndTransaction()
     {
-        std::vector<uint8_t> cmd;
+        const Protocol::Frame& cmd = FixedFrame(Protocol::FixedCommand::EndTransaction);
+        if (Enqueue(cmd, "END-TXN(N)"))
+            Log("Queued: End transaction", true);
+    }
+
+    bool DispenserController::Enqueue(const Protocol::Frame& frame, const char* description)
+    {
+        if (m_sessionPassive.load())
         {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            cmd = m_protocol.BuildEndTransaction();
+            NotifyError(std::string("Passive mode: ") + description + " not sent");
+            return false;
         }
         {
             std::lock_guard<std::mutex> lock(m_queueMutex);
-            m_commandQueue.push({ cmd, "END-TXN(N)" });
+            m_commandQueue.push({ frame, description });
         }
-        Log("Queued: End transaction", true);
+        if (DispenserBus* bus = m_bus.load())
+            bus->Wake();
+        return true;
+    }
+
+    bool DispenserController::HasPendingCommands() const
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        return !m_commandQueue.empty();
     }
 
     // ============================================================
@@ -231,6 +488,81 @@ namespace FuelMaster {
         return m_noResponseCount.load(); // UI uses for "no connection"
     }
 
+    void DispenserController::SetEchoCancellation(bool enabled)
+    {
+        m_echoCancel.store(enabled);
+        if (m_transport) m_transport->SetEchoCancellation(enabled);
+        FM_LOG_INFO("Echo cancellation %s", enabled ? "enabled" : "disabled");
+    }
+
+    bool DispenserController::GetEchoCancellation() const { return m_echoCancel.load(); }
+
+    uint64_t DispenserController::GetEchoesRemoved() const
+    {
+        return m_transport ? m_transport->GetEchoesRemoved() : 0;
+    }
+
+    uint64_t DispenserController::GetRxWakeups() const
+    {
+        return m_transport ? m_transport->GetRxWakeups() : 0;
+    }
+
+    AdapterInfo DispenserController::GetAdapter() const
+    {
+        return m_transport ? m_transport->GetAdapter() : AdapterOfKind(AdapterKind::Unknown);
+    }
+
+    LinkStats DispenserController::GetLinkStats() const
+    {
+        const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        LinkStats stats;
+        stats.exchanges = m_exchanges.load();
+        stats.failedAttempts = m_failedAttempts.load();
+        stats.recoveries = m_recoveries.load();
+        stats.recoveryUs = m_recoveryUs.load();
+        stats.maxRecoveryUs = m_maxRecoveryUs.load();
+        stats.elapsedSec = static_cast<double>(nowNs - m_linkStatsSinceNs.load()) / 1e9;
+        return stats;
+    }
+
+    void DispenserController::ResetLinkStats()
+    {
+        // An episode in progress keeps running (polling thread owns it)
+        m_exchanges.store(0);
+        m_failedAttempts.store(0);
+        m_recoveries.store(0);
+        m_recoveryUs.store(0);
+        m_maxRecoveryUs.store(0);
+        m_linkStatsSinceNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    bool DispenserController::StartCapture(const std::string& path)
+    {
+        if (!m_transport || !m_transport->StartCapture(path))
+        {
+            FM_LOG_ERROR("Wire capture to %s FAILED (not connected or file error)", path.c_str());
+            return false;
+        }
+        FM_LOG_INFO("Wire capture started: %s", path.c_str());
+        return true;
+    }
+
+    void DispenserController::StopCapture()
+    {
+        if (!m_transport || !m_transport->IsCapturing()) return;
+        m_transport->StopCapture();
+        FM_LOG_INFO("Wire capture stopped (%llu records)",
+            static_cast<unsigned long long>(m_transport->GetCaptureRecords()));
+    }
+
+    bool DispenserController::IsCapturing() const
+    {
+        return m_transport && m_transport->IsCapturing();
+    }
+
     // ============================================================
     // COMMAND QUEUE EXECUTION
     // ============================================================
@@ -250,10 +582,10 @@ namespace FuelMaster {
             Log("EXEC: " + cmd.description, true);
             auto resp = SendWithRetry(cmd.frame, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
 
-            if (!resp.empty())
+            if (auto* s = std::get_if<Protocol::StatusResponse>(&resp))
             {
                 // Response to user command - process as status
-                ProcessStatusAndAct(resp);
+                ProcessStatusAndAct(*s);
             }
         }
     }
@@ -262,15 +594,8 @@ namespace FuelMaster {
     // PROCESS SR RESPONSE THROUGH FSM
     // ============================================================
 
-    void DispenserController::ProcessStatusAndAct(const std::vector<uint8_t>& response)
+    void DispenserController::ProcessStatusAndAct(const Protocol::StatusResponse& s)
     {
-        Protocol::StatusResponse s;
-        {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            s = m_protocol.ParseStatusResponse(response);
-        }
-        if (!s.valid) return;
-
         // Pass to FSM - it determines transition and returns action
         FSMAction action = m_fsm.ProcessHardwareStatus(
             static_cast<int>(s.state), s.nozzle);
@@ -313,49 +638,25 @@ namespace FuelMaster {
         if (!m_isRunning.load()) return;
 
         // LM - volume request
-        std::vector<uint8_t> lmCmd;
-        {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            lmCmd = m_protocol.BuildVolumeRequest();
-        }
+        const Protocol::Frame& lmCmd = FixedFrame(Protocol::FixedCommand::Volume);
         auto lmResp = SendWithRetry(lmCmd, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
-        if (!lmResp.empty())
+        if (auto* v = std::get_if<Protocol::VolumeResponse>(&lmResp))
         {
-            Protocol::VolumeResponse v;
-            {
-                std::lock_guard<std::mutex> lock(m_protocolMutex);
-                v = m_protocol.ParseVolumeResponse(lmResp);
-            }
-            if (v.valid)
-            {
-                double liters = v.volumeCentiliters / 100.0;
-                m_currentLiters.store(liters);
-                if (m_onFuelData) m_onFuelData(liters, m_currentMoney.load());
-            }
+            double liters = v->volumeCentiliters / 100.0;
+            m_currentLiters.store(liters);
+            if (m_onFuelData) m_onFuelData(liters, m_currentMoney.load());
         }
 
         if (!m_isRunning.load()) return;
 
         // RS - money request
-        std::vector<uint8_t> rsCmd;
-        {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            rsCmd = m_protocol.BuildMoneyRequest();
-        }
+        const Protocol::Frame& rsCmd = FixedFrame(Protocol::FixedCommand::Money);
         auto rsResp = SendWithRetry(rsCmd, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
-        if (!rsResp.empty())
+        if (auto* r = std::get_if<Protocol::MoneyResponse>(&rsResp))
         {
-            Protocol::MoneyResponse r;
-            {
-                std::lock_guard<std::mutex> lock(m_protocolMutex);
-                r = m_protocol.ParseMoneyResponse(rsResp);
-            }
-            if (r.valid)
-            {
-                double money = static_cast<double>(r.money);
-                m_currentMoney.store(money);
-                if (m_onFuelData) m_onFuelData(m_currentLiters.load(), money);
-            }
+            double money = static_cast<double>(r->money);
+            m_currentMoney.store(money);
+            if (m_onFuelData) m_onFuelData(m_currentLiters.load(), money);
         }
     }
 
@@ -363,38 +664,16 @@ namespace FuelMaster {
     {
         m_fsm.MarkTUSent();
 
-        std::vector<uint8_t> tuCmd;
-        {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            tuCmd = m_protocol.BuildTransactionRequest();
-        }
+        const Protocol::Frame& tuCmd = FixedFrame(Protocol::FixedCommand::Transaction);
         auto tuResp = SendWithRetry(tuCmd, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
-        if (!tuResp.empty())
+        if (auto* td = std::get_if<Protocol::TransactionResponse>(&tuResp))
         {
-            Protocol::TransactionResponse td;
-            {
-                std::lock_guard<std::mutex> lock(m_protocolMutex);
-                td = m_protocol.ParseTransactionResponse(tuResp);
-            }
-            if (td.valid)
-            {
-                double finalLiters = td.volumeCentiliters / 100.0;
-                double finalMoney = static_cast<double>(td.money);
-                m_currentMoney.store(finalMoney);
-                m_currentLiters.store(finalLiters);
-                m_transactionDataReady.store(true);
-
-                if (m_onTransactionComplete)
-                    m_onTransactionComplete(finalLiters, finalMoney, td.price);
-            }
-            else
-            {
-                FM_LOG_WARNING("TU response parse failed, will not retry (one-shot)");
-            }
+            ApplyTransaction(*td);
         }
         else
         {
-            FM_LOG_WARNING("TU no response, will not retry (one-shot)");
+            // A T that arrives later is still taken (HandleLateFrame)
+            FM_LOG_WARNING("TU no valid response, will not retry (one-shot)");
         }
     }
 
@@ -402,31 +681,15 @@ namespace FuelMaster {
     {
         m_fsm.MarkC0Sent();
 
-        std::vector<uint8_t> totalCmd;
-        {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            totalCmd = m_protocol.BuildTotalCounterRequest(0);
-        }
+        const Protocol::Frame& totalCmd = FixedFrame(Protocol::FixedCommand::TotalCounter0);
         auto totalResp = SendWithRetry(totalCmd, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
-        if (!totalResp.empty())
+        if (auto* t = std::get_if<Protocol::TotalCounterResponse>(&totalResp))
         {
-            Protocol::TotalCounterResponse t;
-            {
-                std::lock_guard<std::mutex> lock(m_protocolMutex);
-                t = m_protocol.ParseTotalCounterResponse(totalResp);
-            }
-            if (t.valid)
-            {
-                m_totalCounter.store(t.totalCentiliters / 100.0);
-            }
-            else
-            {
-                FM_LOG_WARNING("C0 response parse failed (one-shot)");
-            }
+            m_totalCounter.store(t->totalCentiliters / 100.0);
         }
         else
         {
-            FM_LOG_WARNING("C0 no response (one-shot)");
+            FM_LOG_WARNING("C0 no valid response (one-shot)");
         }
     }
 
@@ -434,41 +697,27 @@ namespace FuelMaster {
     {
         m_fsm.MarkNOSent();
 
-        std::vector<uint8_t> noCmd;
-        {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            noCmd = m_protocol.BuildEndTransaction();
-        }
+        const Protocol::Frame& noCmd = FixedFrame(Protocol::FixedCommand::EndTransaction);
         auto noResp = SendWithRetry(noCmd, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
-        if (!noResp.empty())
+        if (auto* st = std::get_if<Protocol::StatusResponse>(&noResp))
         {
-            ProcessStatusAndAct(noResp);
+            ProcessStatusAndAct(*st);
         }
 
-        Sleep(m_timingParams.postEndDelayMs);
+        // Post-NO pause before the next cycle (other posts on a shared
+        // bus keep being served meanwhile)
+        m_holdOffMs += m_timingParams.postEndDelayMs;
     }
 
     void DispenserController::DoIdleC0()
     {
         m_fsm.MarkIdleC0Sent();
 
-        std::vector<uint8_t> totalCmd;
-        {
-            std::lock_guard<std::mutex> lock(m_protocolMutex);
-            totalCmd = m_protocol.BuildTotalCounterRequest(0);
-        }
+        const Protocol::Frame& totalCmd = FixedFrame(Protocol::FixedCommand::TotalCounter0);
         auto totalResp = SendWithRetry(totalCmd, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
-        if (!totalResp.empty())
+        if (auto* t = std::get_if<Protocol::TotalCounterResponse>(&totalResp))
         {
-            Protocol::TotalCounterResponse t;
-            {
-                std::lock_guard<std::mutex> lock(m_protocolMutex);
-                t = m_protocol.ParseTotalCounterResponse(totalResp);
-            }
-            if (t.valid)
-            {
-                m_totalCounter.store(t.totalCentiliters / 100.0);
-            }
+            m_totalCounter.store(t->totalCentiliters / 100.0);
         }
     }
 
@@ -480,236 +729,613 @@ namespace FuelMaster {
     {
         while (m_isRunning.load())
         {
-            // 1) Execute user command queue
-            ExecutePendingCommands();
+            const std::chrono::steady_clock::time_point due = PollOnce();
+            if (m_transport->IsDeviceLost())
+            {
+                RecoverDevice();
+                continue;
+            }
+            SleepUntil(due);
+        }
+    }
 
-            if (!m_isRunning.load()) break;
+    void DispenserController::RecoverDevice()
+    {
+        const std::string portName = m_transport->GetPortName();
+        NotifyError("Device lost: " + portName + " (" + m_transport->GetLastError() + ")");
 
-            // 2) SR status request
-            std::vector<uint8_t> statusCmd;
+        while (m_isRunning.load())
+        {
+            if (m_transport->AwaitDevice(m_timingParams.reopenRetryMs))
             {
-                std::lock_guard<std::mutex> lock(m_protocolMutex);
-                statusCmd = m_protocol.BuildStatusRequest();
+                // Line settings, echo filter, capture and the queued commands
+                // survive the reopen; the FSM resyncs on the next SR
+                m_decoder.Reset();
+                m_lateDecoder.Reset();
+                m_noResponseCount.store(0);
+                m_lastCycleStart = {};  // the wait for the device is not a poll period
+
+                FM_LOG_INFO("Device back: %s reopened, adapter: %s", portName.c_str(),
+                    m_transport->GetAdapter().Describe().c_str());
+                Log("Device back: " + portName + " reopened", true);
+                return;
             }
+        }
+    }
 
-            auto statusResp = SendWithRetry(statusCmd, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
+    // ============================================================
+    // PASSIVE MONITORING — another master polls, we only listen
+    // The decoder knows response lengths only: a request of the
+    // other master (STX addr cmd CRC) fails the length/CRC check
+    // of the reply it resembles and the decoder resyncs on the
+    // next STX, which is the reply. One pass per byte, frames
+    // are decoded in place, so a saturated line is no burden.
+    // ============================================================
 
-            if (statusResp.empty())
-            {
-                // All attempts failed - connection lost
-                int noRespCnt = m_noResponseCount.load();
-                if (noRespCnt % 10 == 0 && noRespCnt > 0)
-                {
-                    Log("No response. NoRespCount=" + std::to_string(noRespCnt) +
-                        " CrcCount=" + std::to_string(m_crcErrorCount.load()), false);
-                }
+    void DispenserController::SniffLoop()
+    {
+        const Protocol::Frame& status = FixedFrame(Protocol::FixedCommand::Status);
+        m_decoder.Reset();
+        m_decoder.SetAddressFilter(status[1], status[2]);
+        m_decoder.SetExpectedCommand(0);
+
+        // The other master polls an idle post about every idlePollDelayMs:
+        // twice that without a reply of ours counts as no response
+        auto lastSeen = std::chrono::steady_clock::now();
 
-                Sleep(m_timingParams.linkLostPollMs);
+        while (m_isRunning.load())
+        {
+            if (m_transport->IsDeviceLost())
+            {
+                RecoverDevice();
+                lastSeen = std::chrono::steady_clock::now();
                 continue;
             }
 
-            // Response received - reset noResponse counter
-            m_noResponseCount.store(0);
+            m_transport->Receive(m_decoder, SNIFF_WAIT_MS, m_timingParams.interByteTimeoutMs);
 
-            // 3) Process through FSM - it determines action
-            ProcessStatusAndAct(statusResp);
-
-            // 4) Adaptive delay between SR requests
-            // In transaction state - minimal delay for fast UI update
-            // In IDLE state - larger delay to reduce line load (matches reference ~500ms)
-            Protocol::DispenserState currentState = m_fsm.GetState();
-            if (currentState == Protocol::DispenserState::Idle || 
-                currentState == Protocol::DispenserState::Error)
+            const auto now = std::chrono::steady_clock::now();
+            bool haveFrame = m_decoder.HasFrame();
+            if (haveFrame)
             {
-                // IDLE state - slow polling
-                Sleep(m_timingParams.idlePollDelayMs);
+                lastSeen = now;
+                m_noResponseCount.store(0);
             }
-            else
+            while (haveFrame)
+            {
+                const Protocol::Frame& frame = m_decoder.GetFrame();
+                m_decoder.ConsumeFrame();
+                HandleObservedFrame(frame);
+                haveFrame = m_decoder.Drain();
+            }
+
+            if (now - lastSeen >= std::chrono::milliseconds(2 * m_timingParams.idlePollDelayMs))
             {
-                // Transaction - fast polling (use interCommandDelayMs as base interval)
-                Sleep(m_timingParams.interCommandDelayMs);
+                m_noResponseCount.fetch_add(1);
+                lastSeen = now;
             }
         }
     }
 
-    // ============================================================
-    // SEND WITH RETRY + separate error statistics
-    // ============================================================
+    void DispenserController::HandleObservedFrame(const Protocol::Frame& frame)
+    {
+        Protocol::Response observed = std::visit([&](auto& protocol) {
+            return protocol.DecodeValidatedFrame(frame);
+        }, m_protocol);
+        if (std::holds_alternative<std::monostate>(observed)) return;
 
-    namespace
+        m_exchanges.fetch_add(1, std::memory_order_relaxed);
+        Log("RX(sniff " + std::string(1, static_cast<char>(frame[3])) + "): " +
+            FrameToString(frame), false);
+
+        if (auto* s = std::get_if<Protocol::StatusResponse>(&observed))
+        {
+            // The FSM follows the post; its action is the other master's business
+            m_fsm.ProcessHardwareStatus(static_cast<int>(s->state), s->nozzle);
+            if (m_onStatusChange)
+                m_onStatusChange(m_fsm.GetState(), s->nozzle);
+        }
+        else if (auto* td = std::get_if<Protocol::TransactionResponse>(&observed))
+        {
+            // The other master may repeat TU: reported once
+            ApplyTransaction(*td);
+        }
+        else
+        {
+            if (std::holds_alternative<Protocol::TotalCounterResponse>(observed) && m_fsm.IsC0Needed())
+                m_fsm.MarkC0Sent();
+            ApplyDispenseData(observed);
+        }
+    }
+
+    std::chrono::steady_clock::time_point DispenserController::PollOnce()
     {
-        static char ExpectedResponseCmd(char requestCmd)
+        const std::chrono::steady_clock::time_point cycleStart = std::chrono::steady_clock::now();
+        NoteCycleStart(cycleStart);
+
+        // 1) Execute user command queue
+        ExecutePendingCommands();
+
+        if (!m_isRunning.load()) return std::chrono::steady_clock::now();
+
+        // 2) SR status request
+        const Protocol::Frame& statusCmd = FixedFrame(Protocol::FixedCommand::Status);
+
+        auto statusResp = SendWithRetry(statusCmd, m_timingParams.maxRetries, m_timingParams.responseTimeoutMs);
+        auto* status = std::get_if<Protocol::StatusResponse>(&statusResp);
+
+        // No answer in time, but an S that came too late for an earlier
+        // exchange still tells where the post is: the FSM acts on it
+        if (!status && m_lateStatus)
         {
-            switch (requestCmd)
-            {
-            case 'S': case 'L': case 'R': case 'T': case 'C':
-                return requestCmd;
-            default:
-                return 'S';
-            }
+            Log("Late S applied", false);
+            statusResp = *m_lateStatus;
+            status = std::get_if<Protocol::StatusResponse>(&statusResp);
         }
+        m_lateStatus.reset();
 
-        static size_t MinFrameLenByCmd(char responseCmd)
+        PollPhase phase;
+        if (!status)
         {
-            switch (responseCmd)
+            // All attempts failed - connection lost
+            int noRespCnt = m_noResponseCount.load();
+            if (noRespCnt % 10 == 0 && noRespCnt > 0)
             {
-            case 'S': return 7;
-            case 'L': return 15;
-            case 'R': return 15;
-            case 'T': return 27;
-            case 'C': return 16;
-            default:  return 5;
+                Log("No response. NoRespCount=" + std::to_string(noRespCnt) +
+                    " CrcCount=" + std::to_string(m_crcErrorCount.load()), false);
             }
+
+            phase = PollPhase::LinkLost;
         }
+        else
+        {
+            // Response received - reset noResponse counter
+            m_noResponseCount.store(0);
+
+            // 3) Process through FSM - it determines action
+            ProcessStatusAndAct(*status);
+
+            // 4) Cadence by state: fuelling - fast for the display,
+            // IDLE - slow to reduce line load (matches reference ~500ms)
+            phase = PhaseOf(m_fsm.GetState());
+        }
+
+        return ScheduleNextCycle(phase, cycleStart);
+    }
 
-        static bool TryExtractExpectedFrame(
-            const std::vector<uint8_t>& raw,
-            const std::vector<uint8_t>& requestFrame,
-            char expectedResponseCmd,
-            std::vector<uint8_t>& outFrame,
-            Protocol::GasKitProtocol& protocol,
-            std::mutex& protocolMutex)
+    // ============================================================
+    // POLL CADENCE — absolute deadlines (see PollCadence.h)
+    // ============================================================
+
+    PollPhase DispenserController::PhaseOf(Protocol::DispenserState state)
+    {
+        switch (state)
         {
-            outFrame.clear();
+        case Protocol::DispenserState::Fuelling:
+        case Protocol::DispenserState::SuspendedFuelling:
+        case Protocol::DispenserState::Stopped:
+            return PollPhase::Active;
+        case Protocol::DispenserState::Calling:
+        case Protocol::DispenserState::Authorized:
+        case Protocol::DispenserState::Started:
+        case Protocol::DispenserState::SuspendedStarted:
+        case Protocol::DispenserState::EndOfTransaction:
+            return PollPhase::Busy;
+        default:
+            return PollPhase::Idle;
+        }
+    }
 
-            if (raw.size() < 5 || requestFrame.size() < 3)
-                return false;
+    int DispenserController::TargetPeriodMs(PollPhase phase) const
+    {
+        switch (phase)
+        {
+        case PollPhase::Active:   return m_timingParams.activePollPeriodMs;
+        case PollPhase::Busy:     return m_timingParams.busyPollPeriodMs;
+        case PollPhase::LinkLost: return m_timingParams.linkLostPollMs;
+        default:                  return m_timingParams.idlePollDelayMs;
+        }
+    }
 
-            const uint8_t addrHi = requestFrame[1];
-            const uint8_t addrLo = requestFrame[2];
+    void DispenserController::NoteCycleStart(std::chrono::steady_clock::time_point start)
+    {
+        const std::chrono::steady_clock::time_point last = m_lastCycleStart;
+        m_lastCycleStart = start;
+        if (last == std::chrono::steady_clock::time_point()) return;
+
+        const double periodMs = std::chrono::duration<double, std::milli>(start - last).count();
+        const int targetMs = TargetPeriodMs(m_lastPhase);
+
+        std::lock_guard<std::mutex> lock(m_cadenceMutex);
+        PollPhaseStats& stats = m_cadence[static_cast<int>(m_lastPhase)];
+        stats.periods++;
+        stats.meanMs += (periodMs - stats.meanMs) / static_cast<double>(stats.periods);
+        if (periodMs > stats.maxMs) stats.maxMs = periodMs;
+        if (m_lastPhase != PollPhase::LinkLost && targetMs > 0 &&
+            periodMs > targetMs + POLL_OVERRUN_TOLERANCE_MS)
+            stats.overruns++;
+    }
 
-            const size_t minLen = MinFrameLenByCmd(expectedResponseCmd);
-            if (raw.size() < minLen)
-                return false;
+    std::chrono::steady_clock::time_point DispenserController::ScheduleNextCycle(
+        PollPhase phase, std::chrono::steady_clock::time_point cycleStart)
+    {
+        using Clock = std::chrono::steady_clock;
 
-            for (size_t start = 0; start + minLen <= raw.size(); start++)
-            {
-                if (raw[start] != Protocol::STX) continue;
-                if (start + 3 >= raw.size()) continue;
+        const Clock::time_point now = Clock::now();
+        const std::chrono::milliseconds period(TargetPeriodMs(phase));
 
-                if (raw[start + 1] != addrHi || raw[start + 2] != addrLo) continue;
-                if (static_cast<char>(raw[start + 3]) != expectedResponseCmd) continue;
+        Clock::time_point due;
+        if (phase == PollPhase::LinkLost)
+        {
+            // The cycle was timeouts only: rest, do not keep the line busy
+            due = now + period;
+        }
+        else
+        {
+            // One period after the deadline this cycle was due at, so wake-up
+            // latency does not accumulate; from the cycle start after a state
+            // change, an early start (bus, queued command) or an overrun
+            const bool onTime = phase == m_lastPhase &&
+                m_cycleDue <= cycleStart && cycleStart - m_cycleDue < period;
+            due = (onTime ? m_cycleDue : cycleStart) + period;
+        }
 
-                // Limit search to maximum frame size (section 6.5)
-                size_t maxEnd = (std::min)(start + MAX_FRAME_SIZE - 1, raw.size() - 1);
-                for (size_t end = start + minLen - 1; end <= maxEnd; end++)
-                {
-                    std::vector<uint8_t> candidate(raw.begin() + start, raw.begin() + end + 1);
+        if (m_holdOffMs > 0)
+        {
+            // Post-NO pause: this period is not the cadence, leave it unmeasured
+            due = (std::max)(due, now + std::chrono::milliseconds(m_holdOffMs));
+            m_holdOffMs = 0;
+            m_lastCycleStart = {};
+        }
 
-                    bool ok = false;
-                    {
-                        std::lock_guard<std::mutex> lock(protocolMutex);
-
-                        if (!protocol.ValidateCRC(candidate))
-                        {
-                            ok = false;
-                        }
-                        else
-                        {
-                            switch (expectedResponseCmd)
-                            {
-                            case 'S': ok = protocol.ParseStatusResponse(candidate).valid; break;
-                            case 'L': ok = protocol.ParseVolumeResponse(candidate).valid; break;
-                            case 'R': ok = protocol.ParseMoneyResponse(candidate).valid; break;
-                            case 'T': ok = protocol.ParseTransactionResponse(candidate).valid; break;
-                            case 'C': ok = protocol.ParseTotalCounterResponse(candidate).valid; break;
-                            default:  ok = true; break;
-                            }
-                        }
-                    }
+        m_cycleDue = due;
+        m_lastPhase = phase;
+        {
+            std::lock_guard<std::mutex> lock(m_cadenceMutex);
+            m_currentPhase = phase;
+        }
+        return due;
+    }
 
-                    if (ok)
-                    {
-                        outFrame = std::move(candidate);
-                        return true;
-                    }
-                }
-            }
+    PollCadenceStats DispenserController::GetPollCadence() const
+    {
+        PollCadenceStats stats;
+        {
+            std::lock_guard<std::mutex> lock(m_cadenceMutex);
+            stats.current = m_currentPhase;
+            for (int i = 0; i < POLL_PHASE_COUNT; i++)
+                stats.phases[i] = m_cadence[i];
+        }
+        for (int i = 0; i < POLL_PHASE_COUNT; i++)
+            stats.phases[i].targetMs = TargetPeriodMs(static_cast<PollPhase>(i));
+        return stats;
+    }
 
-            return false;
+    void DispenserController::ResetPollCadence()
+    {
+        std::lock_guard<std::mutex> lock(m_cadenceMutex);
+        for (PollPhaseStats& stats : m_cadence)
+            stats = PollPhaseStats{};
+    }
+
+    // ============================================================
+    // SEND WITH RETRY + separate error statistics
+    // ============================================================
+
+    namespace
+    {
+        static char ExpectedResponseCmd(char requestCmd)
+        {
+            switch (requestCmd)
+            {
+            case 'S': case 'L': case 'R': case 'T': case 'C':
+                return requestCmd;
+            default:
+                return 'S';
+            }
         }
     } // anonymous namespace
 
-    std::vector<uint8_t> DispenserController::SendWithRetry(
-        const std::vector<uint8_t>& command, int maxRetries, int timeoutMs)
+    int DispenserController::ResponseBudgetMs(char expectedCmd, int ceilingMs) const
+    {
+        // The transport starts the clock once TX has drained, so only the
+        // reply is on the wire within the budget: a 7-byte S reply gets a
+        // much tighter timeout than a 27-byte T, at any line speed. A
+        // native UART does not pay the 16 ms of an untuned FTDI dongle.
+        const SerialSettings settings = m_transport->GetSettings();
+        const size_t replyBytes = m_decoder.ResponseFrameLength(expectedCmd);
+
+        const int budgetMs = static_cast<int>((settings.WireTimeUs(replyBytes) + 999) / 1000) +
+            m_timingParams.turnaroundMs + m_transport->GetAdapter().latencyMs;
+        const int limitMs = settings.ScaleTimeoutMs(ceilingMs, replyBytes);
+        return budgetMs < limitMs ? budgetMs : limitMs;
+    }
+
+    Protocol::Response DispenserController::SendWithRetry(
+        const Protocol::Frame& command, int maxRetries, int timeoutMs)
     {
-        // Backoff delay between retry attempts (ms)
-        // Gives USB-UART driver time to "deliver" remaining bytes
+        // Backoff window between retry attempts (ms).
+        // Gives USB-UART driver time to "deliver" remaining bytes; the
+        // line is listened to meanwhile, so a reply that is merely late
+        // is still taken and the retry is not needed.
         const int retryBackoffMs = 150;
 
+        // Gap before the next TX, kept by the transport when it sends
+        // (not slept here: whatever runs in between overlaps it)
+        const auto holdLine = [this] {
+            m_transport->HoldTxUntil(std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(m_timingParams.interCommandDelayMs));
+        };
+
+        // The decoder accepts any response from our slave (section 6.4);
+        // the letter tells whether it answers this request or an earlier one
+        const char reqCmd = (command.size() >= 4) ? static_cast<char>(command[3]) : '?';
+        const char expectedCmd = ExpectedResponseCmd(reqCmd);
+
+        // Per-command budget from the end of TX (timeoutMs is the ceiling)
+        timeoutMs = ResponseBudgetMs(expectedCmd, timeoutMs);
+        m_decoder.SetAddressFilter(command[1], command[2]);
+        m_decoder.SetExpectedCommand(0);
+        m_lateDecoder.SetAddressFilter(command[1], command[2]);
+
+        // Replies that arrived after an earlier exchange gave up -
+        // collect them before a purge throws them away
+        SalvageLateFrames();
+
         for (int attempt = 0; attempt < maxRetries; attempt++)
         {
             if (!m_isRunning.load()) return {};  // Don't increment noResponse on shutdown
 
             Log("TX: " + FrameToString(command), true);
 
-            auto response = m_serialPort.SendAndReceive(command, timeoutMs,
+            // Every received byte goes through m_decoder once inside the
+            // port: address and CRC are checked on the fly
+            auto attemptStart = std::chrono::steady_clock::now();
+            auto response = m_transport->SendAndReceive(command, m_decoder, timeoutMs,
                 m_timingParams.interByteTimeoutMs, m_timingParams.forceBufferClear);
 
-            if (response.empty())
+            Protocol::Response decoded;
+            const char* failure = "no response";
+
+            if (!response.empty())
             {
-                // Backoff before next attempt
-                if (attempt < maxRetries - 1)
+                // Check frame size exceeds maximum (section 6.5)
+                if (response.size() > m_maxFrameSize)
                 {
-                    Log("RETRY " + std::to_string(attempt + 1) + "/" +
-                        std::to_string(maxRetries) + " (no response) - backoff " + std::to_string(retryBackoffMs) + "ms", false);
-                    Sleep(retryBackoffMs);
+                    FM_LOG_WARNING("Frame exceeds MAX_FRAME_SIZE(%zu): got %zu bytes — possible frame merge",
+                        m_maxFrameSize, response.size());
                 }
-                continue;
-            }
 
-            // Check frame size exceeds maximum (section 6.5)
-            if (response.size() > MAX_FRAME_SIZE)
-            {
-                FM_LOG_WARNING("Frame exceeds MAX_FRAME_SIZE(%d): got %zu bytes — possible frame merge",
-                    MAX_FRAME_SIZE, response.size());
-            }
+                Log("RX(raw): " + FrameToString(response), false);
 
-            Log("RX(raw): " + FrameToString(response), false);
+                const bool gotFrame = m_decoder.HasFrame();
+                decoded = TakeExpectedFrame(expectedCmd, response.size());
 
-            bool crcValid;
-            {
-                std::lock_guard<std::mutex> lock(m_protocolMutex);
-                crcValid = m_protocol.ValidateCRC(response);
+                if (std::holds_alternative<std::monostate>(decoded) && gotFrame)
+                {
+                    // The read ended on a late reply to another request -
+                    // ours may still come within this attempt's timeout
+                    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - attemptStart).count();
+                    decoded = AwaitReply(expectedCmd, timeoutMs - static_cast<int>(elapsedMs));
+                }
+                else if (!gotFrame)
+                {
+                    // Bytes arrived but no frame could be extracted - CRC error
+                    Log("CRC ERROR! (no valid frame found)", false);
+                    m_crcErrorCount.fetch_add(1);
+                    failure = "CRC error";
+                }
             }
 
-            if (crcValid && response.size() <= MAX_FRAME_SIZE)
+            if (!std::holds_alternative<std::monostate>(decoded))
             {
-                Sleep(m_timingParams.interCommandDelayMs);
-                return response;
+                NoteAttempt(true);
+                holdLine();
+                return decoded;
             }
+            NoteAttempt(false);
 
-            // CRC mismatch or frame too long - resync (section 6.4)
-            const char reqCmd = (command.size() >= 4) ? static_cast<char>(command[3]) : '?';
-            const char expectedCmd = ExpectedResponseCmd(reqCmd);
+            // Adapter gone: retries and backoff cannot help, reopen first
+            if (m_transport->IsDeviceLost())
+                break;
 
-            std::vector<uint8_t> fixed;
-            if (TryExtractExpectedFrame(response, command, expectedCmd, fixed, m_protocol, m_protocolMutex))
+            // Backoff before next attempt - listening instead of sleeping
+            if (attempt < maxRetries - 1)
             {
-                Log("RX(resync): " + FrameToString(fixed), false);
-                // CRC error (resync required) - increment crcError
-                m_crcErrorCount.fetch_add(1);
+                Log("RETRY " + std::to_string(attempt + 1) + "/" +
+                    std::to_string(maxRetries) + " (" + failure + ") - backoff " +
+                    std::to_string(retryBackoffMs) + "ms", false);
 
-                Sleep(m_timingParams.interCommandDelayMs);
-                return fixed;
+                decoded = AwaitReply(expectedCmd, retryBackoffMs);
+                if (!std::holds_alternative<std::monostate>(decoded))
+                {
+                    m_retriesAvoided.fetch_add(1);
+                    Log("Late reply accepted - retry avoided", false);
+                    NoteAttempt(true);
+                    holdLine();
+                    return decoded;
+                }
             }
+        }
 
-            // Could not extract valid frame - CRC error
-            Log("CRC ERROR! (no valid frame found) - backoff " + std::to_string(retryBackoffMs) + "ms", false);
-            m_crcErrorCount.fetch_add(1);
+        // All attempts exhausted - one increment of noResponse for entire SR cycle
+        m_noResponseCount.fetch_add(1);
+        return {};
+    }
 
-            // Backoff before next attempt on CRC error
-            if (attempt < maxRetries - 1)
+    void DispenserController::NoteAttempt(bool answered)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const bool recovering = m_recoveryStart != std::chrono::steady_clock::time_point();
+
+        if (!answered)
+        {
+            m_failedAttempts.fetch_add(1, std::memory_order_relaxed);
+            if (!recovering) m_recoveryStart = now;
+            return;
+        }
+
+        m_exchanges.fetch_add(1, std::memory_order_relaxed);
+        if (recovering)
+        {
+            const uint64_t us = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(now - m_recoveryStart).count());
+            m_recoveries.fetch_add(1, std::memory_order_relaxed);
+            m_recoveryUs.fetch_add(us, std::memory_order_relaxed);
+            if (us > m_maxRecoveryUs.load(std::memory_order_relaxed))
+                m_maxRecoveryUs.store(us, std::memory_order_relaxed);
+            m_recoveryStart = {};
+        }
+    }
+
+    Protocol::Response DispenserController::TakeExpectedFrame(char expectedCmd, size_t rawSize)
+    {
+        // CRC already verified by the decoder - decode fields only
+        // (field decoding reads no protocol state: no m_protocolMutex).
+        // If the fields are bad, keep looking at frames still buffered.
+        size_t lateBytes = 0;
+        bool haveFrame = m_decoder.HasFrame();
+        while (haveFrame)
+        {
+            const Protocol::Frame& frame = m_decoder.GetFrame();
+            m_decoder.ConsumeFrame();
+
+            if (static_cast<char>(frame[3]) != expectedCmd)
             {
-                Sleep(retryBackoffMs);
+                lateBytes += frame.size();
+                HandleLateFrame(frame);
             }
+            else
+            {
+                Protocol::Response decoded = std::visit([&](auto& protocol) {
+                    return protocol.DecodeValidatedFrame(frame);
+                }, m_protocol);
+
+                if (!std::holds_alternative<std::monostate>(decoded))
+                {
+                    if (frame.size() + lateBytes != rawSize)
+                    {
+                        // Frame had to be cut out of noise / merged data - resync
+                        Log("RX(resync): " + FrameToString(frame), false);
+                        m_crcErrorCount.fetch_add(1);
+                    }
+                    return decoded;
+                }
+            }
+
+            haveFrame = m_decoder.Drain();
         }
+        return {};
+    }
 
-        // All attempts exhausted - one increment of noResponse for entire SR cycle
-        m_noResponseCount.fetch_add(1);
+    Protocol::Response DispenserController::AwaitReply(char expectedCmd, int windowMs)
+    {
+        auto start = std::chrono::steady_clock::now();
+        while (m_isRunning.load())
+        {
+            auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            int leftMs = windowMs - static_cast<int>(elapsedMs);
+            if (leftMs <= 0) break;
+
+            auto raw = m_transport->Receive(m_decoder, leftMs, m_timingParams.interByteTimeoutMs);
+            if (!raw.empty())
+                Log("RX(raw): " + FrameToString(raw), false);
+
+            // No frame completed: the window ran out
+            if (!m_decoder.HasFrame()) break;
+
+            Protocol::Response decoded = TakeExpectedFrame(expectedCmd, raw.size());
+            if (!std::holds_alternative<std::monostate>(decoded))
+                return decoded;
+        }
         return {};
     }
 
+    // ============================================================
+    // LATE REPLIES
+    // The reply letter identifies the request that caused it.
+    // L/R/C values are applied as data. A late S is kept for
+    // PollOnce, which acts on it when its own SR gets no answer
+    // (never from here: this runs inside an exchange). A late T
+    // completes the transaction if its TU is still unanswered.
+    // ============================================================
+
+    void DispenserController::HandleLateFrame(const Protocol::Frame& frame)
+    {
+        Protocol::Response late = std::visit([&](auto& protocol) {
+            return protocol.DecodeValidatedFrame(frame);
+        }, m_protocol);
+        if (std::holds_alternative<std::monostate>(late)) return;
+
+        m_lateFrames.fetch_add(1);
+        Log("RX(late " + std::string(1, static_cast<char>(frame[3])) + "): " +
+            FrameToString(frame), false);
+
+        if (auto* s = std::get_if<Protocol::StatusResponse>(&late))
+        {
+            m_lateStatus = *s;
+        }
+        else if (auto* td = std::get_if<Protocol::TransactionResponse>(&late))
+        {
+            // A T of an earlier transaction must not overwrite this one's data
+            if (m_fsm.IsTUReplyPending())
+                ApplyTransaction(*td);
+        }
+        else
+        {
+            ApplyDispenseData(late);
+        }
+    }
+
+    void DispenserController::ApplyTransaction(const Protocol::TransactionResponse& td)
+    {
+        const bool first = m_fsm.IsTUReplyPending();
+        m_fsm.MarkTUSent();
+        m_fsm.MarkTUAnswered();
+
+        double finalLiters = td.volumeCentiliters / 100.0;
+        double finalMoney = static_cast<double>(td.money);
+        m_currentMoney.store(finalMoney);
+        m_currentLiters.store(finalLiters);
+        m_transactionDataReady.store(true);
+
+        if (first && m_onTransactionComplete)
+            m_onTransactionComplete(finalLiters, finalMoney, td.price);
+    }
+
+    void DispenserController::ApplyDispenseData(const Protocol::Response& response)
+    {
+        if (auto* v = std::get_if<Protocol::VolumeResponse>(&response))
+        {
+            double liters = v->volumeCentiliters / 100.0;
+            m_currentLiters.store(liters);
+            if (m_onFuelData) m_onFuelData(liters, m_currentMoney.load());
+        }
+        else if (auto* r = std::get_if<Protocol::MoneyResponse>(&response))
+        {
+            double money = static_cast<double>(r->money);
+            m_currentMoney.store(money);
+            if (m_onFuelData) m_onFuelData(m_currentLiters.load(), money);
+        }
+        else if (auto* t = std::get_if<Protocol::TotalCounterResponse>(&response))
+        {
+            m_totalCounter.store(t->totalCentiliters / 100.0);
+        }
+    }
+
+    void DispenserController::SalvageLateFrames()
+    {
+        auto bytes = m_transport->TakeUnread();
+        if (bytes.empty()) return;
+
+        m_lateDecoder.Reset();
+        m_lateDecoder.Feed(bytes, [this](const Protocol::Frame& frame) {
+            HandleLateFrame(frame);
+        });
+    }
+
     // ============================================================
     // LOGGING / ERRORS
     // ============================================================
@@ -741,7 +1367,7 @@ namespace FuelMaster {
             m_onError(message);
     }
 
-    std::string DispenserController::FrameToString(const std::vector<uint8_t>& frame)
+    std::string DispenserController::FrameToString(std::span<const uint8_t> frame)
     {
         std::ostringstream oss;
         for (size_t i = 0; i < frame.size(); i++)
@@ -761,6 +1387,36 @@ namespace FuelMaster {
         return m_timingParams;
     }
 
+    SerialSettings DispenserController::GetSerialSettings() const
+    {
+        return m_serialSettings;
+    }
+
+    void DispenserController::SetSerialSettings(const SerialSettings& settings)
+    {
+        // Applied to the line on the next Connect
+        m_serialSettings = settings;
+
+        if (Logger::Instance().IsInitialized())
+        {
+            FM_LOG_INFO("Serial settings updated: %d baud, %d data bits, parity=%d, %d stop bits, autoBaud=%s",
+                       settings.baudRate, settings.dataBits, static_cast<int>(settings.parity),
+                       settings.stopBits, settings.autoBaud ? "ON" : "OFF");
+        }
+    }
+
+    void DispenserController::SetPassiveMode(bool enabled)
+    {
+        // Applied on the next Connect (transport opened receive-only);
+        // a running session keeps the mode it was connected with
+        m_passive.store(enabled);
+
+        if (Logger::Instance().IsInitialized())
+        {
+            FM_LOG_INFO("Passive mode %s", enabled ? "ON" : "OFF");
+        }
+    }
+
     void DispenserController::SetTimingParams(const TimingParams& params)
     {
         m_timingParams = params;
@@ -770,10 +1426,13 @@ namespace FuelMaster {
         // AutoInitialize from C++/CLI context causes SEHException.
         if (Logger::Instance().IsInitialized())
         {
-            FM_LOG_INFO("Timing params updated: responseTimeout=%dms, interByte=%dms, retries=%d, "
-                       "interCmdDelay=%dms, bufferClear=%s",
-                       params.responseTimeoutMs, params.interByteTimeoutMs, params.maxRetries,
-                       params.interCommandDelayMs, params.forceBufferClear ? "ON" : "OFF");
+            FM_LOG_INFO("Timing params updated: responseTimeout=%dms, turnaround=%dms, interByte=%dms, "
+                       "retries=%d, interCmdDelay=%dms, bufferClear=%s, "
+                       "period idle/busy/active=%d/%d/%dms",
+                       params.responseTimeoutMs, params.turnaroundMs, params.interByteTimeoutMs,
+                       params.maxRetries, params.interCommandDelayMs,
+                       params.forceBufferClear ? "ON" : "OFF",
+                       params.idlePollDelayMs, params.busyPollPeriodMs, params.activePollPeriodMs);
         }
     }
 
@@ -9,13 +9,23 @@
 #pragma once
 
 #include "GasKitProtocol.h"
-#include "SerialPort.h"
+#include "GasKitCommandTable.h"
+#include "GasKitFrameDecoder.h"
+#include "Transport.h"
 #include "DispenserFSM.h"
+#include "DispenserBus.h"
+#include "LinkStats.h"
+#include "PollCadence.h"
+#include <chrono>
 #include <functional>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <optional>
 #include <queue>
+#include <span>
+#include <variant>
 
 namespace FuelMaster {
 
@@ -31,36 +41,39 @@ namespace FuelMaster {
     struct TimingParams
     {
         int responseTimeoutMs;      // Response timeout (ms)
-        int interByteTimeoutMs;      // Inter-byte timeout for USB-UART (ms)
+        int interByteTimeoutMs;      // Silence allowed inside a reply, on top of the adapter's RX latency (ms)
         int maxRetries;              // Max retries on error
-        int interCommandDelayMs;     // Delay between commands in transaction (LM->RS) (ms)
-        int idlePollDelayMs;         // Idle state polling interval (ms)
-        int linkLostPollMs;          // Polling interval on connection loss (ms)
+        int interCommandDelayMs;     // Minimum line gap after a reply, before the next TX (LM->RS) (ms)
+        int idlePollDelayMs;         // Idle state poll period, cycle start to start (ms)
+        int linkLostPollMs;          // Rest after a cycle without reply on connection loss (ms)
         int postEndDelayMs;          // Delay after transaction completion (ms)
         int errorThreshold;          // Error threshold for connection loss state
         bool forceBufferClear;       // Force buffer clear before sending
+        int turnaroundMs;            // Dispenser reply latency after TX end, on top of the reply's wire time and the adapter's RX latency (ms)
+        int reopenRetryMs;           // Reopen attempt interval while the port's device is gone (ms)
+        int busyPollPeriodMs;        // Poll period with the nozzle up / authorized / ending (ms, 0 = back to back)
+        int activePollPeriodMs;      // SR+LM+RS period while fuel flows - display refresh (ms, 0 = back to back)
 
         static TimingParams Default()
         {
             return TimingParams{
                 80,     // responseTimeoutMs - enough for USB-UART
-                20,     // interByteTimeoutMs - increased from 3ms to 20ms for USB-UART
+                3,      // interByteTimeoutMs - line gap inside a reply (adapter latency added per port)
                 3,      // maxRetries - decreased from 5 to 3
                 10,     // interCommandDelayMs - minimal delay between LM and RS in transaction
                 450,    // idlePollDelayMs - SR interval in idle (matches reference ~500ms)
                 350,    // linkLostPollMs - interval on connection loss
                 800,    // postEndDelayMs - delay after NO command
                 6,      // errorThreshold
-                false   // forceBufferClear
+                false,  // forceBufferClear
+                14,     // turnaroundMs - dispenser reply (adapter latency added per port)
+                1000,   // reopenRetryMs - fallback when no arrival is reported
+                0,      // busyPollPeriodMs - back to back: next cycle after the line gap
+                0       // activePollPeriodMs - back to back, as fast as the line allows
             };
         }
     };
 
-    // ============================================================
-    // Maximum frame size per protocol (section 6.5)
-    // ============================================================
-    static constexpr int MAX_FRAME_SIZE = 27; // STX(1) + CH(1) + ID(1) + CMD(1) + DATA(22) + CRC(1)
-
     class DispenserController
     {
     public:
@@ -71,10 +84,33 @@ namespace FuelMaster {
         DispenserController& operator=(const DispenserController&) = delete;
 
         // --- Connection ---
-        bool Connect(const std::string& portName, const std::string& slaveAddress = "01");
+        /// dialect: field layout of this post's firmware (see GasKitDialect.h)
+        bool Connect(const std::string& portName, const std::string& slaveAddress = "01",
+                     Protocol::Dialect dialect = Protocol::Dialect::Standard);
+
+        /// Same, over a caller-supplied transport (e.g. PtyTransport in tests)
+        bool Connect(std::unique_ptr<Transport> transport, const std::string& portName,
+                     const std::string& slaveAddress = "01",
+                     Protocol::Dialect dialect = Protocol::Dialect::Standard);
+
+        /// Join a shared RS-485 line: no own port or thread, the bus
+        /// scheduler runs PollOnce (line settings belong to the bus)
+        bool Connect(DispenserBus& bus, const std::string& slaveAddress,
+                     Protocol::Dialect dialect = Protocol::Dialect::Standard);
         void Disconnect();
         bool IsConnected() const;
 
+        /// One poll cycle: queued commands, SR, FSM action.
+        /// Returns the deadline of this post's next cycle (see PollCadence.h).
+        /// Run by the own polling thread or by a DispenserBus.
+        std::chrono::steady_clock::time_point PollOnce();
+
+        /// Cadence group of a dispenser state (bus weights use it too)
+        static PollPhase PhaseOf(Protocol::DispenserState state);
+
+        /// User commands waiting for the next cycle
+        bool HasPendingCommands() const;
+
         // --- Control (non-blocking - queues command) ---
         void QueueStop();
         void QueueVolumePreset(double liters, int pricePerLiter);
@@ -94,6 +130,35 @@ namespace FuelMaster {
         int GetCrcErrorCount() const;
         int GetErrorCount() const; // sum for compatibility
 
+        // --- RS-485 echo cancellation (adapters that loop TX back to RX) ---
+        void SetEchoCancellation(bool enabled);
+        bool GetEchoCancellation() const;
+        uint64_t GetEchoesRemoved() const;
+
+        // --- Late replies (arrived after responseTimeoutMs) ---
+        uint64_t GetRetriesAvoided() const { return m_retriesAvoided.load(); }
+        uint64_t GetLateFrames() const { return m_lateFrames.load(); }
+
+        // --- Link throughput / recovery (see LinkStats.h) ---
+        LinkStats GetLinkStats() const;
+        void ResetLinkStats();
+
+        // --- Receive path (event-driven RX) ---
+        uint64_t GetRxWakeups() const;
+
+        // --- Adapter behind the port (see AdapterProfile.h) ---
+        AdapterInfo GetAdapter() const;
+
+        // --- Poll period, target vs achieved (see PollCadence.h) ---
+        PollCadenceStats GetPollCadence() const;
+        void ResetPollCadence();
+
+        // --- Binary wire capture (replay with "replay:<file>") ---
+        // On a bus the capture covers the whole shared line
+        bool StartCapture(const std::string& path);
+        void StopCapture();
+        bool IsCapturing() const;
+
         // --- Callbacks ---
         void SetStatusCallback(StatusCallback cb) { m_onStatusChange = cb; }
         void SetFuelDataCallback(FuelDataCallback cb) { m_onFuelData = cb; }
@@ -105,9 +170,41 @@ namespace FuelMaster {
         TimingParams GetTimingParams() const;
         void SetTimingParams(const TimingParams& params);
 
+        // --- Line speed / framing (applied on Connect) ---
+        /// TimingParams are tuned at 9600 8N1; their wire-time share is
+        /// rescaled to the actual line speed per exchange
+        SerialSettings GetSerialSettings() const;
+        void SetSerialSettings(const SerialSettings& settings);
+
+        // --- Passive monitoring (applied on Connect) ---
+        /// Watch a line another master (fiscal controller) already polls:
+        /// the port is opened receive-only, our post's replies seen on it
+        /// drive the FSM and the dispense data, nothing is ever sent.
+        /// Queued commands are refused; not available on a DispenserBus.
+        /// IsPassiveMode is the requested mode; a running session keeps
+        /// the one it was connected with (IsPassiveSession).
+        void SetPassiveMode(bool enabled);
+        bool IsPassiveMode() const { return m_passive.load(); }
+        bool IsPassiveSession() const { return m_sessionPassive.load(); }
+
     private:
-        Protocol::GasKitProtocol m_protocol;
-        SerialPort m_serialPort;
+        friend class DispenserBus;
+
+        /// Codec specialised for the post's dialect (chosen in Connect);
+        /// calls go through std::visit, no virtual dispatch
+        using ProtocolVariant = std::variant<Protocol::GasKitProtocol, Protocol::GasKitWideProtocol>;
+
+        ProtocolVariant m_protocol;
+        size_t m_maxFrameSize;  // longest frame of the selected dialect
+        std::atomic<uint8_t> m_slaveAddr;  // addrLo, 1..32 (precomputed frame table key)
+        std::shared_ptr<Transport> m_transport;  // replaced only while disconnected
+        std::atomic<DispenserBus*> m_bus;        // shared line, nullptr = own port / not attached
+        std::atomic<bool> m_ownsTransport;       // opened by our Connect (closed by Disconnect)
+        std::atomic<bool> m_echoCancel;          // applied to each new transport
+        std::atomic<bool> m_passive;             // sniff instead of poll (next Connect)
+        std::atomic<bool> m_sessionPassive;      // m_passive as latched by the last Connect
+        Protocol::FrameDecoder m_decoder;  // response extraction (polling thread only)
+        Protocol::FrameDecoder m_lateDecoder;  // bytes left over from earlier exchanges
         DispenserFSM m_fsm;  // FSM - single source of truth
 
         // Dispense data (updated from LM/RS/TU)
@@ -129,26 +226,126 @@ namespace FuelMaster {
         // --- Separate error statistics (section 6.6) ---
         std::atomic<int> m_noResponseCount;  // no response / connection lost
         std::atomic<int> m_crcErrorCount;  // bad frame / CRC / resync
+        std::atomic<uint64_t> m_retriesAvoided;  // late reply taken during backoff
+        std::atomic<uint64_t> m_lateFrames;      // replies matched to an earlier request
+
+        // --- Link throughput / recovery (LinkStats) ---
+        std::atomic<uint64_t> m_exchanges;
+        std::atomic<uint64_t> m_failedAttempts;
+        std::atomic<uint64_t> m_recoveries;
+        std::atomic<uint64_t> m_recoveryUs;
+        std::atomic<uint64_t> m_maxRecoveryUs;
+        std::atomic<int64_t> m_linkStatsSinceNs;    // steady_clock
+        std::chrono::steady_clock::time_point m_recoveryStart;  // polling thread; {} = not recovering
 
         // --- Priority command queue ---
         struct PendingCommand {
-            std::vector<uint8_t> frame;
+            Protocol::Frame frame;
             std::string description;
         };
         std::queue<PendingCommand> m_commandQueue;
-        std::mutex m_queueMutex;
+        mutable std::mutex m_queueMutex;
+
+        // Latest S that arrived after its exchange gave up (polling thread only)
+        std::optional<Protocol::StatusResponse> m_lateStatus;
+
+        // Extra pause requested by an FSM action (post-NO delay): the next
+        // cycle is due no earlier than this after the current one ends
+        // (polling thread only)
+        int m_holdOffMs;
+
+        // --- Poll cadence (PollCadence) ---
+        std::chrono::steady_clock::time_point m_cycleDue;        // deadline the current cycle was due at
+        std::chrono::steady_clock::time_point m_lastCycleStart;  // {} = do not measure the next period
+        PollPhase m_lastPhase;                                    // (polling thread only, all three)
+        PollPhaseStats m_cadence[POLL_PHASE_COUNT];
+        PollPhase m_currentPhase;
+        mutable std::mutex m_cadenceMutex;  // m_cadence, m_currentPhase
+
+        /// Target period of a phase from m_timingParams
+        int TargetPeriodMs(PollPhase phase) const;
+
+        /// Start of a cycle: the period since the last one into m_cadence
+        void NoteCycleStart(std::chrono::steady_clock::time_point start);
+
+        /// End of a cycle in `phase`: deadline of the next one
+        std::chrono::steady_clock::time_point ScheduleNextCycle(PollPhase phase,
+            std::chrono::steady_clock::time_point cycleStart);
 
         // --- Timing parameters ---
         TimingParams m_timingParams;
+        SerialSettings m_serialSettings;  // requested; the transport reports what is applied
 
         void PollingLoop();
 
-        // Send command with retry
-        std::vector<uint8_t> SendWithRetry(const std::vector<uint8_t>& command,
+        // Passive mode: decode the replies the other master gets, no TX
+        void SniffLoop();
+        void HandleObservedFrame(const Protocol::Frame& frame);
+
+        // Receive wait of SniffLoop (bounds the Disconnect latency)
+        static constexpr int SNIFF_WAIT_MS = 100;
+
+        // Codec / decoders for the address and dialect (thread not running)
+        void SelectDialect(const std::string& slaveAddress, Protocol::Dialect dialect);
+
+        // FSM and counters for a new session, then m_isRunning = true
+        void StartSession();
+
+        // The bus closed under us (DispenserBus::Close, under its mutex):
+        // forget it so Disconnect / Enqueue never reach a destroyed bus
+        void OnBusClosed(DispenserBus* bus);
+
+        // Queue a user command and wake the scheduler (false in passive mode)
+        bool Enqueue(const Protocol::Frame& frame, const char* description);
+
+        // Ready-made parameterless frame for the current slave address (no build, no lock)
+        const Protocol::Frame& FixedFrame(Protocol::FixedCommand cmd) const;
+
+        // Try AUTO_BAUD_CANDIDATES fastest first with SR requests and keep
+        // the first rate that answers cleanly (before the polling thread starts)
+        bool ProbeBaudRate();
+
+        // Send command with retry.
+        // Returns the decoded response (std::monostate if none) - every
+        // received byte is validated and decoded exactly once.
+        Protocol::Response SendWithRetry(const Protocol::Frame& command,
             int maxRetries, int timeoutMs);
 
+        // Decode frames held by m_decoder: the first valid one with the
+        // expected letter is returned, others go to HandleLateFrame
+        Protocol::Response TakeExpectedFrame(char expectedCmd, size_t rawSize);
+
+        // Keep listening (no TX) up to windowMs for the expected reply
+        Protocol::Response AwaitReply(char expectedCmd, int windowMs);
+
+        /// Reply timeout for a command, counted from the end of TX:
+        /// wire time of the expected reply + turnaroundMs + the adapter's
+        /// RX latency (Transport::GetAdapter), capped by
+        /// ceilingMs (responseTimeoutMs, rescaled to the line speed)
+        int ResponseBudgetMs(char expectedCmd, int ceilingMs) const;
+
+        // Late reply to an earlier request, matched by command letter:
+        // L/R/C applied as data, S kept for PollOnce, T taken while
+        // its TU is unanswered
+        void HandleLateFrame(const Protocol::Frame& frame);
+        void SalvageLateFrames();
+
+        // T reply: dispense data, FSM latches, completion callback
+        // (once per transaction)
+        void ApplyTransaction(const Protocol::TransactionResponse& td);
+
+        // L/R/C values into the dispense data (replies not driving the FSM)
+        void ApplyDispenseData(const Protocol::Response& response);
+
+        /// Port's device lost (adapter pulled / reset): wait for it and
+        /// reopen, then resume polling with the same session
+        void RecoverDevice();
+
+        /// Account one attempt of SendWithRetry in the LinkStats
+        void NoteAttempt(bool answered);
+
         // Process SR response through FSM
-        void ProcessStatusAndAct(const std::vector<uint8_t>& response);
+        void ProcessStatusAndAct(const Protocol::StatusResponse& s);
 
         // FSM actions
         void DoFuellingCycle();   // LM + RS
@@ -159,7 +356,7 @@ namespace FuelMaster {
 
         void ExecutePendingCommands();
         void Log(const std::string& message, bool isSent = true);
-        std::string FrameToString(const std::vector<uint8_t>& frame);
+        std::string FrameToString(std::span<const uint8_t> frame);
         void NotifyError(const std::string& message);
 
         static void ParseAddress(const std::string& addr, uint8_t& hi, uint8_t& lo);
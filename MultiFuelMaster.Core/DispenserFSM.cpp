@@ -16,6 +16,7 @@ DispenserFSM::DispenserFSM()
     : m_currentState(State::Error)
     , m_currentNozzle(0)
     , m_finalRequested(false)
+    , m_finalAnswered(false)
     , m_totalsRequested(false)
     , m_noSent(false)
     , m_idlePollCounter(0)
@@ -160,6 +161,11 @@ void DispenserFSM::MarkNOSent()
     m_noSent.store(true);
 }
 
+void DispenserFSM::MarkTUAnswered()
+{
+    m_finalAnswered.store(true);
+}
+
 bool DispenserFSM::IsTUNeeded() const
 {
     return m_currentState.load() == State::Stopped && !m_finalRequested.load();
@@ -176,6 +182,12 @@ bool DispenserFSM::IsNONeeded() const
     return m_currentState.load() == State::EndOfTransaction && !m_noSent.load();
 }
 
+bool DispenserFSM::IsTUReplyPending() const
+{
+    if (m_finalAnswered.load()) return false;
+    return m_finalRequested.load() || m_currentState.load() == State::Stopped;
+}
+
 // ============================================================
 // Idle C0 polling
 // ============================================================
@@ -207,6 +219,7 @@ void DispenserFSM::Reset()
 void DispenserFSM::ResetLatches()
 {
     m_finalRequested.store(false);
+    m_finalAnswered.store(false);
     m_totalsRequested.store(false);
     m_noSent.store(false);
 }
@@ -55,11 +55,16 @@ public:
     void MarkTUSent();
     void MarkC0Sent();
     void MarkNOSent();
+    void MarkTUAnswered();
 
     bool IsTUNeeded() const;
     bool IsC0Needed() const;
     bool IsNONeeded() const;
 
+    // TU due or sent and its T reply not taken yet: a T that arrives
+    // late still belongs to this transaction
+    bool IsTUReplyPending() const;
+
     // --- Reset ---
     void Reset();
 
@@ -81,6 +86,7 @@ private:
 
     // One-time latches for S81 -> S90 -> S10
     std::atomic<bool> m_finalRequested;    // TU sent
+    std::atomic<bool> m_finalAnswered;     // T reply taken (reported once)
     std::atomic<bool> m_totalsRequested;   // C0 sent (after TU)
     std::atomic<bool> m_noSent;            // NO sent
 
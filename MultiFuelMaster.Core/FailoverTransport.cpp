@@ -0,0 +1,408 @@
+// ============================================================
+// FailoverTransport.cpp — Primary and standby path to one post
+// ============================================================
+
+#include "pch.h"
+#include "FailoverTransport.h"
+#include <cmath>
+#include <cstdio>
+
+namespace FuelMaster {
+
+    namespace
+    {
+        constexpr char PREFIX[] = "failover:";
+        constexpr size_t PREFIX_LENGTH = sizeof(PREFIX) - 1;
+        constexpr char SEPARATOR = '|';
+
+        const char* PathLabel(int path)
+        {
+            return path == FailoverTransport::PRIMARY ? "primary" : "standby";
+        }
+    }
+
+    FailoverTransport::FailoverTransport()
+        : FailoverTransport(nullptr, nullptr)
+    {
+    }
+
+    FailoverTransport::FailoverTransport(std::unique_ptr<Transport> primary,
+        std::unique_ptr<Transport> standby, const FailoverPolicy& policy)
+        : m_active(PRIMARY)
+        , m_switches(0)
+        , m_policy(policy)
+    {
+        m_paths[PRIMARY].transport = std::move(primary);
+        m_paths[STANDBY].transport = std::move(standby);
+        for (Path& path : m_paths)
+        {
+            if (path.transport) path.portName = path.transport->GetPortName();
+            ResetRatings(path);
+        }
+    }
+
+    FailoverTransport::~FailoverTransport()
+    {
+        Close();
+    }
+
+    bool FailoverTransport::IsFailoverPortName(const std::string& portName)
+    {
+        return portName.compare(0, PREFIX_LENGTH, PREFIX) == 0;
+    }
+
+    void FailoverTransport::ResetRatings(Path& path)
+    {
+        path.failed = false;
+        path.replyMs = 0.0;
+        path.missRate = 0.0;
+        path.crcRate = 0.0;
+        path.idleSince = Clock::now();
+        path.exchanges = 0;
+        path.misses = 0;
+        path.crcErrors = 0;
+    }
+
+    // ============================================================
+    // OPEN / CLOSE — both paths
+    // ============================================================
+
+    bool FailoverTransport::Open(const std::string& portName, const SerialSettings& settings)
+    {
+        if (IsFailoverPortName(portName))
+        {
+            const std::string names = portName.substr(PREFIX_LENGTH);
+            const size_t separator = names.find(SEPARATOR);
+            if (separator == std::string::npos)
+            {
+                m_lastError = "Expected failover:<primary>|<standby>";
+                return false;
+            }
+            m_paths[PRIMARY].portName = names.substr(0, separator);
+            m_paths[STANDBY].portName = names.substr(separator + 1);
+        }
+
+        std::string errors;
+        for (int i = PRIMARY; i <= STANDBY; i++)
+        {
+            Path& path = m_paths[i];
+            if (!path.transport && !path.portName.empty())
+                path.transport = Transport::Create(path.portName);
+
+            std::string error;
+            if (!path.transport)
+                error = "no backend";
+            else if (!path.transport->IsOpen() && !path.transport->Open(path.portName, settings))
+                error = path.transport->GetLastError();
+            if (!error.empty())
+                errors += std::string(errors.empty() ? "" : "; ") + PathLabel(i) + ": " + error;
+            else if (path.portName.empty())
+                path.portName = path.transport->GetPortName();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ResetRatings(path);
+            path.failed = !error.empty();
+        }
+
+        // Primary preferred; a standby-only start is still a working post
+        const int active = !m_paths[PRIMARY].failed ? PRIMARY : STANDBY;
+        if (m_paths[active].failed)
+        {
+            m_lastError = errors;
+            return false;
+        }
+
+        m_active.store(active);
+        m_portName = portName;
+        m_settings = m_paths[active].transport->GetSettings();
+        m_lastError = errors;     // the other path's failure, if any
+        return true;
+    }
+
+    void FailoverTransport::Close()
+    {
+        for (Path& path : m_paths)
+        {
+            if (path.transport) path.transport->Close();
+        }
+    }
+
+    bool FailoverTransport::IsOpen() const
+    {
+        for (const Path& path : m_paths)
+        {
+            if (path.transport && path.transport->IsOpen()) return true;
+        }
+        return false;
+    }
+
+    bool FailoverTransport::Configure(const SerialSettings& settings)
+    {
+        // The standby must speak the same line when it takes over
+        bool configured = false;
+        for (int i = PRIMARY; i <= STANDBY; i++)
+        {
+            Transport* transport = m_paths[i].transport.get();
+            if (!transport || !transport->IsOpen()) continue;
+
+            if (!transport->Configure(settings))
+            {
+                if (i == m_active.load())
+                {
+                    m_lastError = transport->GetLastError();
+                    return false;
+                }
+                continue;
+            }
+            configured = true;
+        }
+        if (!configured) return false;
+
+        m_settings = settings;
+        return true;
+    }
+
+    void FailoverTransport::PurgeInput()
+    {
+        Transport* transport = m_paths[m_active.load()].transport.get();
+        if (transport && transport->IsOpen()) transport->PurgeInput();
+    }
+
+    // ============================================================
+    // POLICY / STATISTICS
+    // ============================================================
+
+    void FailoverTransport::SetPolicy(const FailoverPolicy& policy)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_policy = policy;
+    }
+
+    FailoverPolicy FailoverTransport::GetPolicy() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_policy;
+    }
+
+    FailoverPathStats FailoverTransport::GetPathStats(int path) const
+    {
+        const Path& p = m_paths[path == PRIMARY ? PRIMARY : STANDBY];
+        const Clock::time_point now = Clock::now();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FailoverPathStats stats;
+        stats.portName = p.portName;
+        stats.open = p.transport && p.transport->IsOpen();
+        stats.active = (path == m_active.load());
+        stats.failed = p.failed;
+        stats.score = Score(p, now);
+        stats.replyMs = p.replyMs;
+        stats.missRate = FadedRate(p, p.missRate, now);
+        stats.crcRate = FadedRate(p, p.crcRate, now);
+        stats.exchanges = p.exchanges;
+        stats.misses = p.misses;
+        stats.crcErrors = p.crcErrors;
+        return stats;
+    }
+
+    std::string FailoverTransport::Report() const
+    {
+        std::string report = "failover:";
+        for (int i = PRIMARY; i <= STANDBY; i++)
+        {
+            const FailoverPathStats s = GetPathStats(i);
+            char line[256];
+            snprintf(line, sizeof(line),
+                " %s%s %s score %.0f (reply %.1f ms, miss %.1f%%, crc %.1f%%, %llu exchanges)%s |",
+                s.active ? "*" : "", PathLabel(i), s.portName.c_str(), s.score, s.replyMs,
+                100.0 * s.missRate, 100.0 * s.crcRate,
+                static_cast<unsigned long long>(s.exchanges),
+                s.failed ? " failed" : (s.open ? "" : " closed"));
+            report += line;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        report += " " + std::to_string(m_switches.load()) + " switches";
+        if (!m_lastSwitch.empty()) report += ", last: " + m_lastSwitch;
+        return report;
+    }
+
+    // ============================================================
+    // RATING
+    // score = 100 x (1 - miss) x (1 - crc) x min(1, good / reply)
+    // The idle path keeps the rates it left with, fading toward
+    // zero (half-life idleHalfLifeMs); a failed idle path scores
+    // 0 for one half-life before it is worth a reopen again.
+    // ============================================================
+
+    void FailoverTransport::OnExchangeEnd(bool answered, uint64_t crcErrors, int64_t replyUs)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Path& path = m_paths[m_active.load()];
+        const double a = m_policy.smoothing;
+
+        path.exchanges++;
+        path.missRate = a * (answered ? 0.0 : 1.0) + (1.0 - a) * path.missRate;
+        path.crcRate = a * (crcErrors > 0 ? 1.0 : 0.0) + (1.0 - a) * path.crcRate;
+        if (!answered) path.misses++;
+        path.crcErrors += crcErrors;
+
+        if (answered)
+        {
+            const double replyMs = static_cast<double>(replyUs) / 1000.0;
+            path.replyMs = path.replyMs > 0.0 ? a * replyMs + (1.0 - a) * path.replyMs : replyMs;
+        }
+    }
+
+    double FailoverTransport::FadedRate(const Path& path, double rate, Clock::time_point now) const
+    {
+        if (&path == &m_paths[m_active.load()] || m_policy.idleHalfLifeMs <= 0) return rate;
+
+        const double idleMs = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - path.idleSince).count());
+        return rate * std::pow(0.5, idleMs / m_policy.idleHalfLifeMs);
+    }
+
+    double FailoverTransport::Score(const Path& path, Clock::time_point now) const
+    {
+        if (!path.transport) return 0.0;
+
+        const bool active = (&path == &m_paths[m_active.load()]);
+        if (path.failed && (active || now - path.idleSince < std::chrono::milliseconds(m_policy.idleHalfLifeMs)))
+            return 0.0;
+
+        const double replyFactor = path.replyMs > m_policy.goodReplyMs
+            ? m_policy.goodReplyMs / path.replyMs : 1.0;
+        return 100.0 * (1.0 - FadedRate(path, path.missRate, now)) *
+            (1.0 - FadedRate(path, path.crcRate, now)) * replyFactor;
+    }
+
+    // ============================================================
+    // SWITCHING
+    // ============================================================
+
+    bool FailoverTransport::SelectPath()
+    {
+        const int active = m_active.load();
+        const int other = 1 - active;
+        const char* reason = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const Clock::time_point now = Clock::now();
+            const double activeScore = Score(m_paths[active], now);
+            const double otherScore = Score(m_paths[other], now);
+
+            if (m_paths[active].failed)
+                reason = "active path failed";
+            else if (activeScore < m_policy.switchBelowScore &&
+                otherScore >= activeScore + m_policy.switchMargin)
+                reason = "active path degraded";
+        }
+
+        if (reason && SwitchTo(other, reason)) return true;
+        return !m_paths[m_active.load()].failed;
+    }
+
+    bool FailoverTransport::SwitchTo(int path, const char* reason)
+    {
+        Path& target = m_paths[path];
+        if (!target.transport) return false;
+
+        // A failed path was closed: reopen it with the line settings in use
+        if (!target.transport->IsOpen() && !target.transport->Open(target.portName, m_settings))
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            target.failed = true;
+            target.idleSince = Clock::now();    // not worth another try for a while
+            m_lastError = std::string(PathLabel(path)) + ": " + target.transport->GetLastError();
+            return false;
+        }
+        if (!(target.transport->GetSettings() == m_settings))
+            target.transport->Configure(m_settings);
+
+        // Whatever the idle path picked up is not an answer to us
+        target.transport->PurgeInput();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const Clock::time_point now = Clock::now();
+
+        // The faded rates become the starting point of the new active path
+        target.missRate = FadedRate(target, target.missRate, now);
+        target.crcRate = FadedRate(target, target.crcRate, now);
+        target.failed = false;
+
+        m_paths[m_active.load()].idleSince = now;
+        m_active.store(path);
+        m_switches.fetch_add(1);
+        m_lastSwitch = std::string(reason) + " -> " + PathLabel(path) + " " + target.portName;
+        return true;
+    }
+
+    bool FailoverTransport::FailActive()
+    {
+        const int active = m_active.load();
+        Path& path = m_paths[active];
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            path.failed = true;
+            m_lastError = std::string(PathLabel(active)) + ": " + path.transport->GetLastError();
+        }
+
+        // Release the handle: a re-enumerated adapter needs its node back
+        path.transport->Close();
+        return SwitchTo(1 - active, "device error");
+    }
+
+    // ============================================================
+    // I/O — active path; a device error falls over mid-exchange
+    // ============================================================
+
+    int FailoverTransport::Write(const uint8_t* data, size_t size)
+    {
+        if (!SelectPath()) return 0;
+
+        int written = InnerWrite(*m_paths[m_active.load()].transport, data, size);
+        if (written == 0 && FailActive())
+            written = InnerWrite(*m_paths[m_active.load()].transport, data, size);
+        return written;
+    }
+
+    bool FailoverTransport::DrainTx(int timeoutMs)
+    {
+        return InnerDrainTx(*m_paths[m_active.load()].transport, timeoutMs);
+    }
+
+    int FailoverTransport::WaitForData(int timeoutMs, size_t minBytes)
+    {
+        int ready = InnerWaitForData(*m_paths[m_active.load()].transport, timeoutMs, minBytes);
+        if (ready >= 0) return ready;
+
+        // The request went out on the dead path: the rest of this attempt
+        // listens on the new one, the retry is sent there
+        if (!FailActive()) return -1;
+        return InnerWaitForData(*m_paths[m_active.load()].transport, timeoutMs, minBytes);
+    }
+
+    int FailoverTransport::ReadNow(uint8_t* buffer, size_t size)
+    {
+        int n = InnerReadNow(*m_paths[m_active.load()].transport, buffer, size);
+        if (n >= 0) return n;
+        return FailActive() ? 0 : -1;
+    }
+
+    AdapterInfo FailoverTransport::GetAdapter() const
+    {
+        const Path& path = m_paths[m_active.load()];
+        return path.transport ? path.transport->GetAdapter() : m_adapter;
+    }
+
+    bool FailoverTransport::IsHotPluggable() const
+    {
+        for (const Path& path : m_paths)
+        {
+            if (path.transport && InnerIsHotPluggable(*path.transport)) return true;
+        }
+        return false;
+    }
+
+} // namespace FuelMaster
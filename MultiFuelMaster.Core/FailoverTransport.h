@@ -0,0 +1,164 @@
+// ============================================================
+// FailoverTransport.h — Primary and standby path to one post
+// ============================================================
+// Port name "failover:<primary>|<standby>", each part any name
+// Transport::Create accepts, e.g.
+//   failover:COM3|tcp://10.0.0.21:4001
+// Only the active path carries traffic. Each exchange rates it
+// (Transport::OnExchangeEnd): reply time, missing replies and
+// CRC errors feed moving averages that make up a 0..100 score.
+// The path is chosen again before every request, so a retry of
+// SendWithRetry already goes out on the other path and a glitch
+// costs one attempt, not the post. A device error on the active
+// path switches at once, in the middle of the exchange.
+// The controller only ever sees this transport: its FSM state,
+// command queue and counters are not touched by a switch.
+// An idle path is not probed (both paths reach the same post);
+// its error rates fade instead, so it is tried again later.
+// ============================================================
+#pragma once
+
+#include "Transport.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace FuelMaster {
+
+    // ============================================================
+    // Switching policy
+    // ============================================================
+    struct FailoverPolicy
+    {
+        double smoothing;           // weight of the newest exchange in the averages (0..1]
+        int goodReplyMs;            // reply time (end of TX to frame) still rated 100%
+        double switchBelowScore;    // active path is degraded under this score
+        double switchMargin;        // the other path must score this much higher
+        int idleHalfLifeMs;         // error rates of the idle path halve in this time
+
+        static FailoverPolicy Default()
+        {
+            return FailoverPolicy{
+                0.3,    // smoothing - two misses in a row fall below 50
+                80,     // goodReplyMs - 27-byte T reply at 9600 + turnaround
+                50.0,   // switchBelowScore
+                20.0,   // switchMargin
+                10000   // idleHalfLifeMs
+            };
+        }
+    };
+
+    struct FailoverPathStats
+    {
+        std::string portName;
+        bool open;
+        bool active;
+        bool failed;            // device error; reopened when switched to
+        double score;           // 0..100 (idle path: faded error rates)
+        double replyMs;         // average reply time
+        double missRate;        // average share of requests without a frame
+        double crcRate;         // average share of replies with CRC errors
+        uint64_t exchanges;
+        uint64_t misses;
+        uint64_t crcErrors;
+    };
+
+    class FailoverTransport : public Transport
+    {
+    public:
+        static constexpr int PRIMARY = 0;
+        static constexpr int STANDBY = 1;
+
+        /// Paths created from the port name at Open
+        FailoverTransport();
+
+        /// Caller-supplied paths (e.g. two PtyTransports in tests); opened
+        /// at Open with the names of the port name unless already open
+        FailoverTransport(std::unique_ptr<Transport> primary, std::unique_ptr<Transport> standby,
+            const FailoverPolicy& policy = FailoverPolicy::Default());
+        ~FailoverTransport() override;
+
+        /// True for "failover:..." port names
+        static bool IsFailoverPortName(const std::string& portName);
+
+        /// Opens both paths; succeeds if one of them opens (primary
+        /// preferred as the active path)
+        bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default()) override;
+        void Close() override;
+        bool IsOpen() const override;
+        bool Configure(const SerialSettings& settings) override;
+        void PurgeInput() override;
+
+        void SetPolicy(const FailoverPolicy& policy);
+        FailoverPolicy GetPolicy() const;
+
+        /// Adapter of the active path
+        AdapterInfo GetAdapter() const override;
+
+        int GetActivePath() const { return m_active.load(); }
+        FailoverPathStats GetPathStats(int path) const;
+        uint64_t GetSwitches() const { return m_switches.load(); }
+
+        /// One line: both paths' scores and the switches so far
+        std::string Report() const;
+
+    protected:
+        int Write(const uint8_t* data, size_t size) override;
+        bool DrainTx(int timeoutMs) override;
+        int WaitForData(int timeoutMs, size_t minBytes) override;
+        int ReadNow(uint8_t* buffer, size_t size) override;
+        bool IsHotPluggable() const override;
+        void OnExchangeEnd(bool answered, uint64_t crcErrors, int64_t replyUs) override;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Path
+        {
+            std::unique_ptr<Transport> transport;
+            std::string portName;
+            bool failed;
+            double replyMs;
+            double missRate;
+            double crcRate;
+            Clock::time_point idleSince;    // when it stopped being the active path
+            uint64_t exchanges;
+            uint64_t misses;
+            uint64_t crcErrors;
+        };
+
+        std::array<Path, 2> m_paths;
+        std::atomic<int> m_active;
+        std::atomic<uint64_t> m_switches;
+
+        mutable std::mutex m_mutex;     // policy, path ratings, m_lastSwitch (never held during I/O)
+        FailoverPolicy m_policy;
+        std::string m_lastSwitch;       // reason and target of the last switch
+
+        /// Neutral ratings for a freshly opened pair
+        static void ResetRatings(Path& path);
+
+        /// Error rates of an idle path after fading since idleSince
+        double FadedRate(const Path& path, double rate, Clock::time_point now) const;
+
+        /// 0..100 from reply time, miss and CRC rates
+        double Score(const Path& path, Clock::time_point now) const;
+
+        /// Before a request: switch if the active path failed or scores
+        /// clearly worse than the other. False if no path is usable.
+        bool SelectPath();
+
+        /// Make `path` active, opening it if needed. False if it cannot open.
+        bool SwitchTo(int path, const char* reason);
+
+        /// Device error on the active path: mark it, fall over to the
+        /// other one. False if that is not available either.
+        bool FailActive();
+    };
+
+} // namespace FuelMaster
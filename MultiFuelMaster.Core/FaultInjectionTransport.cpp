@@ -0,0 +1,386 @@
+// ============================================================
+// FaultInjectionTransport.cpp — Noisy line on demand
+// ============================================================
+
+#include "pch.h"
+#include "FaultInjectionTransport.h"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+namespace FuelMaster {
+
+    FaultInjectionTransport::FaultInjectionTransport(std::unique_ptr<Transport> inner,
+        const FaultProfile& profile)
+        : m_inner(std::move(inner))
+        , m_profile(profile)
+        , m_rng(profile.seed)
+        , m_mergeThis(false)
+        , m_duplicateThis(false)
+        , m_delayThisMs(0)
+        , m_exchanges(0)
+        , m_droppedBytes(0)
+        , m_flippedBytes(0)
+        , m_splits(0)
+        , m_merges(0)
+        , m_duplicates(0)
+        , m_delays(0)
+    {
+        if (m_inner) m_settings = m_inner->GetSettings();
+    }
+
+    FaultInjectionTransport::~FaultInjectionTransport()
+    {
+        Close();
+    }
+
+    // ============================================================
+    // OPEN / CLOSE — forwarded
+    // ============================================================
+
+    bool FaultInjectionTransport::Open(const std::string& portName, const SerialSettings& settings)
+    {
+        if (!m_inner)
+        {
+            m_lastError = "No inner transport";
+            return false;
+        }
+        if (!m_inner->IsOpen() && !m_inner->Open(portName, settings))
+        {
+            m_lastError = m_inner->GetLastError();
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_staged.clear();
+        m_held.clear();
+        m_portName = portName;
+        m_settings = m_inner->GetSettings();
+        m_lastError = "";
+        return true;
+    }
+
+    void FaultInjectionTransport::Close()
+    {
+        if (m_inner) m_inner->Close();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_staged.clear();
+        m_held.clear();
+    }
+
+    bool FaultInjectionTransport::IsOpen() const
+    {
+        return m_inner && m_inner->IsOpen();
+    }
+
+    bool FaultInjectionTransport::Configure(const SerialSettings& settings)
+    {
+        if (!m_inner || !m_inner->Configure(settings))
+        {
+            m_lastError = m_inner ? m_inner->GetLastError() : "No inner transport";
+            return false;
+        }
+        m_settings = m_inner->GetSettings();
+        return true;
+    }
+
+    void FaultInjectionTransport::PurgeInput()
+    {
+        if (!m_inner) return;
+        m_inner->PurgeInput();
+
+        // What has "arrived" is purged; delayed chunks are still in flight
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const Clock::time_point now = Clock::now();
+        while (!m_staged.empty() && m_staged.front().due <= now)
+            m_staged.pop_front();
+    }
+
+    // ============================================================
+    // PROFILE / STATISTICS
+    // ============================================================
+
+    void FaultInjectionTransport::SetProfile(const FaultProfile& profile)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_profile = profile;
+        m_rng.seed(profile.seed);
+    }
+
+    FaultProfile FaultInjectionTransport::GetProfile() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_profile;
+    }
+
+    FaultStats FaultInjectionTransport::GetFaultStats() const
+    {
+        FaultStats stats;
+        stats.exchanges = m_exchanges.load();
+        stats.droppedBytes = m_droppedBytes.load();
+        stats.flippedBytes = m_flippedBytes.load();
+        stats.splits = m_splits.load();
+        stats.merges = m_merges.load();
+        stats.duplicates = m_duplicates.load();
+        stats.delays = m_delays.load();
+        return stats;
+    }
+
+    void FaultInjectionTransport::ResetFaultStats()
+    {
+        m_exchanges.store(0);
+        m_droppedBytes.store(0);
+        m_flippedBytes.store(0);
+        m_splits.store(0);
+        m_merges.store(0);
+        m_duplicates.store(0);
+        m_delays.store(0);
+    }
+
+    std::string FaultInjectionTransport::Report(const LinkStats& link) const
+    {
+        const FaultStats f = GetFaultStats();
+        const double recoveringPct = link.elapsedSec > 0.0
+            ? 100.0 * static_cast<double>(link.recoveryUs) / 1e6 / link.elapsedSec : 0.0;
+
+        char line[512];
+        snprintf(line, sizeof(line),
+            "%s: %.1f updates/s, recovering %.1f%% (%llu episodes, avg %.1f ms, max %.1f ms), "
+            "failed attempts %llu | faults: drop %llu, flip %llu, split %llu, merge %llu, "
+            "dup %llu, delay %llu over %llu exchanges",
+            GetProfile().name, link.UpdateRate(), recoveringPct,
+            static_cast<unsigned long long>(link.recoveries),
+            link.recoveries ? static_cast<double>(link.recoveryUs) / 1000.0 / link.recoveries : 0.0,
+            static_cast<double>(link.maxRecoveryUs) / 1000.0,
+            static_cast<unsigned long long>(link.failedAttempts),
+            static_cast<unsigned long long>(f.droppedBytes),
+            static_cast<unsigned long long>(f.flippedBytes),
+            static_cast<unsigned long long>(f.splits),
+            static_cast<unsigned long long>(f.merges),
+            static_cast<unsigned long long>(f.duplicates),
+            static_cast<unsigned long long>(f.delays),
+            static_cast<unsigned long long>(f.exchanges));
+        return line;
+    }
+
+    // ============================================================
+    // SEEDED GENERATOR
+    // ============================================================
+
+    double FaultInjectionTransport::Uniform()
+    {
+        // 32 raw bits -> [0, 1)
+        return static_cast<double>(m_rng()) / 4294967296.0;
+    }
+
+    bool FaultInjectionTransport::Chance(double probability)
+    {
+        return probability > 0.0 && Uniform() < probability;
+    }
+
+    int FaultInjectionTransport::Range(int lo, int hi)
+    {
+        if (hi <= lo) return lo;
+        return lo + static_cast<int>(Uniform() * (hi - lo + 1));
+    }
+
+    // ============================================================
+    // TX — forwarded; draws the faults of the coming reply
+    // ============================================================
+
+    int FaultInjectionTransport::Write(const uint8_t* data, size_t size)
+    {
+        if (!m_inner) return 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_exchanges.fetch_add(1, std::memory_order_relaxed);
+
+            // A merged reply is released with the next one: never hold two
+            const bool holding = m_mergeThis;
+            m_mergeThis = !holding && Chance(m_profile.merge);
+            if (m_mergeThis) m_merges.fetch_add(1, std::memory_order_relaxed);
+
+            m_duplicateThis = Chance(m_profile.duplicate);
+            if (m_duplicateThis) m_duplicates.fetch_add(1, std::memory_order_relaxed);
+
+            m_delayThisMs = 0;
+            if (Chance(m_profile.delay))
+            {
+                m_delayThisMs = Range(m_profile.delayMinMs, m_profile.delayMaxMs);
+                m_delays.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return InnerWrite(*m_inner, data, size);
+    }
+
+    bool FaultInjectionTransport::DrainTx(int timeoutMs)
+    {
+        return m_inner ? InnerDrainTx(*m_inner, timeoutMs) : false;
+    }
+
+    // ============================================================
+    // RX — inner driver -> faults -> staged chunks
+    // ============================================================
+
+    int FaultInjectionTransport::Pump()
+    {
+        uint8_t chunk[256];
+        while (true)
+        {
+            int n = InnerReadNow(*m_inner, chunk, sizeof(chunk));
+            if (n < 0) return n;
+            if (n == 0) return 0;
+            Ingest(std::vector<uint8_t>(chunk, chunk + n));
+        }
+    }
+
+    void FaultInjectionTransport::Ingest(std::vector<uint8_t> bytes)
+    {
+        // Per byte: drop / flip
+        size_t out = 0;
+        for (size_t i = 0; i < bytes.size(); i++)
+        {
+            if (Chance(m_profile.byteDrop))
+            {
+                m_droppedBytes.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            uint8_t b = bytes[i];
+            if (Chance(m_profile.bitFlip))
+            {
+                b ^= static_cast<uint8_t>(1u << Range(0, 7));
+                m_flippedBytes.fetch_add(1, std::memory_order_relaxed);
+            }
+            bytes[out++] = b;
+        }
+        bytes.resize(out);
+        if (bytes.empty()) return;
+
+        // Per reply: merge - hold back until the next reply shows up
+        if (m_mergeThis)
+        {
+            m_held.insert(m_held.end(), bytes.begin(), bytes.end());
+            return;
+        }
+        if (!m_held.empty())
+        {
+            bytes.insert(bytes.begin(), m_held.begin(), m_held.end());
+            m_held.clear();
+        }
+
+        const Clock::time_point due = Clock::now() + std::chrono::milliseconds(m_delayThisMs);
+        Clock::time_point last = due;
+
+        // Per chunk: split with a gap
+        if (bytes.size() >= 2 && Chance(m_profile.split))
+        {
+            const size_t cut = static_cast<size_t>(Range(1, static_cast<int>(bytes.size()) - 1));
+            std::vector<uint8_t> tail(bytes.begin() + static_cast<std::ptrdiff_t>(cut), bytes.end());
+            bytes.resize(cut);
+            last = due + std::chrono::milliseconds(Range(0, m_profile.splitGapMaxMs));
+            m_splits.fetch_add(1, std::memory_order_relaxed);
+
+            if (m_duplicateThis)
+            {
+                std::vector<uint8_t> copy = bytes;
+                copy.insert(copy.end(), tail.begin(), tail.end());
+                Stage(last + std::chrono::milliseconds(1), std::move(copy));
+            }
+            Stage(due, std::move(bytes));
+            Stage(last, std::move(tail));
+            return;
+        }
+
+        // Per reply: duplicate - the same bytes again right after
+        if (m_duplicateThis)
+            Stage(last + std::chrono::milliseconds(1), bytes);
+        Stage(due, std::move(bytes));
+    }
+
+    void FaultInjectionTransport::Stage(Clock::time_point due, std::vector<uint8_t> bytes)
+    {
+        // Keep m_staged sorted; equal times keep arrival order
+        auto it = m_staged.end();
+        while (it != m_staged.begin() && std::prev(it)->due > due)
+            --it;
+        m_staged.insert(it, Chunk{ due, std::move(bytes), 0 });
+    }
+
+    size_t FaultInjectionTransport::BytesArrived(Clock::time_point now) const
+    {
+        size_t bytes = 0;
+        for (const Chunk& c : m_staged)
+        {
+            if (c.due > now) break;
+            bytes += c.bytes.size() - c.offset;
+        }
+        return bytes;
+    }
+
+    int FaultInjectionTransport::WaitForData(int timeoutMs, size_t minBytes)
+    {
+        if (!m_inner) return -1;
+
+        const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true)
+        {
+            Clock::time_point wake = deadline;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (Pump() < 0)
+                {
+                    m_lastError = m_inner->GetLastError();
+                    return -1;
+                }
+
+                const Clock::time_point now = Clock::now();
+                if (BytesArrived(now) >= minBytes) return 1;
+                if (now >= deadline) return 0;
+
+                // Wake for the next staged chunk, or new driver data
+                for (const Chunk& c : m_staged)
+                {
+                    if (c.due > now)
+                    {
+                        if (c.due < wake) wake = c.due;
+                        break;
+                    }
+                }
+            }
+
+            const auto waitMs = std::chrono::ceil<std::chrono::milliseconds>(wake - Clock::now()).count();
+            if (waitMs > 0 && InnerWaitForData(*m_inner, static_cast<int>(waitMs), 1) < 0)
+            {
+                m_lastError = m_inner->GetLastError();
+                return -1;
+            }
+        }
+    }
+
+    int FaultInjectionTransport::ReadNow(uint8_t* buffer, size_t size)
+    {
+        if (!m_inner) return -1;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (Pump() < 0)
+        {
+            m_lastError = m_inner->GetLastError();
+            return -1;
+        }
+
+        const Clock::time_point now = Clock::now();
+        size_t copied = 0;
+        while (copied < size && !m_staged.empty() && m_staged.front().due <= now)
+        {
+            Chunk& c = m_staged.front();
+            const size_t n = (std::min)(size - copied, c.bytes.size() - c.offset);
+            std::copy_n(c.bytes.begin() + static_cast<std::ptrdiff_t>(c.offset), n, buffer + copied);
+            copied += n;
+            c.offset += n;
+            if (c.offset == c.bytes.size())
+                m_staged.pop_front();
+        }
+        return static_cast<int>(copied);
+    }
+
+} // namespace FuelMaster
@@ -0,0 +1,195 @@
+// ============================================================
+// FaultInjectionTransport.h — Noisy line on demand
+// ============================================================
+// Wraps another Transport and corrupts what it receives,
+// driven by a seeded generator: the same profile and seed
+// give the same fault sequence on every run and platform.
+// Per received byte: drop, bit flip. Per received chunk:
+// split in two with a random gap. Per reply (everything
+// received between two Writes): merge with the next reply,
+// duplicate, deliver late. Used with a simulator or a replay
+// to tune retries/backoff/resync against DispenserController
+// LinkStats (update rate, time spent recovering).
+// ============================================================
+#pragma once
+
+#include "LinkStats.h"
+#include "Transport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace FuelMaster {
+
+    // ============================================================
+    // Fault rates (probabilities 0..1)
+    // ============================================================
+    struct FaultProfile
+    {
+        const char* name;
+        double byteDrop;        // per received byte: lost
+        double bitFlip;         // per received byte: one bit inverted
+        double split;           // per received chunk: delivered in two parts
+        int splitGapMaxMs;      // gap between the parts, 0..max
+        double merge;           // per reply: held back, arrives with the next reply
+        double duplicate;       // per reply: arrives twice
+        double delay;           // per reply: arrives late
+        int delayMinMs;
+        int delayMaxMs;
+        uint32_t seed;
+
+        static FaultProfile Default()
+        {
+            return FaultProfile{
+                "clean",
+                0.0, 0.0,       // byteDrop, bitFlip
+                0.0, 0,         // split, splitGapMaxMs
+                0.0, 0.0,       // merge, duplicate
+                0.0, 0, 0,      // delay, delayMinMs, delayMaxMs
+                1               // seed
+            };
+        }
+
+        /// EMI on a long RS-485 run: lost and corrupted bytes
+        static FaultProfile NoisyLine()
+        {
+            FaultProfile p = Default();
+            p.name = "noisy-line";
+            p.byteDrop = 0.002;
+            p.bitFlip = 0.002;
+            return p;
+        }
+
+        /// USB-UART delivering replies in pieces
+        static FaultProfile FragmentingAdapter()
+        {
+            FaultProfile p = Default();
+            p.name = "fragmenting-adapter";
+            p.split = 0.5;
+            p.splitGapMaxMs = 20;
+            return p;
+        }
+
+        /// Dispenser answering after the timeout now and then
+        static FaultProfile SlowDispenser()
+        {
+            FaultProfile p = Default();
+            p.name = "slow-dispenser";
+            p.delay = 0.1;
+            p.delayMinMs = 60;
+            p.delayMaxMs = 250;
+            return p;
+        }
+
+        /// Replies arriving merged or twice
+        static FaultProfile Chatter()
+        {
+            FaultProfile p = Default();
+            p.name = "chatter";
+            p.merge = 0.05;
+            p.duplicate = 0.05;
+            return p;
+        }
+    };
+
+    struct FaultStats
+    {
+        uint64_t exchanges;     // Writes seen
+        uint64_t droppedBytes;
+        uint64_t flippedBytes;
+        uint64_t splits;
+        uint64_t merges;
+        uint64_t duplicates;
+        uint64_t delays;
+    };
+
+    class FaultInjectionTransport : public Transport
+    {
+    public:
+        FaultInjectionTransport(std::unique_ptr<Transport> inner,
+            const FaultProfile& profile = FaultProfile::Default());
+        ~FaultInjectionTransport() override;
+
+        bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default()) override;
+        void Close() override;
+        bool IsOpen() const override;
+        bool Configure(const SerialSettings& settings) override;
+        void PurgeInput() override;
+
+        /// New profile; restarts the generator from its seed.
+        /// Safe while the controller is polling.
+        void SetProfile(const FaultProfile& profile);
+        FaultProfile GetProfile() const;
+
+        FaultStats GetFaultStats() const;
+        void ResetFaultStats();
+
+        /// One line: profile, faults injected, update rate and recovery time
+        std::string Report(const LinkStats& link) const;
+
+        Transport* GetInner() const { return m_inner.get(); }
+
+        AdapterInfo GetAdapter() const override { return m_inner ? m_inner->GetAdapter() : m_adapter; }
+
+    protected:
+        int Write(const uint8_t* data, size_t size) override;
+        bool DrainTx(int timeoutMs) override;
+        int WaitForData(int timeoutMs, size_t minBytes) override;
+        int ReadNow(uint8_t* buffer, size_t size) override;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Chunk
+        {
+            Clock::time_point due;      // when it reaches the reader
+            std::vector<uint8_t> bytes;
+            size_t offset;              // bytes already read
+        };
+
+        std::unique_ptr<Transport> m_inner;
+
+        mutable std::mutex m_mutex;     // profile, generator, staged data (never held while waiting)
+        FaultProfile m_profile;
+        std::mt19937 m_rng;
+
+        std::deque<Chunk> m_staged;     // sorted by due
+        std::vector<uint8_t> m_held;    // reply held back for merging
+
+        // Faults drawn for the current reply (at Write)
+        bool m_mergeThis;
+        bool m_duplicateThis;
+        int m_delayThisMs;
+
+        std::atomic<uint64_t> m_exchanges;
+        std::atomic<uint64_t> m_droppedBytes;
+        std::atomic<uint64_t> m_flippedBytes;
+        std::atomic<uint64_t> m_splits;
+        std::atomic<uint64_t> m_merges;
+        std::atomic<uint64_t> m_duplicates;
+        std::atomic<uint64_t> m_delays;
+
+        /// Uniform [0, 1) from the raw generator output (the same on
+        /// every standard library, unlike std::*_distribution)
+        double Uniform();
+        bool Chance(double probability);
+        int Range(int lo, int hi);
+
+        /// Move what the inner driver holds into m_staged, faults applied.
+        /// Returns <0 on device error.
+        int Pump();
+        void Ingest(std::vector<uint8_t> bytes);
+        void Stage(Clock::time_point due, std::vector<uint8_t> bytes);
+
+        /// Bytes of staged chunks due at `now`
+        size_t BytesArrived(Clock::time_point now) const;
+    };
+
+} // namespace FuelMaster
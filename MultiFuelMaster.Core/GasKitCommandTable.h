@@ -0,0 +1,130 @@
+// ============================================================
+// GasKitCommandTable.h — Precomputed parameterless command frames
+// ============================================================
+// S, L, R, T, N, B, G and C0 carry no variable data, so for a
+// given slave address they are byte-identical on every call.
+// All of them are built at compile time for addresses 1..32
+// (the range DispenserController::ParseAddress clamps to).
+// ============================================================
+
+#pragma once
+
+#include "GasKitFrame.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace FuelMaster {
+namespace Protocol {
+
+    /// Parameterless commands available in the table
+    enum class FixedCommand : uint8_t
+    {
+        Status,          // S
+        Volume,          // L
+        Money,           // R
+        Transaction,     // T
+        EndTransaction,  // N
+        Stop,            // B
+        Resume,          // G
+        TotalCounter0,   // C0
+        Count
+    };
+
+    constexpr uint8_t MIN_TABLE_ADDRESS = 1;
+    constexpr uint8_t MAX_TABLE_ADDRESS = 32;
+
+    namespace Detail {
+
+        constexpr size_t FIXED_COMMAND_COUNT = static_cast<size_t>(FixedCommand::Count);
+        constexpr size_t TABLE_ADDRESS_COUNT = MAX_TABLE_ADDRESS - MIN_TABLE_ADDRESS + 1;
+
+        using FixedFrameTable = std::array<std::array<Frame, FIXED_COMMAND_COUNT>, TABLE_ADDRESS_COUNT>;
+
+        /// XOR over data[from..to] (section 6.x CRC rule)
+        constexpr uint8_t XorCrc(const Frame& frame, size_t from, size_t to)
+        {
+            uint8_t crc = 0;
+            for (size_t i = from; i <= to && i < frame.size(); i++)
+                crc ^= frame[i];
+            return crc;
+        }
+
+        constexpr Frame MakeFixedFrame(uint8_t addrLo, FixedCommand cmd)
+        {
+            constexpr char letters[FIXED_COMMAND_COUNT] = { 'S', 'L', 'R', 'T', 'N', 'B', 'G', 'C' };
+
+            Frame frame;
+            frame.PushBack(STX);
+            frame.PushBack(0x00);
+            frame.PushBack(addrLo);
+            frame.PushBack(static_cast<uint8_t>(letters[static_cast<size_t>(cmd)]));
+            if (cmd == FixedCommand::TotalCounter0)
+                frame.PushBack(static_cast<uint8_t>('0'));
+            frame.PushBack(XorCrc(frame, 1, frame.size() - 1));
+            return frame;
+        }
+
+        constexpr FixedFrameTable MakeFixedFrameTable()
+        {
+            FixedFrameTable table{};
+            for (size_t a = 0; a < TABLE_ADDRESS_COUNT; a++)
+                for (size_t c = 0; c < FIXED_COMMAND_COUNT; c++)
+                    table[a][c] = MakeFixedFrame(static_cast<uint8_t>(a + MIN_TABLE_ADDRESS),
+                                                 static_cast<FixedCommand>(c));
+            return table;
+        }
+
+        inline constexpr FixedFrameTable FIXED_FRAMES = MakeFixedFrameTable();
+
+        /// Every entry: STX, binary address {0x00, addr}, CRC = XOR(addr..payload)
+        constexpr bool FixedFramesObeyCrcRule()
+        {
+            for (size_t a = 0; a < TABLE_ADDRESS_COUNT; a++)
+            {
+                for (size_t c = 0; c < FIXED_COMMAND_COUNT; c++)
+                {
+                    const Frame& f = FIXED_FRAMES[a][c];
+                    if (f.size() < 5) return false;
+                    if (f[0] != STX) return false;
+                    if (f[1] != 0x00 || f[2] != a + MIN_TABLE_ADDRESS) return false;
+                    if (f[f.size() - 1] != XorCrc(f, 1, f.size() - 2)) return false;
+                }
+            }
+            return true;
+        }
+
+        constexpr bool FrameEquals(const Frame& f, std::array<uint8_t, 6> bytes, size_t size)
+        {
+            return f == Frame(bytes.data(), size);
+        }
+
+    } // namespace Detail
+
+    /// True if {addrHi, addrLo} has precomputed frames
+    constexpr bool HasFixedFrames(uint8_t addrHi, uint8_t addrLo)
+    {
+        return addrHi == 0x00 && addrLo >= MIN_TABLE_ADDRESS && addrLo <= MAX_TABLE_ADDRESS;
+    }
+
+    /// Ready-made frame for address addrLo (1..32, clamped).
+    /// Returns a reference into the read-only table — no copy, no lock.
+    constexpr const Frame& GetFixedFrame(uint8_t addrLo, FixedCommand cmd)
+    {
+        if (addrLo < MIN_TABLE_ADDRESS) addrLo = MIN_TABLE_ADDRESS;
+        if (addrLo > MAX_TABLE_ADDRESS) addrLo = MAX_TABLE_ADDRESS;
+        return Detail::FIXED_FRAMES[addrLo - MIN_TABLE_ADDRESS][static_cast<size_t>(cmd)];
+    }
+
+    static_assert(Detail::FixedFramesObeyCrcRule(), "Precomputed frame violates GasKit CRC rule");
+
+    // Reference frames for dispenser #1 (CRC = 0x00 ^ 0x01 ^ payload)
+    static_assert(Detail::FrameEquals(GetFixedFrame(1, FixedCommand::Status), { 0x02, 0x00, 0x01, 0x53, 0x52 }, 5),
+                  "S frame for address 1");
+    static_assert(Detail::FrameEquals(GetFixedFrame(1, FixedCommand::Volume), { 0x02, 0x00, 0x01, 0x4C, 0x4D }, 5),
+                  "L frame for address 1");
+    static_assert(Detail::FrameEquals(GetFixedFrame(1, FixedCommand::TotalCounter0), { 0x02, 0x00, 0x01, 0x43, 0x30, 0x72 }, 6),
+                  "C0 frame for address 1");
+
+} // namespace Protocol
+} // namespace FuelMaster
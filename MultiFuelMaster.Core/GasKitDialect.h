@@ -0,0 +1,96 @@
+// ============================================================
+// GasKitDialect.h — Protocol dialect traits
+// ============================================================
+// Field widths and address layout differ between dispenser
+// firmwares. Each variant is a traits struct; the codec is
+// templated on it, so every dialect gets its own compile-time
+// specialization (constant offsets, inlined digit kernels,
+// no virtual dispatch).
+// ============================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace FuelMaster {
+namespace Protocol {
+
+    /// Standard GasKit: 6-digit volume/money, 4-digit price, 9-digit totals
+    struct GasKitStandardDialect
+    {
+        static constexpr const char* Name = "GasKit";
+        static constexpr size_t AddressBytes = 2;  // binary {hi, lo}
+        static constexpr size_t VolumeDigits = 6;
+        static constexpr size_t MoneyDigits = 6;
+        static constexpr size_t PriceDigits = 4;
+        static constexpr size_t TotalDigits = 9;
+    };
+
+    /// GasKitLink firmware with wide volume/money/price fields
+    struct GasKitWideDialect
+    {
+        static constexpr const char* Name = "GasKitLink-Wide";
+        static constexpr size_t AddressBytes = 2;
+        static constexpr size_t VolumeDigits = 8;
+        static constexpr size_t MoneyDigits = 8;
+        static constexpr size_t PriceDigits = 6;
+        static constexpr size_t TotalDigits = 9;
+    };
+
+    /// Runtime selector (per post, chosen at connect time)
+    enum class Dialect : int
+    {
+        Standard = 0,
+        Wide = 1
+    };
+
+    // ============================================================
+    // Frame layout derived from the traits
+    // [STX][addr...][payload...][CRC]
+    // ============================================================
+
+    template <typename D>
+    struct DialectLayout
+    {
+        static constexpr size_t PayloadOffset = 1 + D::AddressBytes;
+        static constexpr size_t Overhead = PayloadOffset + 1;  // + CRC
+
+        // Payload lengths
+        static constexpr size_t StatusPayload = 3;                           // Ssg
+        static constexpr size_t VolumePayload = 5 + D::VolumeDigits;         // Lgis;v..
+        static constexpr size_t MoneyPayload = 5 + D::MoneyDigits;           // Rgis;m..
+        static constexpr size_t TransactionPayload =
+            5 + D::MoneyDigits + 1 + D::VolumeDigits + 1 + D::PriceDigits;   // Tgis;m..;v..;p..
+        static constexpr size_t TotalPayload = 3 + D::TotalDigits;           // Cg;t..
+        static constexpr size_t PresetPayload =
+            3 + (D::VolumeDigits > D::MoneyDigits ? D::VolumeDigits : D::MoneyDigits) +
+            1 + D::PriceDigits;                                              // Vg;v..;p.. / Mg;m..;p..
+
+        /// Full response frame length by command letter (0 = not a response)
+        static constexpr size_t ResponseFrameLength(char cmd)
+        {
+            switch (cmd)
+            {
+            case 'S': return Overhead + StatusPayload;
+            case 'L': return Overhead + VolumePayload;
+            case 'R': return Overhead + MoneyPayload;
+            case 'T': return Overhead + TransactionPayload;
+            case 'C': return Overhead + TotalPayload;
+            default:  return 0;
+            }
+        }
+
+        /// Longest frame of the dialect (section 6.5 for the standard one)
+        static constexpr size_t MaxFrameSize = Overhead + TransactionPayload;
+    };
+
+    static_assert(DialectLayout<GasKitStandardDialect>::MaxFrameSize == 27,
+                  "Standard GasKit frames are at most 27 bytes (section 6.5)");
+    static_assert(DialectLayout<GasKitStandardDialect>::ResponseFrameLength('S') == 7 &&
+                  DialectLayout<GasKitStandardDialect>::ResponseFrameLength('L') == 15 &&
+                  DialectLayout<GasKitStandardDialect>::ResponseFrameLength('C') == 16,
+                  "Standard GasKit response lengths");
+
+} // namespace Protocol
+} // namespace FuelMaster
@@ -0,0 +1,105 @@
+// ============================================================
+// GasKitFrame.h — Fixed-capacity frame (no heap allocation)
+// ============================================================
+// Every GasKitLink frame fits into MAX_FRAME_SIZE bytes
+// (section 6.5), wide-field dialects into MAX_FRAME_CAPACITY,
+// so frames live on the stack / inside the owning object
+// instead of a std::vector.
+// ============================================================
+
+#pragma once
+
+#include "GasKitDialect.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace FuelMaster {
+namespace Protocol {
+
+    constexpr uint8_t STX = 0x02;
+
+    /// Maximum frame size per protocol (section 6.5)
+    /// STX(1) + CH(1) + ID(1) + CMD(1) + DATA(22) + CRC(1)
+    constexpr size_t MAX_FRAME_SIZE = DialectLayout<GasKitStandardDialect>::MaxFrameSize;
+
+    /// Storage capacity of a Frame: longest frame of any supported dialect
+    constexpr size_t MAX_FRAME_CAPACITY = (std::max)(
+        DialectLayout<GasKitStandardDialect>::MaxFrameSize,
+        DialectLayout<GasKitWideDialect>::MaxFrameSize);
+
+    // ============================================================
+    // Frame — stack-resident byte buffer capped at MAX_FRAME_CAPACITY
+    // ============================================================
+
+    class Frame
+    {
+    public:
+        constexpr Frame() = default;
+
+        constexpr Frame(const uint8_t* data, size_t size)
+        {
+            Assign(data, size);
+        }
+
+        /// Copy bytes into the frame. Returns false (and leaves the
+        /// frame empty) if size exceeds MAX_FRAME_CAPACITY.
+        constexpr bool Assign(const uint8_t* data, size_t size)
+        {
+            m_size = 0;
+            if (size > MAX_FRAME_CAPACITY) return false;
+            for (size_t i = 0; i < size; i++)
+                m_data[i] = data[i];
+            m_size = static_cast<uint8_t>(size);
+            return true;
+        }
+
+        /// Append one byte. Returns false if the frame is full.
+        constexpr bool PushBack(uint8_t byte)
+        {
+            if (m_size >= MAX_FRAME_CAPACITY) return false;
+            m_data[m_size++] = byte;
+            return true;
+        }
+
+        constexpr void Clear() { m_size = 0; }
+
+        /// Remove the first `count` bytes, shifting the rest to the front
+        constexpr void Erase(size_t count)
+        {
+            if (count >= m_size) { m_size = 0; return; }
+            for (size_t i = count; i < m_size; i++)
+                m_data[i - count] = m_data[i];
+            m_size = static_cast<uint8_t>(m_size - count);
+        }
+
+        constexpr const uint8_t* data() const { return m_data.data(); }
+        constexpr uint8_t* data() { return m_data.data(); }
+        constexpr size_t size() const { return m_size; }
+        constexpr bool empty() const { return m_size == 0; }
+        static constexpr size_t capacity() { return MAX_FRAME_CAPACITY; }
+
+        constexpr const uint8_t* begin() const { return m_data.data(); }
+        constexpr const uint8_t* end() const { return m_data.data() + m_size; }
+        constexpr uint8_t* begin() { return m_data.data(); }
+        constexpr uint8_t* end() { return m_data.data() + m_size; }
+
+        constexpr uint8_t operator[](size_t i) const { return m_data[i]; }
+        constexpr uint8_t& operator[](size_t i) { return m_data[i]; }
+
+        constexpr bool operator==(const Frame& other) const
+        {
+            if (m_size != other.m_size) return false;
+            for (size_t i = 0; i < m_size; i++)
+                if (m_data[i] != other.m_data[i]) return false;
+            return true;
+        }
+
+    private:
+        std::array<uint8_t, MAX_FRAME_CAPACITY> m_data{};
+        uint8_t m_size = 0;
+    };
+
+} // namespace Protocol
+} // namespace FuelMaster
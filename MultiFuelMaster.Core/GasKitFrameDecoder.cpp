@@ -0,0 +1,235 @@
+// ============================================================
+// GasKitFrameDecoder.cpp — Streaming frame decoder
+// ============================================================
+
+#include "GasKitFrameDecoder.h"
+#include <algorithm>
+
+namespace FuelMaster {
+namespace Protocol {
+
+    FrameDecoder::FrameDecoder()
+        : m_hasFrame(false)
+        , m_checked(0)
+        , m_expectedLen(0)
+        , m_crc(0)
+        , m_innerStx(0)
+        , m_filterAddress(false)
+        , m_addrHi(0)
+        , m_addrLo(0)
+        , m_expectedCmd(0)
+        , m_lengthS(0)
+        , m_lengthL(0)
+        , m_lengthR(0)
+        , m_lengthT(0)
+        , m_lengthC(0)
+        , m_framesDecoded(0)
+        , m_crcErrors(0)
+        , m_bytesDiscarded(0)
+    {
+        SetDialect<GasKitStandardDialect>();
+    }
+
+    void FrameDecoder::SetAddressFilter(uint8_t addrHi, uint8_t addrLo)
+    {
+        m_filterAddress = true;
+        m_addrHi = addrHi;
+        m_addrLo = addrLo;
+    }
+
+    void FrameDecoder::ClearAddressFilter()
+    {
+        m_filterAddress = false;
+    }
+
+    void FrameDecoder::Reset()
+    {
+        m_buf.Clear();
+        m_hasFrame = false;
+        m_checked = 0;
+        m_expectedLen = 0;
+        m_crc = 0;
+        m_innerStx = 0;
+    }
+
+    bool FrameDecoder::Push(uint8_t byte)
+    {
+        // Candidate can never exceed MAX_FRAME_CAPACITY; if it somehow does,
+        // give up on it before appending
+        if (m_buf.size() == Frame::capacity())
+            DropCandidate();
+
+        // Nothing can start before STX — skip noise without buffering it
+        if (m_buf.empty() && byte != STX)
+        {
+            m_bytesDiscarded++;
+            return false;
+        }
+
+        m_buf.PushBack(byte);
+        return Advance();
+    }
+
+    bool FrameDecoder::Drain()
+    {
+        return Advance();
+    }
+
+    size_t FrameDecoder::BytesNeeded() const
+    {
+        // A frame starting at the next byte (or at an STX already inside
+        // the candidate) may complete before the candidate does: the
+        // candidate's header can be noise
+        const size_t shortest = (std::min)({ m_lengthS, m_lengthL, m_lengthR, m_lengthT, m_lengthC });
+        const size_t buffered = m_buf.size();
+
+        size_t needed = shortest;
+        if (m_expectedLen > buffered)
+            needed = (std::min)(needed, m_expectedLen - buffered);
+        if (m_innerStx != 0 && shortest > buffered - m_innerStx)
+            needed = (std::min)(needed, shortest - (buffered - m_innerStx));
+        return needed;
+    }
+
+    // ============================================================
+    // Validate buffered bytes from m_checked onward.
+    // Each byte is checked once per candidate start; a failed
+    // candidate only rescans the bytes after its STX.
+    // ============================================================
+
+    bool FrameDecoder::Advance()
+    {
+        while (m_checked < m_buf.size())
+        {
+            const size_t i = m_checked;
+            const uint8_t b = m_buf[i];
+            bool ok = true;
+
+            switch (i)
+            {
+            case 0:
+                ok = (b == STX);
+                break;
+            case 1:
+                ok = !m_filterAddress || b == m_addrHi;
+                break;
+            case 2:
+                ok = !m_filterAddress || b == m_addrLo;
+                break;
+            case 3:
+                m_expectedLen = ResponseFrameLength(static_cast<char>(b));
+                ok = m_expectedLen != 0 &&
+                     (m_expectedCmd == 0 || static_cast<char>(b) == m_expectedCmd);
+                break;
+            default:
+                break;
+            }
+
+            if (!ok)
+            {
+                DropCandidate();
+                continue;
+            }
+
+            // CRC covers addrHi .. last payload byte
+            if (i >= 1 && (m_expectedLen == 0 || i + 1 < m_expectedLen))
+                m_crc ^= b;
+            // Address bytes are binary and may equal STX (post 2):
+            // an inner frame can only start after the header
+            if (i >= 3 && b == STX && m_innerStx == 0)
+                m_innerStx = i;
+
+            m_checked++;
+
+            if (m_expectedLen != 0 && m_checked == m_expectedLen)
+            {
+                if (b != m_crc)
+                {
+                    m_crcErrors++;
+                    DropCandidate();
+                    continue;
+                }
+
+                // Complete frame — emit it, keep any bytes that follow
+                m_frame.Assign(m_buf.data(), m_expectedLen);
+                m_hasFrame = true;
+                m_framesDecoded++;
+
+                m_buf.Erase(m_expectedLen);
+
+                m_checked = 0;
+                m_expectedLen = 0;
+                m_crc = 0;
+                m_innerStx = 0;
+                return true;
+            }
+
+            if (m_innerStx != 0 && EmitInnerFrame(m_checked))
+                return true;
+        }
+        return false;
+    }
+
+    // ============================================================
+    // Inner frame: the candidate's header may be noise that merely
+    // looks like one (STX 00 01 'T' holds out for 27 bytes). If
+    // the bytes up to `end` close a valid frame that starts at a
+    // later STX, that frame is the real one: emit it and drop the
+    // candidate before it, instead of swallowing a short reply
+    // until the long candidate fails.
+    // ============================================================
+
+    bool FrameDecoder::EmitInnerFrame(size_t end)
+    {
+        for (size_t start = m_innerStx; start + 3 < end; start++)
+        {
+            if (m_buf[start] != STX) continue;
+
+            const char cmd = static_cast<char>(m_buf[start + 3]);
+            if (ResponseFrameLength(cmd) != end - start) continue;
+            if (m_filterAddress && (m_buf[start + 1] != m_addrHi || m_buf[start + 2] != m_addrLo)) continue;
+            if (m_expectedCmd != 0 && cmd != m_expectedCmd) continue;
+
+            uint8_t crc = 0;
+            for (size_t i = start + 1; i + 1 < end; i++)
+                crc ^= m_buf[i];
+            if (crc != m_buf[end - 1]) continue;
+
+            m_frame.Assign(m_buf.data() + start, end - start);
+            m_hasFrame = true;
+            m_framesDecoded++;
+
+            m_bytesDiscarded += start;
+            m_buf.Erase(end);
+
+            m_checked = 0;
+            m_expectedLen = 0;
+            m_crc = 0;
+            m_innerStx = 0;
+            return true;
+        }
+        return false;
+    }
+
+    // ============================================================
+    // Resync: drop the current STX and restart from the next STX
+    // already buffered (bytes before it are discarded)
+    // ============================================================
+
+    void FrameDecoder::DropCandidate()
+    {
+        size_t next = 1;
+        while (next < m_buf.size() && m_buf[next] != STX)
+            next++;
+
+        m_bytesDiscarded += next;
+        m_buf.Erase(next);
+
+        m_checked = 0;
+        m_expectedLen = 0;
+        m_crc = 0;
+        m_innerStx = 0;
+    }
+
+} // namespace Protocol
+} // namespace FuelMaster
@@ -0,0 +1,147 @@
+// ============================================================
+// GasKitFrameDecoder.h — Streaming (push) frame decoder
+// ============================================================
+// Consumes bytes as they arrive and emits complete frames in
+// one linear pass:
+//   STX -> addrHi -> addrLo -> CMD -> data... -> CRC
+// Response length is fixed per command letter and dialect
+// (GasKitDialect.h), CRC (XOR) is accumulated on the fly.
+// On any mismatch the decoder drops
+// the current STX and resynchronises on the next STX already
+// buffered (section 6.4), so a frame hidden behind garbage
+// is still found without re-reading the line. A frame that
+// completes at an STX inside a pending candidate wins over the
+// candidate, whose header may have been noise.
+// No heap allocation, no locks.
+// ============================================================
+
+#pragma once
+
+#include "GasKitDialect.h"
+#include "GasKitFrame.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace FuelMaster {
+namespace Protocol {
+
+    class FrameDecoder
+    {
+    public:
+        FrameDecoder();
+
+        /// Take response lengths from the dialect traits
+        /// (GasKitStandardDialect until called)
+        template <typename Dialect>
+        void SetDialect()
+        {
+            using Layout = DialectLayout<Dialect>;
+            m_lengthS = static_cast<uint8_t>(Layout::ResponseFrameLength('S'));
+            m_lengthL = static_cast<uint8_t>(Layout::ResponseFrameLength('L'));
+            m_lengthR = static_cast<uint8_t>(Layout::ResponseFrameLength('R'));
+            m_lengthT = static_cast<uint8_t>(Layout::ResponseFrameLength('T'));
+            m_lengthC = static_cast<uint8_t>(Layout::ResponseFrameLength('C'));
+        }
+
+        /// Full frame length of a response by its command letter
+        /// (0 = not a response command)
+        size_t ResponseFrameLength(char cmd) const
+        {
+            switch (cmd)
+            {
+            case 'S': return m_lengthS;  // Ssg
+            case 'L': return m_lengthL;  // Lgis;llllll
+            case 'R': return m_lengthR;  // Rgis;rrrrrr
+            case 'T': return m_lengthT;  // Tgis;mmmmmm;llllll;pppp
+            case 'C': return m_lengthC;  // Cg;ttttttttt
+            default:  return 0;
+            }
+        }
+
+        // --- Filters (applied while decoding) ---
+        void SetAddressFilter(uint8_t addrHi, uint8_t addrLo);
+        void ClearAddressFilter();
+
+        /// Accept only this response command (0 = any response command)
+        void SetExpectedCommand(char cmd) { m_expectedCmd = cmd; }
+
+        /// Drop buffered bytes and decoding state (statistics are kept)
+        void Reset();
+
+        /// Push one byte. Returns true when a complete, CRC-valid frame
+        /// is available through GetFrame().
+        bool Push(uint8_t byte);
+
+        /// Continue decoding bytes still buffered after a frame was
+        /// emitted. Returns true if another frame completed.
+        bool Drain();
+
+        /// Push a chunk and call onFrame(const Frame&) for every frame
+        template <typename OnFrame>
+        void Feed(std::span<const uint8_t> bytes, OnFrame&& onFrame)
+        {
+            for (uint8_t b : bytes)
+            {
+                if (!Push(b)) continue;
+                do { onFrame(m_frame); } while (Drain());
+            }
+        }
+
+        /// Last completed frame
+        const Frame& GetFrame() const { return m_frame; }
+
+        /// True once a frame has been emitted since the last Reset()
+        /// or ConsumeFrame()
+        bool HasFrame() const { return m_hasFrame; }
+
+        /// Mark the current frame as handled (buffered bytes are kept)
+        void ConsumeFrame() { m_hasFrame = false; }
+
+        /// True if bytes of an incomplete frame are buffered
+        bool HasPartialFrame() const { return !m_buf.empty(); }
+
+        /// Lower bound of the bytes still needed before a frame can
+        /// complete: the remainder of the candidate, capped by the
+        /// shortest response frame (one may start behind a candidate
+        /// that turns out to be noise); always >= 1.
+        /// Lets the reader sleep until that many bytes are on hand.
+        size_t BytesNeeded() const;
+
+        // --- Statistics ---
+        uint64_t GetFramesDecoded() const { return m_framesDecoded; }
+        uint64_t GetCrcErrors() const { return m_crcErrors; }
+        uint64_t GetBytesDiscarded() const { return m_bytesDiscarded; }
+
+    private:
+        Frame m_buf;            // candidate frame, always starts with STX
+        Frame m_frame;          // last completed frame
+        bool m_hasFrame;        // m_frame emitted and not yet consumed
+        size_t m_checked;       // bytes of m_buf already validated
+        size_t m_expectedLen;   // full length once CMD is known, else 0
+        uint8_t m_crc;          // running XOR over m_buf[1..m_checked-1]
+        size_t m_innerStx;      // first STX after the header (0 = none)
+
+        bool m_filterAddress;
+        uint8_t m_addrHi;
+        uint8_t m_addrLo;
+        char m_expectedCmd;
+
+        // Response frame lengths of the current dialect
+        uint8_t m_lengthS;
+        uint8_t m_lengthL;
+        uint8_t m_lengthR;
+        uint8_t m_lengthT;
+        uint8_t m_lengthC;
+
+        uint64_t m_framesDecoded;
+        uint64_t m_crcErrors;
+        uint64_t m_bytesDiscarded;
+
+        bool Advance();
+        bool EmitInnerFrame(size_t end);
+        void DropCandidate();
+    };
+
+} // namespace Protocol
+} // namespace FuelMaster
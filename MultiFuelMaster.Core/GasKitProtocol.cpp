@@ -1,11 +1,14 @@
 // ============================================================
 // GasKitProtocol.cpp — Implementation (FIXED: binary address)
 // ============================================================
+// Member definitions are templates over the dialect traits;
+// the supported dialects are instantiated at the end of the file.
+// ============================================================
 
-#include "pch.h"
 #include "GasKitProtocol.h"
-#include <sstream>
-#include <iomanip>
+#include "GasKitCommandTable.h"
+#include "GasKitSwar.h"
+#include <charconv>
 
 namespace FuelMaster {
 namespace Protocol {
@@ -14,7 +17,8 @@ namespace Protocol {
     // CONSTRUCTOR
     // ============================================================
 
-    GasKitProtocol::GasKitProtocol(uint8_t addrHi, uint8_t addrLo)
+    template <typename Dialect>
+    BasicGasKitProtocol<Dialect>::BasicGasKitProtocol(uint8_t addrHi, uint8_t addrLo)
         : m_addrHi(addrHi)
         , m_addrLo(addrLo)
     {
@@ -24,283 +28,456 @@ namespace Protocol {
     // COMMAND BUILDING
     // ============================================================
 
-    std::vector<uint8_t> GasKitProtocol::BuildStatusRequest()
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildStatusRequest()
     {
-        return BuildFrame("S");
+        if (HasFixedFrames(m_addrHi, m_addrLo))
+            return GetFixedFrame(m_addrLo, FixedCommand::Status);
+        return BuildFrame("S", 1);
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildVolumePreset(int nozzle, int volumeCentiliters, int price)
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildVolumePreset(int nozzle, int volumeCentiliters, int price)
     {
-        std::string payload = "V";
-        payload += std::to_string(nozzle);
-        payload += ";";
-        payload += FormatNumber(volumeCentiliters, 6);
-        payload += ";";
-        payload += FormatNumber(price, 4);
-        return BuildFrame(payload);
+        // Format: Vg;vvvvvv;pppp (14 characters, standard dialect)
+        return BuildPreset('V', nozzle, volumeCentiliters, Dialect::VolumeDigits, price);
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildMoneyPreset(int nozzle, int money, int price)
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildMoneyPreset(int nozzle, int money, int price)
     {
-        std::string payload = "M";
-        payload += std::to_string(nozzle);
-        payload += ";";
-        payload += FormatNumber(money, 6);
-        payload += ";";
-        payload += FormatNumber(price, 4);
-        return BuildFrame(payload);
+        // Format: Mg;mmmmmm;pppp (14 characters, standard dialect)
+        return BuildPreset('M', nozzle, money, Dialect::MoneyDigits, price);
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildStop()
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildStop()
     {
-        return BuildFrame("B");
+        if (HasFixedFrames(m_addrHi, m_addrLo))
+            return GetFixedFrame(m_addrLo, FixedCommand::Stop);
+        return BuildFrame("B", 1);
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildResume()
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildResume()
     {
-        return BuildFrame("G");
+        if (HasFixedFrames(m_addrHi, m_addrLo))
+            return GetFixedFrame(m_addrLo, FixedCommand::Resume);
+        return BuildFrame("G", 1);
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildVolumeRequest()
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildVolumeRequest()
     {
-        return BuildFrame("L");
+        if (HasFixedFrames(m_addrHi, m_addrLo))
+            return GetFixedFrame(m_addrLo, FixedCommand::Volume);
+        return BuildFrame("L", 1);
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildMoneyRequest()
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildMoneyRequest()
     {
-        return BuildFrame("R");
+        if (HasFixedFrames(m_addrHi, m_addrLo))
+            return GetFixedFrame(m_addrLo, FixedCommand::Money);
+        return BuildFrame("R", 1);
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildTransactionRequest()
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildTransactionRequest()
     {
-        return BuildFrame("T");
+        if (HasFixedFrames(m_addrHi, m_addrLo))
+            return GetFixedFrame(m_addrLo, FixedCommand::Transaction);
+        return BuildFrame("T", 1);
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildTotalCounterRequest(int nozzle)
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildTotalCounterRequest(int nozzle)
     {
-        std::string payload = "C";
-        payload += std::to_string(nozzle);
-        return BuildFrame(payload);
+        if (nozzle == 0 && HasFixedFrames(m_addrHi, m_addrLo))
+            return GetFixedFrame(m_addrLo, FixedCommand::TotalCounter0);
+
+        // Format: Cg (2 characters)
+        char payload[2] = { 'C', 0 };
+        if (!FormatNumber(nozzle, 1, payload + 1))
+            return Frame();
+        return BuildFrame(payload, sizeof(payload));
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildEndTransaction()
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildEndTransaction()
     {
-        return BuildFrame("N");
+        if (HasFixedFrames(m_addrHi, m_addrLo))
+            return GetFixedFrame(m_addrLo, FixedCommand::EndTransaction);
+        return BuildFrame("N", 1);
     }
 
     // ============================================================
     // RESPONSE PARSING
+    // Fields are decoded in place from the frame bytes:
+    // no payload copy, no exceptions, explicit ParseError on failure.
     // ============================================================
 
-    StatusResponse GasKitProtocol::ParseStatusResponse(const std::vector<uint8_t>& frame)
+    namespace
     {
-        StatusResponse result = {};
-        result.valid = false;
+        /// Fixed-width unsigned ASCII decimal field; false on any non-digit
+        template <size_t Width, typename T>
+        bool ParseDigits(const uint8_t* p, T& out)
+        {
+            uint32_t value;
+            if (!Swar::ParseDigits<Width>(p, value)) return false;
+            out = static_cast<T>(value);
+            return true;
+        }
+
+        /// Common "gis;" header of L/R/T responses
+        template <typename Response>
+        ParseError ParseNozzleTxnState(const uint8_t* payload, Response& result)
+        {
+            unsigned nozzle = static_cast<unsigned>(payload[1]) - '0';
+            if (nozzle > 9) return ParseError::BadNozzle;
+            result.nozzle = static_cast<int>(nozzle);
+            result.transactionId = static_cast<char>(payload[2]);
+
+            unsigned state = static_cast<unsigned>(payload[3]) - '0';
+            if (state > 9) return ParseError::BadState;
+            result.state = static_cast<DispenserState>(state);
+
+            if (payload[4] != ';') return ParseError::BadSeparator;
+            return ParseError::None;
+        }
+    } // anonymous namespace
 
-        if (!ValidateCRC(frame)) return result;
+    /// Common checks: CRC (optional), minimum payload length, command letter
+    template <typename Dialect>
+    ParseError BasicGasKitProtocol<Dialect>::CheckFrame(std::span<const uint8_t> frame, size_t minPayload,
+                                                        char cmd, bool checkCrc)
+    {
+        if (frame.size() < Layout::Overhead + 1) return ParseError::TooShort;
+        if (frame[0] != STX) return ParseError::BadStx;
+        if (checkCrc && !ValidateCRC(frame)) return ParseError::BadCrc;
+        if (frame.size() - Layout::Overhead < minPayload) return ParseError::TooShort;
+        if (frame[Layout::PayloadOffset] != static_cast<uint8_t>(cmd)) return ParseError::WrongCommand;
+        return ParseError::None;
+    }
 
-        std::string payload = ExtractPayload(frame);
+    template <typename Dialect>
+    StatusResponse BasicGasKitProtocol<Dialect>::DecodeStatus(std::span<const uint8_t> frame, bool checkCrc)
+    {
+        StatusResponse result = {};
+        result.valid = false;
 
         // Format: Ssg (3 characters)
-        if (payload.size() < 3 || payload[0] != 'S') return result;
+        result.error = CheckFrame(frame, Layout::StatusPayload, 'S', checkCrc);
+        if (result.error != ParseError::None) return result;
 
-        int state = payload[1] - '0';
-        int nozzle = payload[2] - '0';
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        unsigned state = static_cast<unsigned>(payload[1]) - '0';
+        unsigned nozzle = static_cast<unsigned>(payload[2]) - '0';
 
-        if (state < 0 || state > 9) return result;
-        if (nozzle < 0 || nozzle > 6) return result;
+        if (state > 9) { result.error = ParseError::BadState; return result; }
+        if (nozzle > 6) { result.error = ParseError::BadNozzle; return result; }
 
         result.state = static_cast<DispenserState>(state);
-        result.nozzle = nozzle;
+        result.nozzle = static_cast<int>(nozzle);
         result.valid = true;
         return result;
     }
 
-    VolumeResponse GasKitProtocol::ParseVolumeResponse(const std::vector<uint8_t>& frame)
+    template <typename Dialect>
+    VolumeResponse BasicGasKitProtocol<Dialect>::DecodeVolume(std::span<const uint8_t> frame, bool checkCrc)
     {
         VolumeResponse result = {};
         result.valid = false;
 
-        if (!ValidateCRC(frame)) return result;
+        // Format: Lgis;llllll (11 characters, standard dialect)
+        result.error = CheckFrame(frame, Layout::VolumePayload, 'L', checkCrc);
+        if (result.error != ParseError::None) return result;
 
-        std::string payload = ExtractPayload(frame);
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        result.error = ParseNozzleTxnState(payload, result);
+        if (result.error != ParseError::None) return result;
 
-        // Format: Lgis;llllll (11 characters)
-        if (payload.size() < 11 || payload[0] != 'L') return result;
-
-        result.nozzle = payload[1] - '0';
-        result.transactionId = payload[2];
-        int state = payload[3] - '0';
-        if (state < 0 || state > 9) return result;
-        result.state = static_cast<DispenserState>(state);
-
-        if (payload[4] != ';') return result;
-
-        try {
-            result.volumeCentiliters = std::stoi(payload.substr(5, 6));
+        if (!ParseDigits<Dialect::VolumeDigits>(payload + 5, result.volumeCentiliters))
+        {
+            result.error = ParseError::BadDigit;
+            return result;
         }
-        catch (...) { return result; }
 
         result.valid = true;
         return result;
     }
 
-    MoneyResponse GasKitProtocol::ParseMoneyResponse(const std::vector<uint8_t>& frame)
+    template <typename Dialect>
+    MoneyResponse BasicGasKitProtocol<Dialect>::DecodeMoney(std::span<const uint8_t> frame, bool checkCrc)
     {
         MoneyResponse result = {};
         result.valid = false;
 
-        if (!ValidateCRC(frame)) return result;
+        // Format: Rgis;rrrrrr (11 characters, standard dialect)
+        result.error = CheckFrame(frame, Layout::MoneyPayload, 'R', checkCrc);
+        if (result.error != ParseError::None) return result;
 
-        std::string payload = ExtractPayload(frame);
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        result.error = ParseNozzleTxnState(payload, result);
+        if (result.error != ParseError::None) return result;
 
-        if (payload.size() < 11 || payload[0] != 'R') return result;
-
-        result.nozzle = payload[1] - '0';
-        result.transactionId = payload[2];
-        int state = payload[3] - '0';
-        if (state < 0 || state > 9) return result;
-        result.state = static_cast<DispenserState>(state);
-
-        if (payload[4] != ';') return result;
-
-        try {
-            result.money = std::stoi(payload.substr(5, 6));
+        if (!ParseDigits<Dialect::MoneyDigits>(payload + 5, result.money))
+        {
+            result.error = ParseError::BadDigit;
+            return result;
         }
-        catch (...) { return result; }
 
         result.valid = true;
         return result;
     }
 
-    TransactionResponse GasKitProtocol::ParseTransactionResponse(const std::vector<uint8_t>& frame)
+    template <typename Dialect>
+    TransactionResponse BasicGasKitProtocol<Dialect>::DecodeTransaction(std::span<const uint8_t> frame, bool checkCrc)
     {
         TransactionResponse result = {};
         result.valid = false;
 
-        if (!ValidateCRC(frame)) return result;
+        // Format: Tgis;mmmmmm;llllll;pppp (23 characters, standard dialect)
+        result.error = CheckFrame(frame, Layout::TransactionPayload, 'T', checkCrc);
+        if (result.error != ParseError::None) return result;
 
-        std::string payload = ExtractPayload(frame);
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        result.error = ParseNozzleTxnState(payload, result);
+        if (result.error != ParseError::None) return result;
 
-        if (payload.size() < 23 || payload[0] != 'T') return result;
+        constexpr size_t moneyPos = 5;
+        constexpr size_t volumePos = moneyPos + Dialect::MoneyDigits + 1;
+        constexpr size_t pricePos = volumePos + Dialect::VolumeDigits + 1;
 
-        result.nozzle = payload[1] - '0';
-        result.transactionId = payload[2];
-        int state = payload[3] - '0';
-        if (state < 0 || state > 9) return result;
-        result.state = static_cast<DispenserState>(state);
-
-        if (payload[4] != ';') return result;
-
-        try {
-            result.money = std::stoi(payload.substr(5, 6));
-            if (payload[11] != ';') return result;
-            result.volumeCentiliters = std::stoi(payload.substr(12, 6));
-            if (payload[18] != ';') return result;
-            result.price = std::stoi(payload.substr(19, 4));
+        if (payload[volumePos - 1] != ';' || payload[pricePos - 1] != ';')
+        {
+            result.error = ParseError::BadSeparator;
+            return result;
+        }
+        if (!ParseDigits<Dialect::MoneyDigits>(payload + moneyPos, result.money) ||
+            !ParseDigits<Dialect::VolumeDigits>(payload + volumePos, result.volumeCentiliters) ||
+            !ParseDigits<Dialect::PriceDigits>(payload + pricePos, result.price))
+        {
+            result.error = ParseError::BadDigit;
+            return result;
         }
-        catch (...) { return result; }
 
         result.valid = true;
         return result;
     }
 
-    TotalCounterResponse GasKitProtocol::ParseTotalCounterResponse(const std::vector<uint8_t>& frame)
+    template <typename Dialect>
+    TotalCounterResponse BasicGasKitProtocol<Dialect>::DecodeTotalCounter(std::span<const uint8_t> frame, bool checkCrc)
     {
         TotalCounterResponse result = {};
         result.valid = false;
 
-        if (!ValidateCRC(frame)) return result;
-
-        std::string payload = ExtractPayload(frame);
+        // Format: Cg;ttttttttt (12 characters, standard dialect)
+        result.error = CheckFrame(frame, Layout::TotalPayload, 'C', checkCrc);
+        if (result.error != ParseError::None) return result;
 
-        if (payload.size() < 12 || payload[0] != 'C') return result;
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        unsigned nozzle = static_cast<unsigned>(payload[1]) - '0';
+        if (nozzle > 9) { result.error = ParseError::BadNozzle; return result; }
+        result.nozzle = static_cast<int>(nozzle);
 
-        result.nozzle = payload[1] - '0';
-        if (payload[2] != ';') return result;
+        if (payload[2] != ';') { result.error = ParseError::BadSeparator; return result; }
 
-        try {
-            result.totalCentiliters = std::stoll(payload.substr(3, 9));
+        if (!ParseDigits<Dialect::TotalDigits>(payload + 3, result.totalCentiliters))
+        {
+            result.error = ParseError::BadDigit;
+            return result;
         }
-        catch (...) { return result; }
 
         result.valid = true;
         return result;
     }
 
+    // ============================================================
+    // PUBLIC PARSERS — CRC + fields
+    // ============================================================
+
+    template <typename Dialect>
+    StatusResponse BasicGasKitProtocol<Dialect>::ParseStatusResponse(std::span<const uint8_t> frame)
+    {
+        return DecodeStatus(frame, true);
+    }
+
+    template <typename Dialect>
+    VolumeResponse BasicGasKitProtocol<Dialect>::ParseVolumeResponse(std::span<const uint8_t> frame)
+    {
+        return DecodeVolume(frame, true);
+    }
+
+    template <typename Dialect>
+    MoneyResponse BasicGasKitProtocol<Dialect>::ParseMoneyResponse(std::span<const uint8_t> frame)
+    {
+        return DecodeMoney(frame, true);
+    }
+
+    template <typename Dialect>
+    TransactionResponse BasicGasKitProtocol<Dialect>::ParseTransactionResponse(std::span<const uint8_t> frame)
+    {
+        return DecodeTransaction(frame, true);
+    }
+
+    template <typename Dialect>
+    TotalCounterResponse BasicGasKitProtocol<Dialect>::ParseTotalCounterResponse(std::span<const uint8_t> frame)
+    {
+        return DecodeTotalCounter(frame, true);
+    }
+
+    template <typename Dialect>
+    Response BasicGasKitProtocol<Dialect>::ParseResponse(std::span<const uint8_t> frame)
+    {
+        return Decode(frame, true);
+    }
+
+    template <typename Dialect>
+    Response BasicGasKitProtocol<Dialect>::DecodeValidatedFrame(std::span<const uint8_t> frame)
+    {
+        return Decode(frame, false);
+    }
+
+    // ============================================================
+    // Dispatch on the command byte; invalid fields -> monostate
+    // ============================================================
+
+    template <typename Dialect>
+    Response BasicGasKitProtocol<Dialect>::Decode(std::span<const uint8_t> frame, bool checkCrc)
+    {
+        if (frame.size() < Layout::Overhead + 1) return std::monostate{};
+
+        auto keepIfValid = [](const auto& r) -> Response {
+            if (r.valid) return r;
+            return std::monostate{};
+        };
+
+        switch (static_cast<char>(frame[Layout::PayloadOffset]))
+        {
+        case 'S': return keepIfValid(DecodeStatus(frame, checkCrc));
+        case 'L': return keepIfValid(DecodeVolume(frame, checkCrc));
+        case 'R': return keepIfValid(DecodeMoney(frame, checkCrc));
+        case 'T': return keepIfValid(DecodeTransaction(frame, checkCrc));
+        case 'C': return keepIfValid(DecodeTotalCounter(frame, checkCrc));
+        default:  return std::monostate{};
+        }
+    }
+
     // ============================================================
     // UTILITIES
     // ============================================================
 
-    bool GasKitProtocol::ValidateCRC(const std::vector<uint8_t>& frame)
+    template <typename Dialect>
+    bool BasicGasKitProtocol<Dialect>::ValidateCRC(std::span<const uint8_t> frame)
     {
         // Minimum frame: STX(1) + addr(2) + cmd(1) + CRC(1) = 5 bytes
-        if (frame.size() < 5) return false;
+        if (frame.size() < Layout::Overhead + 1) return false;
         if (frame[0] != STX) return false;
 
-        uint8_t expectedCRC = CalculateCRC(frame, 1, frame.size() - 2);
+        uint8_t expectedCRC = CalculateCRC(frame.data(), frame.size(), 1, frame.size() - 2);
         uint8_t actualCRC = frame[frame.size() - 1];
 
-        // For debugging
-        // Log("Expected CRC: " + std::to_string(expectedCRC) + ", Actual CRC: " + std::to_string(actualCRC));
-
         return expectedCRC == actualCRC;
     }
 
-    std::string GasKitProtocol::ExtractPayload(const std::vector<uint8_t>& frame)
+    template <typename Dialect>
+    std::string BasicGasKitProtocol<Dialect>::ExtractPayload(std::span<const uint8_t> frame)
     {
         // Frame: [STX][addrHi][addrLo][payload...][CRC]
-        if (frame.size() < 5) return "";
+        if (frame.size() < Layout::Overhead + 1) return "";
 
         std::string payload;
-        for (size_t i = 3; i < frame.size() - 1; i++)
+        for (size_t i = Layout::PayloadOffset; i < frame.size() - 1; i++)
         {
             payload += static_cast<char>(frame[i]);
         }
         return payload;
     }
 
-    std::vector<uint8_t> GasKitProtocol::BuildFrame(const std::string& payload)
+    /// Vg;v..;p.. / Mg;m..;p.. with dialect field widths
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildPreset(char cmd, int nozzle, int amount,
+                                                    size_t amountDigits, int price)
     {
-        std::vector<uint8_t> frame;
+        char payload[Layout::PresetPayload] = {};
+        const size_t pricePos = 3 + amountDigits + 1;
+
+        payload[0] = cmd;
+        payload[2] = ';';
+        payload[pricePos - 1] = ';';
+        if (!FormatNumber(nozzle, 1, payload + 1) ||
+            !FormatNumber(amount, static_cast<int>(amountDigits), payload + 3) ||
+            !FormatNumber(price, static_cast<int>(Dialect::PriceDigits), payload + pricePos))
+            return Frame();
+        return BuildFrame(payload, pricePos + Dialect::PriceDigits);
+    }
+
+    template <typename Dialect>
+    Frame BasicGasKitProtocol<Dialect>::BuildFrame(const char* payload, size_t length)
+    {
+        Frame frame;
+
+        // STX(1) + addr(2) + payload + CRC(1) must fit (section 6.5)
+        if (length + Layout::Overhead > Layout::MaxFrameSize) return frame;
 
         // 1. STX
-        frame.push_back(STX);
+        frame.PushBack(STX);
 
         // 2. Slave address — 2 BINARY bytes (NOT ASCII!)
         //    Dispenser #1: 0x00, 0x01
-        frame.push_back(m_addrHi);
-        frame.push_back(m_addrLo);
+        frame.PushBack(m_addrHi);
+        frame.PushBack(m_addrLo);
 
         // 3. Payload (command + data) — ASCII
-        for (char c : payload)
+        for (size_t i = 0; i < length; i++)
         {
-            frame.push_back(static_cast<uint8_t>(c));
+            frame.PushBack(static_cast<uint8_t>(payload[i]));
         }
 
         // 4. CRC — XOR from position 1 to last payload byte
-        uint8_t crc = CalculateCRC(frame, 1, frame.size() - 1);
-        frame.push_back(crc);
+        uint8_t crc = CalculateCRC(frame.data(), frame.size(), 1, frame.size() - 1);
+        frame.PushBack(crc);
 
         return frame;
     }
 
-    uint8_t GasKitProtocol::CalculateCRC(const std::vector<uint8_t>& data, size_t from, size_t to)
+    template <typename Dialect>
+    uint8_t BasicGasKitProtocol<Dialect>::CalculateCRC(const uint8_t* data, size_t size, size_t from, size_t to)
     {
-        uint8_t crc = 0;
-        for (size_t i = from; i <= to && i < data.size(); i++)
-        {
-            crc ^= data[i];
-        }
-        return crc;
+        if (from >= size || to < from) return 0;
+        if (to >= size) to = size - 1;
+        return Swar::XorChecksum(data + from, to - from + 1);
     }
 
-    std::string GasKitProtocol::FormatNumber(int value, int width)
+    template <typename Dialect>
+    bool BasicGasKitProtocol<Dialect>::FormatNumber(int value, int width, char* out)
     {
-        std::ostringstream oss;
-        oss << std::setw(width) << std::setfill('0') << value;
-        return oss.str();
+        if (value < 0) return false;
+
+        // to_chars writes the significant digits; shift them right
+        // and pad with '0' up to the fixed field width
+        char digits[16];
+        auto res = std::to_chars(digits, digits + sizeof(digits), value);
+        if (res.ec != std::errc()) return false;
+
+        int len = static_cast<int>(res.ptr - digits);
+        if (len > width) return false;
+
+        int pad = width - len;
+        for (int i = 0; i < pad; i++)
+            out[i] = '0';
+        for (int i = 0; i < len; i++)
+            out[pad + i] = digits[i];
+        return true;
     }
 
+    // ============================================================
+    // INSTANTIATIONS
+    // ============================================================
+
+    template class BasicGasKitProtocol<GasKitStandardDialect>;
+    template class BasicGasKitProtocol<GasKitWideDialect>;
+
 } // namespace Protocol
 } // namespace FuelMaster
@@ -3,19 +3,25 @@
 // ============================================================
 // FIXED: Slave address — 2 binary bytes (0x00, 0x01),
 // NOT ASCII characters ('0', '1')
+//
+// The codec (GasKitDialect.h, GasKitFrame.h, GasKitCommandTable.h,
+// GasKitSwar.h, GasKitProtocol.*, GasKitFrameDecoder.*) is plain
+// C++20 with no Windows or precompiled-header dependency, so it
+// also builds on the Linux hosts.
 // ============================================================
 
 #pragma once
 
+#include "GasKitDialect.h"
+#include "GasKitFrame.h"
 #include <cstdint>
-#include <vector>
+#include <span>
 #include <string>
+#include <variant>
 
 namespace FuelMaster {
 namespace Protocol {
 
-    constexpr uint8_t STX = 0x02;
-
     /// Default Slave address: 2 binary bytes
     /// Dispenser #1 = {0x00, 0x01}
     constexpr uint8_t DEFAULT_SLAVE_ADDR_HI = 0x00;
@@ -41,6 +47,23 @@ namespace Protocol {
         EndOfTransaction  = 9
     };
 
+    // ============================================================
+    // PARSE ERRORS
+    // ============================================================
+
+    enum class ParseError : uint8_t
+    {
+        None = 0,
+        TooShort,       // frame or payload shorter than the format requires
+        BadStx,         // first byte is not STX
+        BadCrc,         // XOR checksum mismatch
+        WrongCommand,   // payload command letter differs from expected
+        BadState,       // state digit outside 0..9
+        BadNozzle,      // nozzle digit out of range
+        BadSeparator,   // ';' missing at a field boundary
+        BadDigit        // non-digit inside a numeric field
+    };
+
     // ============================================================
     // RESPONSE STRUCTURES
     // ============================================================
@@ -50,6 +73,7 @@ namespace Protocol {
         DispenserState state;
         int nozzle;
         bool valid;
+        ParseError error;
     };
 
     struct VolumeResponse
@@ -59,6 +83,7 @@ namespace Protocol {
         DispenserState state;
         int volumeCentiliters;
         bool valid;
+        ParseError error;
     };
 
     struct MoneyResponse
@@ -68,6 +93,7 @@ namespace Protocol {
         DispenserState state;
         int money;
         bool valid;
+        ParseError error;
     };
 
     struct TransactionResponse
@@ -79,6 +105,7 @@ namespace Protocol {
         int volumeCentiliters;
         int price;
         bool valid;
+        ParseError error;
     };
 
     struct TotalCounterResponse
@@ -86,19 +113,40 @@ namespace Protocol {
         int nozzle;
         long long totalCentiliters;
         bool valid;
+        ParseError error;
     };
 
+    /// Decoded response, tagged by command letter.
+    /// std::monostate = nothing could be decoded.
+    using Response = std::variant<
+        std::monostate,
+        StatusResponse,        // S (also reply to V/M/B/G/N)
+        VolumeResponse,        // L
+        MoneyResponse,         // R
+        TransactionResponse,   // T
+        TotalCounterResponse>; // C
+
     // ============================================================
-    // GasKitProtocol CLASS
+    // BasicGasKitProtocol — codec specialised per dialect
     // ============================================================
+    // Field widths, offsets and frame lengths come from the Dialect
+    // traits (GasKitDialect.h) at compile time. Both dialects are
+    // explicitly instantiated in GasKitProtocol.cpp.
 
-    class GasKitProtocol
+    template <typename Dialect>
+    class BasicGasKitProtocol
     {
     public:
+        using DialectType = Dialect;
+        using Layout = DialectLayout<Dialect>;
+
+        static_assert(Dialect::AddressBytes == 2,
+                      "GasKit slave address is 2 binary bytes {hi, lo}");
+
         /// Constructor: addrHi, addrLo — 2 binary address bytes
         /// For dispenser #1: addrHi=0x00, addrLo=0x01
-        GasKitProtocol(uint8_t addrHi = DEFAULT_SLAVE_ADDR_HI,
-                       uint8_t addrLo = DEFAULT_SLAVE_ADDR_LO);
+        BasicGasKitProtocol(uint8_t addrHi = DEFAULT_SLAVE_ADDR_HI,
+                            uint8_t addrLo = DEFAULT_SLAVE_ADDR_LO);
 
         /// Change slave address (after construction)
         void SetAddress(uint8_t addrHi, uint8_t addrLo)
@@ -108,36 +156,72 @@ namespace Protocol {
         }
 
         // --- Command building ---
-        std::vector<uint8_t> BuildStatusRequest();
-        std::vector<uint8_t> BuildVolumePreset(int nozzle, int volumeCentiliters, int price);
-        std::vector<uint8_t> BuildMoneyPreset(int nozzle, int money, int price);
-        std::vector<uint8_t> BuildStop();
-        std::vector<uint8_t> BuildResume();
-        std::vector<uint8_t> BuildVolumeRequest();
-        std::vector<uint8_t> BuildMoneyRequest();
-        std::vector<uint8_t> BuildTransactionRequest();
-        std::vector<uint8_t> BuildTotalCounterRequest(int nozzle);
-        std::vector<uint8_t> BuildEndTransaction();
+        // Frames are built in place, without heap allocation.
+        // An empty frame is returned if a value does not fit its field.
+        Frame BuildStatusRequest();
+        Frame BuildVolumePreset(int nozzle, int volumeCentiliters, int price);
+        Frame BuildMoneyPreset(int nozzle, int money, int price);
+        Frame BuildStop();
+        Frame BuildResume();
+        Frame BuildVolumeRequest();
+        Frame BuildMoneyRequest();
+        Frame BuildTransactionRequest();
+        Frame BuildTotalCounterRequest(int nozzle);
+        Frame BuildEndTransaction();
 
         // --- Response parsing ---
-        StatusResponse ParseStatusResponse(const std::vector<uint8_t>& frame);
-        VolumeResponse ParseVolumeResponse(const std::vector<uint8_t>& frame);
-MoneyResponse ParseMoneyResponse(const std::vector<uint8_t>& frame);
-        TransactionResponse ParseTransactionResponse(const std::vector<uint8_t>& frame);
-        TotalCounterResponse ParseTotalCounterResponse(const std::vector<uint8_t>& frame);
+        // Accept any contiguous byte range (std::vector, Frame, raw buffer).
+        // Never throw and never allocate; on failure valid=false and
+        // error tells why.
+        StatusResponse ParseStatusResponse(std::span<const uint8_t> frame);
+        VolumeResponse ParseVolumeResponse(std::span<const uint8_t> frame);
+        MoneyResponse ParseMoneyResponse(std::span<const uint8_t> frame);
+        TransactionResponse ParseTransactionResponse(std::span<const uint8_t> frame);
+        TotalCounterResponse ParseTotalCounterResponse(std::span<const uint8_t> frame);
+
+        /// Single entry point: check CRC, dispatch on the command byte
+        Response ParseResponse(std::span<const uint8_t> frame);
+
+        /// Same as ParseResponse for a frame whose CRC was already
+        /// verified (FrameDecoder output) — fields only, no second CRC pass
+        Response DecodeValidatedFrame(std::span<const uint8_t> frame);
 
         // --- Utilities ---
-        bool ValidateCRC(const std::vector<uint8_t>& frame);
-        std::string ExtractPayload(const std::vector<uint8_t>& frame);
+        bool ValidateCRC(std::span<const uint8_t> frame);
+        std::string ExtractPayload(std::span<const uint8_t> frame);
 
     private:
         uint8_t m_addrHi;   // Address high byte (0x00)
         uint8_t m_addrLo;   // Address low byte (0x01)
 
-        std::vector<uint8_t> BuildFrame(const std::string& payload);
-        uint8_t CalculateCRC(const std::vector<uint8_t>& data, size_t from, size_t to);
-        std::string FormatNumber(int value, int width);
+        Frame BuildFrame(const char* payload, size_t length);
+        Frame BuildPreset(char cmd, int nozzle, int amount, size_t amountDigits, int price);
+
+        // Field decoding; checkCrc=false when the caller already verified it
+        StatusResponse DecodeStatus(std::span<const uint8_t> frame, bool checkCrc);
+        VolumeResponse DecodeVolume(std::span<const uint8_t> frame, bool checkCrc);
+        MoneyResponse DecodeMoney(std::span<const uint8_t> frame, bool checkCrc);
+        TransactionResponse DecodeTransaction(std::span<const uint8_t> frame, bool checkCrc);
+        TotalCounterResponse DecodeTotalCounter(std::span<const uint8_t> frame, bool checkCrc);
+        Response Decode(std::span<const uint8_t> frame, bool checkCrc);
+        ParseError CheckFrame(std::span<const uint8_t> frame, size_t minPayload,
+                              char cmd, bool checkCrc);
+
+        uint8_t CalculateCRC(const uint8_t* data, size_t size, size_t from, size_t to);
+
+        /// Write value as exactly `width` zero-padded ASCII digits.
+        /// Returns false if value is negative or needs more digits.
+        static bool FormatNumber(int value, int width, char* out);
     };
 
+    extern template class BasicGasKitProtocol<GasKitStandardDialect>;
+    extern template class BasicGasKitProtocol<GasKitWideDialect>;
+
+    /// Standard GasKit codec (6-digit volume/money, 4-digit price)
+    using GasKitProtocol = BasicGasKitProtocol<GasKitStandardDialect>;
+
+    /// GasKitLink wide-field firmware (8-digit volume/money, 6-digit price)
+    using GasKitWideProtocol = BasicGasKitProtocol<GasKitWideDialect>;
+
 } // namespace Protocol
 } // namespace FuelMaster
@@ -0,0 +1,209 @@
+// ============================================================
+// GasKitSwar.h — SWAR / SSE2 kernels for the GasKit codec
+// ============================================================
+// Fixed-width ASCII decimal fields (4/6/8/9 digits) are
+// validated and converted 8 bytes at a time inside a 64-bit
+// register; the XOR checksum is folded 16 bytes at a time with
+// SSE2 (x64) or 8 bytes at a time otherwise. Used for the live
+// parsers and for bulk post-processing of captured traffic.
+//
+// Scalar fallbacks are always available (ParseDigitsScalar,
+// XorChecksumScalar) and are selected automatically on
+// big-endian targets.
+// ============================================================
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define FM_GASKIT_SSE2 1
+#else
+#define FM_GASKIT_SSE2 0
+#endif
+
+namespace FuelMaster {
+namespace Protocol {
+namespace Swar {
+
+    // ============================================================
+    // SCALAR REFERENCE
+    // ============================================================
+
+    /// Validate and convert `width` ASCII digits (width <= 9)
+    inline bool ParseDigitsScalar(const uint8_t* p, size_t width, uint32_t& out)
+    {
+        uint32_t value = 0;
+        for (size_t i = 0; i < width; i++)
+        {
+            uint32_t d = static_cast<uint32_t>(p[i]) - '0';
+            if (d > 9) return false;
+            value = value * 10 + d;
+        }
+        out = value;
+        return true;
+    }
+
+    inline uint8_t XorChecksumScalar(const uint8_t* data, size_t size)
+    {
+        uint8_t crc = 0;
+        for (size_t i = 0; i < size; i++)
+            crc ^= data[i];
+        return crc;
+    }
+
+    // ============================================================
+    // SWAR DIGIT KERNELS (little-endian)
+    // ============================================================
+
+    namespace Detail {
+
+        constexpr bool LITTLE_ENDIAN_TARGET = (std::endian::native == std::endian::little);
+
+        /// All 8 bytes of v are '0'..'9'
+        inline bool AllDigits8(uint64_t v)
+        {
+            // High nibble must be 3, and adding 6 must not carry into it
+            // ('0'..'9' + 6 = 0x36..0x3F, ':'..'?' + 6 = 0x40..0x45)
+            return (v & 0xF0F0F0F0F0F0F0F0ull) == 0x3030303030303030ull &&
+                   ((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) == 0x3030303030303030ull;
+        }
+
+        inline bool AllDigits4(uint32_t v)
+        {
+            return (v & 0xF0F0F0F0u) == 0x30303030u &&
+                   ((v + 0x06060606u) & 0xF0F0F0F0u) == 0x30303030u;
+        }
+
+        /// 8 validated digits in memory order (first = most significant)
+        inline uint32_t Convert8(uint64_t v)
+        {
+            v -= 0x3030303030303030ull;
+            v = (v * 10) + (v >> 8);  // pairs in even bytes
+            v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+                 (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+            return static_cast<uint32_t>(v);
+        }
+
+        inline uint32_t Convert4(uint32_t v)
+        {
+            v -= 0x30303030u;
+            v = (v * 10) + (v >> 8);  // pairs in bytes 0 and 2
+            return (((v & 0x00FF00FFu) * ((100u << 16) + 1)) >> 16) & 0xFFFFu;
+        }
+
+    } // namespace Detail
+
+    inline bool ParseDigits8(const uint8_t* p, uint32_t& out)
+    {
+        if constexpr (!Detail::LITTLE_ENDIAN_TARGET)
+            return ParseDigitsScalar(p, 8, out);
+
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        if (!Detail::AllDigits8(v)) return false;
+        out = Detail::Convert8(v);
+        return true;
+    }
+
+    inline bool ParseDigits6(const uint8_t* p, uint32_t& out)
+    {
+        if constexpr (!Detail::LITTLE_ENDIAN_TARGET)
+            return ParseDigitsScalar(p, 6, out);
+
+        // Left-pad with two '0' so the 8-digit kernel applies. Built
+        // from register loads: a 6-byte copy into the middle of the
+        // padded word stalls on store forwarding
+        uint32_t head;
+        uint16_t tail;
+        std::memcpy(&head, p, 4);
+        std::memcpy(&tail, p + 4, 2);
+        const uint64_t v = 0x3030ull | (static_cast<uint64_t>(head) << 16) |
+                           (static_cast<uint64_t>(tail) << 48);
+        if (!Detail::AllDigits8(v)) return false;
+        out = Detail::Convert8(v);
+        return true;
+    }
+
+    inline bool ParseDigits4(const uint8_t* p, uint32_t& out)
+    {
+        if constexpr (!Detail::LITTLE_ENDIAN_TARGET)
+            return ParseDigitsScalar(p, 4, out);
+
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        if (!Detail::AllDigits4(v)) return false;
+        out = Detail::Convert4(v);
+        return true;
+    }
+
+    inline bool ParseDigits9(const uint8_t* p, uint32_t& out)
+    {
+        uint32_t head = static_cast<uint32_t>(p[0]) - '0';
+        if (head > 9) return false;
+
+        uint32_t tail;
+        if (!ParseDigits8(p + 1, tail)) return false;
+        out = head * 100000000u + tail;
+        return true;
+    }
+
+    /// Compile-time width dispatch (falls back to scalar for other widths)
+    template <size_t Width>
+    inline bool ParseDigits(const uint8_t* p, uint32_t& out)
+    {
+        static_assert(Width >= 1 && Width <= 9, "GasKit numeric fields are 1..9 digits");
+
+        if constexpr (Width == 4) return ParseDigits4(p, out);
+        else if constexpr (Width == 6) return ParseDigits6(p, out);
+        else if constexpr (Width == 8) return ParseDigits8(p, out);
+        else if constexpr (Width == 9) return ParseDigits9(p, out);
+        else return ParseDigitsScalar(p, Width, out);
+    }
+
+    // ============================================================
+    // XOR CHECKSUM
+    // ============================================================
+
+    /// XOR of data[0..size-1]
+    inline uint8_t XorChecksum(const uint8_t* data, size_t size)
+    {
+        uint64_t acc = 0;
+        size_t i = 0;
+
+#if FM_GASKIT_SSE2
+        if (size >= 16)
+        {
+            __m128i v = _mm_setzero_si128();
+            for (; i + 16 <= size; i += 16)
+                v = _mm_xor_si128(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+            v = _mm_xor_si128(v, _mm_srli_si128(v, 8));
+            acc = static_cast<uint64_t>(_mm_cvtsi128_si64(v));
+        }
+#endif
+
+        for (; i + 8 <= size; i += 8)
+        {
+            uint64_t w;
+            std::memcpy(&w, data + i, 8);
+            acc ^= w;
+        }
+
+        // Fold 8 lanes into one byte (byte order does not matter for XOR)
+        acc ^= acc >> 32;
+        acc ^= acc >> 16;
+        acc ^= acc >> 8;
+        uint8_t crc = static_cast<uint8_t>(acc);
+
+        for (; i < size; i++)
+            crc ^= data[i];
+        return crc;
+    }
+
+} // namespace Swar
+} // namespace Protocol
+} // namespace FuelMaster
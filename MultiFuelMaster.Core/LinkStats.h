@@ -0,0 +1,32 @@
+// ============================================================
+// LinkStats.h — Exchange throughput and recovery of a post
+// ============================================================
+// Kept by DispenserController::SendWithRetry. An exchange is a
+// command that got its reply, whatever the number of attempts.
+// A recovery episode starts at the first failed attempt (no
+// response / CRC error) and ends with the next good reply, so
+// it spans retries, backoff windows and lost-link polling.
+// ============================================================
+#pragma once
+
+#include <cstdint>
+
+namespace FuelMaster {
+
+    struct LinkStats
+    {
+        uint64_t exchanges;         // commands answered
+        uint64_t failedAttempts;    // attempts without a usable reply
+        uint64_t recoveries;        // completed recovery episodes
+        uint64_t recoveryUs;        // total time spent recovering
+        uint64_t maxRecoveryUs;     // longest single episode
+        double elapsedSec;          // since Connect / ResetLinkStats
+
+        /// Effective update rate: answered commands per second
+        double UpdateRate() const
+        {
+            return elapsedSec > 0.0 ? static_cast<double>(exchanges) / elapsedSec : 0.0;
+        }
+    };
+
+} // namespace FuelMaster
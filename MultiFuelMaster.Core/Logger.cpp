@@ -5,9 +5,14 @@
 #include "pch.h"
 #include "Logger.h"
 #include <cstdarg>
+#include <cstdio>
 #include <ctime>
 #include <algorithm>
 
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
 namespace FuelMaster {
 
 // ============================================================
@@ -34,7 +39,7 @@ Logger::~Logger()
 
 void Logger::Initialize(const std::string& logPath, int maxFileSizeMb, int maxFiles)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
     if (m_initialized)
     {
@@ -45,12 +50,16 @@ void Logger::Initialize(const std::string& logPath, int maxFileSizeMb, int maxFi
     m_maxFileSize = maxFileSizeMb * 1024 * 1024;
     m_maxFiles = maxFiles;
 
-    // Create directory if it doesn't exist (Win32 API)
+    // Create directory if it doesn't exist
     size_t pos = logPath.find_last_of("/\\");
     if (pos != std::string::npos)
     {
         std::string dir = logPath.substr(0, pos);
+#if defined(_WIN32)
         CreateDirectoryA(dir.c_str(), NULL);
+#else
+        mkdir(dir.c_str(), 0755);
+#endif
     }
 
     // Open file
@@ -80,7 +89,7 @@ void Logger::Initialize(const std::string& logPath, int maxFileSizeMb, int maxFi
 
 void Logger::Shutdown()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
     if (!m_initialized)
     {
@@ -157,7 +166,7 @@ void Logger::LogInternal(LogLevel level, const std::string& message)
         return;
     }
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
 
     // Check rotation
     CheckRotation();
@@ -204,7 +213,9 @@ void Logger::Error(const std::string& message)
 // Formatted logging
 // ============================================================
 
+#if defined(_MSC_VER)
 #pragma managed(push, off)
+#endif
 
 void Logger::Log(LogLevel level, const char* format, ...)
 {
@@ -256,7 +267,9 @@ void Logger::Error(const char* format, ...)
     LogInternal(LVL_ERROR, buffer);
 }
 
+#if defined(_MSC_VER)
 #pragma managed(pop)
+#endif
 
 // ============================================================
 // Hex dump logging
@@ -317,6 +330,7 @@ void Logger::CheckRotation()
                 newName = m_logPath + "." + std::to_string(i + 1);
             }
 
+#if defined(_WIN32)
             // Check existence and delete old file (Win32 API)
             if (GetFileAttributesA(newName.c_str()) != INVALID_FILE_ATTRIBUTES)
             {
@@ -328,6 +342,10 @@ void Logger::CheckRotation()
             {
                 MoveFileExA(oldName.c_str(), newName.c_str(), MOVEFILE_REPLACE_EXISTING);
             }
+#else
+            // rename() replaces an existing target; a missing source just fails
+            std::rename(oldName.c_str(), newName.c_str());
+#endif
         }
 
         // Open new file
@@ -81,7 +81,7 @@ private:
     std::string GetThreadId();
 
     std::ofstream m_file;
-    std::mutex m_mutex;
+    std::recursive_mutex m_mutex;  // Initialize/Shutdown log through Info() while holding it
     std::string m_logPath;
     std::string m_currentLogPath;
     int m_maxFileSize;
@@ -8,7 +8,9 @@
 #pragma once
 
 // Macro for exporting/importing functions from DLL
-#ifdef FUELMASTERCORE_EXPORTS
+#if !defined(_WIN32)
+    #define FUELMASTER_API __attribute__((visibility("default")))
+#elif defined(FUELMASTERCORE_EXPORTS)
     #define FUELMASTER_API __declspec(dllexport)
 #else
     #define FUELMASTER_API __declspec(dllimport)
@@ -16,5 +18,5 @@
 
 // Include all public headers
 #include "GasKitProtocol.h"
-#include "SerialPort.h"
+#include "Transport.h"
 #include "DispenserController.h"
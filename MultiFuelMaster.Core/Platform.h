@@ -0,0 +1,19 @@
+// ============================================================
+// Platform.h — Small portability helpers (Windows / Linux)
+// ============================================================
+#pragma once
+
+#include "PreciseWait.h"
+#include <chrono>
+
+namespace FuelMaster {
+
+    /// Portable replacement for Win32 Sleep(ms), not rounded up to the
+    /// system tick (see PreciseWait.h)
+    inline void SleepMs(int ms)
+    {
+        if (ms > 0)
+            SleepUntil(std::chrono::steady_clock::now() + std::chrono::milliseconds(ms));
+    }
+
+} // namespace FuelMaster
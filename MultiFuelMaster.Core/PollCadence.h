@@ -0,0 +1,87 @@
+// ============================================================
+// PollCadence.h — Target vs achieved poll period of a post
+// ============================================================
+// Kept by DispenserController::PollOnce. Every poll cycle
+// (queued commands, SR, FSM action) is due at an absolute
+// steady_clock deadline: one target period, chosen by the
+// post's state, after the deadline of the cycle before. I/O,
+// LM/RS and retries inside a cycle are absorbed by the wait
+// instead of adding to it; a cycle that overruns its period is
+// followed at once, without catching up.
+// A lost link is the exception: its cycle is all timeouts, so
+// linkLostPollMs is a rest counted from the end of it.
+// A target of 0 polls back to back: the next cycle is due at
+// once and only waits for the line gap after the last reply
+// (interCommandDelayMs); such a phase has no overruns.
+// ============================================================
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace FuelMaster {
+
+    enum class PollPhase : int
+    {
+        Idle = 0,       // Idle / Error
+        Busy = 1,       // Calling / Authorized / Started / SuspendedStarted / EndOfTransaction
+        Active = 2,     // Fuelling / SuspendedFuelling / Stopped
+        LinkLost = 3    // no reply to SR
+    };
+
+    constexpr int POLL_PHASE_COUNT = 4;
+
+    /// Achieved period more than this over target counts as an overrun
+    constexpr double POLL_OVERRUN_TOLERANCE_MS = 1.0;
+
+    inline const char* PollPhaseName(PollPhase phase)
+    {
+        switch (phase)
+        {
+        case PollPhase::Idle:     return "idle";
+        case PollPhase::Busy:     return "busy";
+        case PollPhase::Active:   return "active";
+        case PollPhase::LinkLost: return "link lost";
+        default:                  return "?";
+        }
+    }
+
+    struct PollPhaseStats
+    {
+        int targetMs;           // TimingParams period of the phase
+        uint64_t periods;       // cycle start to next cycle start, measured
+        double meanMs;          // achieved
+        double maxMs;
+        uint64_t overruns;      // periods over target (not counted for LinkLost or target 0)
+    };
+
+    struct PollCadenceStats
+    {
+        PollPhase current;      // phase of the last cycle
+        PollPhaseStats phases[POLL_PHASE_COUNT];
+
+        const PollPhaseStats& Of(PollPhase phase) const { return phases[static_cast<int>(phase)]; }
+
+        /// One line: target and achieved period of each phase seen
+        std::string Report() const
+        {
+            std::string text;
+            for (int i = 0; i < POLL_PHASE_COUNT; i++)
+            {
+                const PollPhaseStats& s = phases[i];
+                if (s.periods == 0) continue;
+
+                char part[160];
+                snprintf(part, sizeof(part),
+                    "%s%s %d ms: %.1f ms avg / %.1f max, %llu periods, %llu overruns",
+                    text.empty() ? "" : "; ", PollPhaseName(static_cast<PollPhase>(i)), s.targetMs,
+                    s.meanMs, s.maxMs,
+                    static_cast<unsigned long long>(s.periods), static_cast<unsigned long long>(s.overruns));
+                text += part;
+            }
+            return text.empty() ? std::string("no periods measured") : text;
+        }
+    };
+
+} // namespace FuelMaster
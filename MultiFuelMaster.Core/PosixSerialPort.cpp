@@ -0,0 +1,424 @@
+// ============================================================
+// PosixSerialPort.cpp — termios + epoll serial port (Linux)
+// ============================================================
+
+#include "pch.h"
+#include "PosixSerialPort.h"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace FuelMaster {
+
+    namespace
+    {
+        /// termios speed constant for a numeric baud rate (B0 = unsupported)
+        speed_t BaudToSpeed(int baudRate)
+        {
+            switch (baudRate)
+            {
+            case 1200:   return B1200;
+            case 2400:   return B2400;
+            case 4800:   return B4800;
+            case 9600:   return B9600;
+            case 19200:  return B19200;
+            case 38400:  return B38400;
+            case 57600:  return B57600;
+            case 115200: return B115200;
+            case 230400: return B230400;
+            default:     return B0;
+            }
+        }
+
+        /// First line of a sysfs attribute ("" if unreadable)
+        std::string ReadAttribute(const std::string& path)
+        {
+            std::ifstream file(path);
+            std::string value;
+            std::getline(file, value);
+            return value;
+        }
+
+        bool WriteAttribute(const std::string& path, const std::string& value)
+        {
+            std::ofstream file(path);
+            file << value;
+            file.flush();
+            return file.good();
+        }
+
+        /// Canonical path with all links resolved ("" if it does not exist)
+        std::string ResolvePath(const std::string& path)
+        {
+            char resolved[PATH_MAX];
+            return realpath(path.c_str(), resolved) ? std::string(resolved) : std::string();
+        }
+
+        std::string BaseName(const std::string& path)
+        {
+            const size_t slash = path.rfind('/');
+            return slash == std::string::npos ? path : path.substr(slash + 1);
+        }
+    } // anonymous namespace
+
+    PosixSerialPort::PosixSerialPort()
+        : m_fd(-1)
+        , m_epollFd(-1)
+        , m_wakeThreshold(0)
+    {
+    }
+
+    PosixSerialPort::~PosixSerialPort()
+    {
+        Close();
+    }
+
+    bool PosixSerialPort::Open(const std::string& portName, const SerialSettings& settings)
+    {
+        if (IsOpen()) Close();
+
+        std::string path = (!portName.empty() && portName[0] == '/') ? portName : "/dev/" + portName;
+
+        // Receive-only: the kernel refuses any write on the descriptor
+        const int access = IsReceiveOnly() ? O_RDONLY : O_RDWR;
+        int fd = ::open(path.c_str(), access | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0)
+        {
+            m_lastError = "Cannot open " + path + " (" + std::strerror(errno) + ")";
+            return false;
+        }
+
+        return Attach(fd, portName, settings);
+    }
+
+    bool PosixSerialPort::Attach(int fd, const std::string& portName, const SerialSettings& settings)
+    {
+        m_fd = fd;
+        m_portName = portName;
+
+        if (!ConfigurePort(settings))
+        {
+            Close();
+            return false;
+        }
+
+        m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (m_epollFd < 0)
+        {
+            m_lastError = std::string("epoll_create1 failed (") + std::strerror(errno) + ")";
+            Close();
+            return false;
+        }
+
+        epoll_event ev = {};
+        ev.events = EPOLLIN;
+        ev.data.fd = m_fd;
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_fd, &ev) != 0)
+        {
+            m_lastError = std::string("epoll_ctl failed (") + std::strerror(errno) + ")";
+            Close();
+            return false;
+        }
+
+        IdentifyAdapter();
+
+        tcflush(m_fd, TCIOFLUSH);
+        m_lastError = "";
+        return true;
+    }
+
+    void PosixSerialPort::Close()
+    {
+        if (m_epollFd >= 0)
+        {
+            ::close(m_epollFd);
+            m_epollFd = -1;
+        }
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    bool PosixSerialPort::IsOpen() const
+    {
+        return m_fd >= 0 && m_epollFd >= 0;
+    }
+
+    bool PosixSerialPort::Configure(const SerialSettings& settings)
+    {
+        if (!IsOpen()) return false;
+        if (!ConfigurePort(settings)) return false;
+
+        // Bytes received at the old rate are garbage at the new one
+        tcflush(m_fd, TCIOFLUSH);
+        return true;
+    }
+
+    // ============================================================
+    // READ
+    // epoll_wait sleeps until the tty is readable (EPOLLIN once
+    // VMIN bytes are queued, or EPOLLHUP when the device goes
+    // away - ReadNow reports it)
+    // ============================================================
+
+    int PosixSerialPort::WaitForData(int timeoutMs, size_t minBytes)
+    {
+        if (!IsOpen()) return -1;
+
+        SetWakeThreshold(minBytes);
+
+        epoll_event ev;
+        int n = epoll_wait(m_epollFd, &ev, 1, timeoutMs < 0 ? 0 : timeoutMs);
+        if (n < 0)
+        {
+            if (errno == EINTR) return 0;
+            m_lastError = std::string("epoll_wait failed (") + std::strerror(errno) + ")";
+            return -1;
+        }
+        return n > 0 ? 1 : 0;
+    }
+
+    void PosixSerialPort::SetWakeThreshold(size_t bytes)
+    {
+        if (bytes < 1) bytes = 1;
+        if (bytes > 255) bytes = 255;   // VMIN is a cc_t
+        if (bytes == m_wakeThreshold) return;
+
+        termios tio = {};
+        if (tcgetattr(m_fd, &tio) != 0) return;
+        tio.c_cc[VMIN] = static_cast<cc_t>(bytes);
+        if (tcsetattr(m_fd, TCSANOW, &tio) == 0)
+            m_wakeThreshold = bytes;
+    }
+
+    int PosixSerialPort::ReadNow(uint8_t* buffer, size_t size)
+    {
+        if (!IsOpen()) return -1;
+
+        ssize_t n = ::read(m_fd, buffer, size);
+        if (n > 0) return static_cast<int>(n);
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return 0;
+
+        if (n == 0)
+        {
+            // With VMIN = 0 an empty queue also reads 0: only POLLHUP
+            // means the device is gone (removed / pty peer closed)
+            pollfd pfd = { m_fd, POLLIN, 0 };
+            if (poll(&pfd, 1, 0) >= 0 && !(pfd.revents & (POLLHUP | POLLERR)))
+                return 0;
+        }
+
+        m_lastError = (n == 0) ? "Device hang-up" : std::string("read failed (") + std::strerror(errno) + ")";
+        return -1;
+    }
+
+    // ============================================================
+    // WRITE
+    // ============================================================
+
+    int PosixSerialPort::Write(const uint8_t* data, size_t size)
+    {
+        if (!IsOpen() || size == 0) return 0;
+
+        size_t written = 0;
+        while (written < size)
+        {
+            ssize_t n = ::write(m_fd, data + written, size - written);
+            if (n > 0)
+            {
+                written += static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                // Output queue full - same 100 ms budget as the Win32 write timeout
+                pollfd pfd = { m_fd, POLLOUT, 0 };
+                if (poll(&pfd, 1, 100) > 0) continue;
+            }
+            break;
+        }
+        return static_cast<int>(written);
+    }
+
+    bool PosixSerialPort::DrainTx(int timeoutMs)
+    {
+        // tcdrain returns once the driver reports the transmitter empty.
+        // It has no timeout of its own: with flow control off it is
+        // bounded by the frame's wire time, so timeoutMs is not needed.
+        (void)timeoutMs;
+        if (!IsOpen()) return false;
+
+        while (tcdrain(m_fd) != 0)
+        {
+            if (errno != EINTR) return false;
+        }
+        return true;
+    }
+
+    // ============================================================
+    // CLEAR
+    // ============================================================
+
+    void PosixSerialPort::PurgeInput()
+    {
+        if (IsOpen())
+            tcflush(m_fd, TCIFLUSH);
+    }
+
+    // ============================================================
+    // PORT CONFIGURATION
+    // ============================================================
+
+    bool PosixSerialPort::ConfigurePort(const SerialSettings& settings)
+    {
+        termios tio = {};
+        if (tcgetattr(m_fd, &tio) != 0)
+        {
+            m_lastError = "Cannot get port state";
+            return false;
+        }
+
+        speed_t speed = BaudToSpeed(settings.baudRate);
+        if (speed == B0)
+        {
+            m_lastError = "Unsupported baud rate " + std::to_string(settings.baudRate);
+            return false;
+        }
+
+        tcflag_t dataBits;
+        switch (settings.dataBits)
+        {
+        case 5: dataBits = CS5; break;
+        case 6: dataBits = CS6; break;
+        case 7: dataBits = CS7; break;
+        case 8: dataBits = CS8; break;
+        default:
+            m_lastError = "Unsupported data bits " + std::to_string(settings.dataBits);
+            return false;
+        }
+
+        // GasKitLink: 9600, 8N1 by default, raw bytes, no flow control
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        tio.c_cflag &= ~(PARENB | PARODD | CSTOPB | CSIZE | CRTSCTS);
+        tio.c_cflag |= dataBits | CLOCAL | CREAD;
+        if (settings.parity != Parity::None)
+            tio.c_cflag |= PARENB | (settings.parity == Parity::Odd ? PARODD : 0);
+        if (settings.stopBits == 2)
+            tio.c_cflag |= CSTOPB;
+        tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+
+        // Non-blocking reads: waiting is done with epoll
+        // (VMIN is adjusted per wait by SetWakeThreshold)
+        tio.c_cc[VMIN] = 0;
+        tio.c_cc[VTIME] = 0;
+        m_wakeThreshold = 0;
+
+        if (tcsetattr(m_fd, TCSANOW, &tio) != 0)
+        {
+            m_lastError = "Cannot set port state";
+            return false;
+        }
+
+        m_settings = settings;
+        return true;
+    }
+
+    // ============================================================
+    // ADAPTER
+    // /sys/class/tty/<name>/device is the port's device; the USB
+    // device (idVendor / idProduct) is one of its parents. No USB
+    // parent: a native UART. No device at all: a pty.
+    // ============================================================
+
+    void PosixSerialPort::IdentifyAdapter()
+    {
+        // The descriptor's own path also resolves /dev/serial/by-id links
+        const std::string devicePath = ResolvePath("/proc/self/fd/" + std::to_string(m_fd));
+        if (devicePath.empty())
+        {
+            m_adapter = AdapterOfKind(AdapterKind::Unknown);
+            return;
+        }
+
+        const std::string deviceDir = ResolvePath("/sys/class/tty/" + BaseName(devicePath) + "/device");
+        if (deviceDir.empty())
+        {
+            m_adapter = AdapterOfKind(AdapterKind::Virtual);
+            return;
+        }
+
+        std::string usbDir = deviceDir;
+        while (usbDir.size() > 1 && access((usbDir + "/idVendor").c_str(), R_OK) != 0)
+            usbDir.erase(usbDir.rfind('/'));
+
+        AdapterInfo info = AdapterOfKind(AdapterKind::Native);
+        const std::string driver = BaseName(ResolvePath(deviceDir + "/driver"));
+        if (usbDir.size() > 1)
+        {
+            info = AdapterFromUsbId(
+                static_cast<uint16_t>(std::strtoul(ReadAttribute(usbDir + "/idVendor").c_str(), nullptr, 16)),
+                static_cast<uint16_t>(std::strtoul(ReadAttribute(usbDir + "/idProduct").c_str(), nullptr, 16)));
+
+            // CDC-ACM is a class, not a vendor: told by the driver
+            if (info.kind == AdapterKind::UsbOther && driver == "cdc_acm")
+            {
+                info.kind = AdapterKind::CdcAcm;
+                info.latencyMs = AdapterOfKind(AdapterKind::CdcAcm).latencyMs;
+            }
+        }
+        info.driver = driver;
+
+        const std::string timerPath = deviceDir + "/latency_timer";
+        const int timerBeforeMs = (info.kind == AdapterKind::Ftdi) ? std::atoi(ReadAttribute(timerPath).c_str()) : 0;
+
+        // ASYNC_LOW_LATENCY: drivers that honour it hand RX bytes over
+        // without batching; ftdi_sio drops its latency timer to 1 ms
+        // (allowed to whoever may open the tty, unlike sysfs)
+        serial_struct serial = {};
+        if (ioctl(m_fd, TIOCGSERIAL, &serial) == 0 && !(serial.flags & ASYNC_LOW_LATENCY))
+        {
+            serial.flags |= ASYNC_LOW_LATENCY;
+            ioctl(m_fd, TIOCSSERIAL, &serial);
+        }
+
+        if (info.kind == AdapterKind::Ftdi)
+        {
+            int timerMs = std::atoi(ReadAttribute(timerPath).c_str());
+            if (timerMs > FTDI_LOW_LATENCY_MS &&
+                WriteAttribute(timerPath, std::to_string(FTDI_LOW_LATENCY_MS)))
+            {
+                timerMs = std::atoi(ReadAttribute(timerPath).c_str());
+            }
+
+            if (timerMs > 0)
+            {
+                info.latencyMs = timerMs;
+                info.tuned = timerBeforeMs > 0 && timerMs < timerBeforeMs;
+            }
+            if (timerMs > FTDI_LOW_LATENCY_MS)
+                info.hint = "write " + std::to_string(FTDI_LOW_LATENCY_MS) + " to " + timerPath + " (udev rule) for faster replies";
+        }
+
+        m_adapter = info;
+    }
+
+} // namespace FuelMaster
+
+#endif // __linux__
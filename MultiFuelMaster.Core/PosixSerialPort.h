@@ -0,0 +1,63 @@
+// ============================================================
+// PosixSerialPort.h — termios + epoll serial port (Linux)
+// ============================================================
+// Linux backend of Transport. The tty is opened non-blocking in
+// raw 8N1 mode; the polling thread sleeps in epoll_wait until
+// the tty holds the bytes the decoder still needs (VMIN), reads
+// never block. At Open the adapter is identified from sysfs
+// and its RX latency lowered (see AdapterProfile.h).
+// ============================================================
+#pragma once
+
+#include "Transport.h"
+
+#if defined(__linux__)
+
+namespace FuelMaster {
+
+    class PosixSerialPort : public Transport
+    {
+    public:
+        PosixSerialPort();
+        ~PosixSerialPort() override;
+
+        /// portName: device path ("/dev/ttyUSB0") or bare name ("ttyUSB0")
+        bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default()) override;
+        void Close() override;
+        bool IsOpen() const override;
+        bool Configure(const SerialSettings& settings) override;
+
+        /// Clear input buffer
+        void PurgeInput() override;
+
+    protected:
+        int Write(const uint8_t* data, size_t size) override;
+        bool DrainTx(int timeoutMs) override;
+        int WaitForData(int timeoutMs, size_t minBytes) override;
+        int ReadNow(uint8_t* buffer, size_t size) override;
+        bool IsHotPluggable() const override { return true; }
+
+        /// Configure an already opened tty and register it with epoll
+        bool Attach(int fd, const std::string& portName, const SerialSettings& settings);
+
+    private:
+        int m_fd;
+        int m_epollFd;
+        size_t m_wakeThreshold;     // VMIN currently programmed
+
+        bool ConfigurePort(const SerialSettings& settings);
+
+        /// Program VMIN so the tty only turns readable once `bytes`
+        /// are queued (n_tty honours VMIN in poll when VTIME = 0)
+        void SetWakeThreshold(size_t bytes);
+
+        /// Fill m_adapter from sysfs (/sys/class/tty/<name>) and lower
+        /// the RX latency where the driver lets us: ASYNC_LOW_LATENCY,
+        /// and the FTDI latency timer
+        void IdentifyAdapter();
+    };
+
+} // namespace FuelMaster
+
+#endif // __linux__
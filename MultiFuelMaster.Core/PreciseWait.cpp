@@ -0,0 +1,234 @@
+// ============================================================
+// PreciseWait.cpp — Sub-millisecond sleeps for poll pacing
+// ============================================================
+
+#include "pch.h"
+#include "PreciseWait.h"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#elif defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#endif
+
+#if defined(_WIN32) && !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace FuelMaster {
+
+    using Clock = std::chrono::steady_clock;
+
+#if defined(_WIN32)
+
+    namespace
+    {
+        // Older Windows: a plain waitable timer only gets 1 ms ticks once
+        // the timer resolution is raised (process-wide, kept until exit)
+        HANDLE CreatePreciseTimer()
+        {
+            HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr,
+                CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+            if (timer) return timer;
+
+            static const bool raised = (timeBeginPeriod(1) == TIMERR_NOERROR);
+            (void)raised;
+            return CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+        }
+
+        /// Arm for the time left until `deadline` (relative: the timer
+        /// runs on the system clock, steady_clock on QPC)
+        bool ArmTimer(HANDLE timer, Clock::time_point deadline)
+        {
+            const auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now());
+            if (left.count() <= 0) return false;
+
+            LARGE_INTEGER due;
+            due.QuadPart = -static_cast<LONGLONG>((left.count() + 99) / 100);   // 100 ns units
+            return SetWaitableTimerEx(timer, &due, 0, nullptr, nullptr, nullptr, 0) != FALSE;
+        }
+
+        // One timer per thread that sleeps, closed with the thread
+        struct ThreadTimer
+        {
+            HANDLE handle = CreatePreciseTimer();
+            ~ThreadTimer() { if (handle) CloseHandle(handle); }
+        };
+    }
+
+    void SleepUntil(Clock::time_point deadline)
+    {
+        thread_local ThreadTimer timer;
+        if (!timer.handle)
+        {
+            std::this_thread::sleep_until(deadline);
+            return;
+        }
+        while (ArmTimer(timer.handle, deadline))
+            WaitForSingleObject(timer.handle, INFINITE);
+    }
+
+    WakeableSleep::WakeableSleep()
+        : m_timer(CreatePreciseTimer())
+        , m_event(CreateEventW(nullptr, FALSE, FALSE, nullptr))
+    {
+    }
+
+    WakeableSleep::~WakeableSleep()
+    {
+        if (m_timer) CloseHandle(m_timer);
+        if (m_event) CloseHandle(m_event);
+    }
+
+    bool WakeableSleep::SleepUntil(Clock::time_point deadline)
+    {
+        if (deadline == (Clock::time_point::max)())
+            return WaitForSingleObject(m_event, INFINITE) == WAIT_OBJECT_0;
+
+        while (true)
+        {
+            if (!ArmTimer(m_timer, deadline))
+                return WaitForSingleObject(m_event, 0) == WAIT_OBJECT_0;
+
+            // The event first: a Wake() racing the deadline is not lost
+            HANDLE handles[2] = { m_event, m_timer };
+            DWORD result = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+            if (result == WAIT_OBJECT_0) return true;
+            if (result != WAIT_OBJECT_0 + 1) return false;
+        }
+    }
+
+    void WakeableSleep::Wake()
+    {
+        if (m_event) SetEvent(m_event);
+    }
+
+#else
+
+    void SleepUntil(Clock::time_point deadline)
+    {
+#if defined(__linux__)
+        // Absolute CLOCK_MONOTONIC time: a wake-up by a signal resumes
+        // towards the same deadline instead of restarting the interval
+        const auto left = deadline - Clock::now();
+        if (left.count() <= 0) return;
+
+        timespec due;
+        clock_gettime(CLOCK_MONOTONIC, &due);
+        const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+        due.tv_sec += static_cast<time_t>(ns / 1000000000);
+        due.tv_nsec += static_cast<long>(ns % 1000000000);
+        if (due.tv_nsec >= 1000000000)
+        {
+            due.tv_sec++;
+            due.tv_nsec -= 1000000000;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &due, nullptr) == EINTR) {}
+#else
+        std::this_thread::sleep_until(deadline);
+#endif
+    }
+
+    // condition_variable::wait_until on steady_clock is a futex wait on
+    // CLOCK_MONOTONIC on Linux: already nanosecond-exact
+    WakeableSleep::WakeableSleep()
+        : m_woken(false)
+    {
+    }
+
+    WakeableSleep::~WakeableSleep() = default;
+
+    bool WakeableSleep::SleepUntil(Clock::time_point deadline)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto pred = [this] { return m_woken; };
+        if (deadline == (Clock::time_point::max)())
+            m_signal.wait(lock, pred);
+        else
+            m_signal.wait_until(lock, deadline, pred);
+
+        const bool woken = m_woken;
+        m_woken = false;
+        return woken;
+    }
+
+    void WakeableSleep::Wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_woken = true;
+        }
+        m_signal.notify_one();
+    }
+
+#endif
+
+    void SleepUs(int64_t us)
+    {
+        if (us > 0)
+            SleepUntil(Clock::now() + std::chrono::microseconds(us));
+    }
+
+    // ============================================================
+    // JITTER BENCHMARK
+    // ============================================================
+
+    namespace
+    {
+        template <typename Wait>
+        WaitJitterStats Measure(int samples, Wait&& wait)
+        {
+            std::vector<double> achieved;
+            achieved.reserve(static_cast<size_t>(samples));
+            for (int i = 0; i < samples; i++)
+            {
+                const Clock::time_point start = Clock::now();
+                wait();
+                achieved.push_back(static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()) / 1000.0);
+            }
+
+            WaitJitterStats stats = { samples, 0.0, 0.0, 0.0, 0.0 };
+            if (achieved.empty()) return stats;
+
+            std::sort(achieved.begin(), achieved.end());
+            double sum = 0.0;
+            for (double us : achieved) sum += us;
+            stats.meanUs = sum / static_cast<double>(achieved.size());
+            stats.minUs = achieved.front();
+            stats.maxUs = achieved.back();
+            stats.p99Us = achieved[(achieved.size() - 1) * 99 / 100];
+            return stats;
+        }
+    }
+
+    WaitJitterReport MeasureWaitJitter(int requestedUs, int samples)
+    {
+        WaitJitterReport report;
+        report.requestedUs = requestedUs;
+        report.precise = Measure(samples, [requestedUs] { SleepUs(requestedUs); });
+        report.baseline = Measure(samples, [requestedUs] {
+            std::this_thread::sleep_for(std::chrono::microseconds(requestedUs));
+        });
+        return report;
+    }
+
+    std::string WaitJitterReport::Report() const
+    {
+        char line[320];
+        snprintf(line, sizeof(line),
+            "requested %.3f ms x %d: precise mean %.3f / min %.3f / p99 %.3f / max %.3f ms, "
+            "sleep_for mean %.3f / min %.3f / p99 %.3f / max %.3f ms",
+            requestedUs / 1000.0, precise.samples,
+            precise.meanUs / 1000.0, precise.minUs / 1000.0, precise.p99Us / 1000.0, precise.maxUs / 1000.0,
+            baseline.meanUs / 1000.0, baseline.minUs / 1000.0, baseline.p99Us / 1000.0, baseline.maxUs / 1000.0);
+        return line;
+    }
+
+} // namespace FuelMaster
@@ -0,0 +1,94 @@
+// ============================================================
+// PreciseWait.h — Sub-millisecond sleeps for poll pacing
+// ============================================================
+// Sleep() and timed waits on Windows end on a system tick
+// (~15.6 ms by default), so a 10 ms LM->RS pause or a 10 ms
+// fuelling poll interval really lasts 15.6 ms.
+//   Windows — high-resolution waitable timer
+//             (CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, Win10 1803+),
+//             else a plain one with timeBeginPeriod(1)
+//   Linux   — clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME)
+// MeasureWaitJitter compares requested and achieved delays,
+// against std::this_thread::sleep_for as the baseline.
+// ============================================================
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace FuelMaster {
+
+    /// Block the calling thread until `deadline` (steady_clock)
+    void SleepUntil(std::chrono::steady_clock::time_point deadline);
+
+    /// Block the calling thread for `us` microseconds
+    void SleepUs(int64_t us);
+
+    // ============================================================
+    // Precise sleep that another thread can cut short
+    // (one sleeping thread, any number of waking ones)
+    // ============================================================
+    class WakeableSleep
+    {
+    public:
+        WakeableSleep();
+        ~WakeableSleep();
+
+        WakeableSleep(const WakeableSleep&) = delete;
+        WakeableSleep& operator=(const WakeableSleep&) = delete;
+
+        /// Sleep until `deadline` (time_point::max() = no timeout) or
+        /// Wake(). True if woken. A Wake() while nobody sleeps makes
+        /// the next call return at once.
+        bool SleepUntil(std::chrono::steady_clock::time_point deadline);
+
+        void Wake();
+
+    private:
+#if defined(_WIN32)
+        HANDLE m_timer;
+        HANDLE m_event;     // auto-reset
+#else
+        std::mutex m_mutex;
+        std::condition_variable m_signal;
+        bool m_woken;
+#endif
+    };
+
+    // ============================================================
+    // Jitter benchmark
+    // ============================================================
+    struct WaitJitterStats
+    {
+        int samples;
+        double meanUs;      // achieved delay
+        double minUs;
+        double maxUs;
+        double p99Us;
+    };
+
+    struct WaitJitterReport
+    {
+        int requestedUs;
+        WaitJitterStats precise;    // SleepUntil
+        WaitJitterStats baseline;   // std::this_thread::sleep_for
+
+        /// One line: requested vs achieved, both methods
+        std::string Report() const;
+    };
+
+    /// Sleep `samples` times for `requestedUs` with each method and
+    /// measure what was achieved. Blocks for about
+    /// 2 x samples x requestedUs (plus the baseline's overshoot).
+    WaitJitterReport MeasureWaitJitter(int requestedUs, int samples);
+
+} // namespace FuelMaster
@@ -0,0 +1,58 @@
+// ============================================================
+// PtyTransport.cpp — Pseudo-terminal pair backend (Linux, tests)
+// ============================================================
+
+#include "pch.h"
+#include "PtyTransport.h"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace FuelMaster {
+
+    PtyTransport::PtyTransport()
+        : m_masterFd(-1)
+    {
+        int fd = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+        if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0)
+        {
+            m_lastError = std::string("Cannot create pty pair (") + std::strerror(errno) + ")";
+            if (fd >= 0) ::close(fd);
+            return;
+        }
+
+        char name[64];
+        if (ptsname_r(fd, name, sizeof(name)) != 0)
+        {
+            m_lastError = "ptsname failed";
+            ::close(fd);
+            return;
+        }
+
+        m_masterFd = fd;
+        m_slaveName = name;
+    }
+
+    PtyTransport::~PtyTransport()
+    {
+        Close();
+        if (m_masterFd >= 0)
+            ::close(m_masterFd);
+    }
+
+    bool PtyTransport::Open(const std::string& portName, const SerialSettings& settings)
+    {
+        (void)portName;
+        if (m_masterFd < 0) return false;  // m_lastError set by the constructor
+
+        return PosixSerialPort::Open(m_slaveName, settings);
+    }
+
+} // namespace FuelMaster
+
+#endif // __linux__
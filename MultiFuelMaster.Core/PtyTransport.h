@@ -0,0 +1,41 @@
+// ============================================================
+// PtyTransport.h — Pseudo-terminal pair backend (Linux, tests)
+// ============================================================
+// The controller side is the pty slave, driven exactly like a
+// real tty by PosixSerialPort. The master side (GetPeerFd) is
+// handed to a dispenser simulator, so the whole Core can run
+// and be profiled without hardware.
+// ============================================================
+#pragma once
+
+#include "PosixSerialPort.h"
+
+#if defined(__linux__)
+
+namespace FuelMaster {
+
+    class PtyTransport : public PosixSerialPort
+    {
+    public:
+        /// Creates the pty pair; the peer is usable right away
+        PtyTransport();
+        ~PtyTransport() override;
+
+        /// Opens the slave side (portName is ignored)
+        bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default()) override;
+
+        /// Master (dispenser) side, -1 if the pair could not be created
+        int GetPeerFd() const { return m_masterFd; }
+
+        /// Path of the slave tty, e.g. /dev/pts/3
+        std::string GetSlaveName() const { return m_slaveName; }
+
+    private:
+        int m_masterFd;
+        std::string m_slaveName;
+    };
+
+} // namespace FuelMaster
+
+#endif // __linux__
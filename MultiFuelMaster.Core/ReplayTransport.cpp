@@ -0,0 +1,195 @@
+// ============================================================
+// ReplayTransport.cpp — Plays a WireCapture back as a line
+// ============================================================
+
+#include "pch.h"
+#include "ReplayTransport.h"
+#include "PreciseWait.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace FuelMaster {
+
+    namespace
+    {
+        constexpr char PREFIX[] = "replay:";
+        constexpr size_t PREFIX_LENGTH = sizeof(PREFIX) - 1;
+    }
+
+    ReplayTransport::ReplayTransport()
+        : m_next(0)
+        , m_speed(1.0)
+        , m_open(false)
+        , m_txReplayed(0)
+        , m_divergences(0)
+    {
+    }
+
+    ReplayTransport::~ReplayTransport()
+    {
+        Close();
+    }
+
+    bool ReplayTransport::IsReplayPortName(const std::string& portName)
+    {
+        return portName.compare(0, PREFIX_LENGTH, PREFIX) == 0;
+    }
+
+    // ============================================================
+    // OPEN / CLOSE
+    // ============================================================
+
+    bool ReplayTransport::Open(const std::string& portName, const SerialSettings& settings)
+    {
+        Close();
+
+        // Each open takes its speed from its own port name
+        m_speed = 1.0;
+        std::string path = IsReplayPortName(portName) ? portName.substr(PREFIX_LENGTH) : portName;
+        size_t query = path.find("?speed=");
+        if (query != std::string::npos)
+        {
+            m_speed = std::atof(path.c_str() + query + 7);
+            path.erase(query);
+        }
+
+        std::string error;
+        if (!WireCapture::Load(path, m_capturedPort, m_records, error))
+        {
+            m_lastError = error;
+            return false;
+        }
+
+        // RX recorded before the first TX has no request to follow
+        m_next = 0;
+        while (m_next < m_records.size() && m_records[m_next].direction != WireDirection::Tx)
+            m_next++;
+
+        m_txReplayed.store(0);
+        m_divergences.store(0);
+        m_portName = portName;
+        m_settings = settings;
+        m_lastError = "";
+        m_open = true;
+        return true;
+    }
+
+    void ReplayTransport::Close()
+    {
+        m_open = false;
+        m_pending.clear();
+        m_records.clear();
+        m_next = 0;
+    }
+
+    bool ReplayTransport::IsOpen() const
+    {
+        return m_open;
+    }
+
+    bool ReplayTransport::Configure(const SerialSettings& settings)
+    {
+        if (!m_open) return false;
+        m_settings = settings;
+        return true;
+    }
+
+    void ReplayTransport::PurgeInput()
+    {
+        // Only what has "arrived" is purged; later chunks are still in flight
+        const Clock::time_point now = Clock::now();
+        while (!m_pending.empty() && m_pending.front().due <= now)
+            m_pending.pop_front();
+    }
+
+    // ============================================================
+    // REPLAY
+    // ============================================================
+
+    int ReplayTransport::Write(const uint8_t* data, size_t size)
+    {
+        if (!m_open) return 0;
+        if (m_next >= m_records.size())
+            return static_cast<int>(size);  // capture exhausted: nothing answers
+
+        const Clock::time_point now = Clock::now();
+        const WireRecord& tx = m_records[m_next++];
+        m_txReplayed.fetch_add(1);
+
+        if (tx.data.size() != size || std::memcmp(tx.data.data(), data, size) != 0)
+            m_divergences.fetch_add(1);
+
+        // Schedule everything received until the next request
+        while (m_next < m_records.size() && m_records[m_next].direction == WireDirection::Rx)
+        {
+            const WireRecord& rx = m_records[m_next++];
+            Clock::time_point due = now;
+            if (m_speed > 0.0)
+            {
+                const double offsetNs = static_cast<double>(rx.timeNs - tx.timeNs) / m_speed;
+                due += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::nanoseconds(static_cast<long long>(offsetNs)));
+            }
+            m_pending.push_back({ due, &rx, 0 });
+        }
+
+        return static_cast<int>(size);
+    }
+
+    size_t ReplayTransport::BytesArrived(Clock::time_point now) const
+    {
+        size_t bytes = 0;
+        for (const PendingRx& p : m_pending)
+        {
+            if (p.due > now) break;
+            bytes += p.record->data.size() - p.offset;
+        }
+        return bytes;
+    }
+
+    int ReplayTransport::WaitForData(int timeoutMs, size_t minBytes)
+    {
+        if (!m_open) return -1;
+
+        const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true)
+        {
+            const Clock::time_point now = Clock::now();
+            if (BytesArrived(now) >= minBytes) return 1;
+            if (now >= deadline) return 0;
+
+            // Sleep until the next chunk is due (or the timeout)
+            Clock::time_point wake = deadline;
+            for (const PendingRx& p : m_pending)
+            {
+                if (p.due > now)
+                {
+                    if (p.due < wake) wake = p.due;
+                    break;
+                }
+            }
+            SleepUntil(wake);
+        }
+    }
+
+    int ReplayTransport::ReadNow(uint8_t* buffer, size_t size)
+    {
+        if (!m_open) return -1;
+
+        const Clock::time_point now = Clock::now();
+        size_t copied = 0;
+        while (copied < size && !m_pending.empty() && m_pending.front().due <= now)
+        {
+            PendingRx& p = m_pending.front();
+            const size_t n = (std::min)(size - copied, p.record->data.size() - p.offset);
+            std::memcpy(buffer + copied, p.record->data.data() + p.offset, n);
+            copied += n;
+            p.offset += n;
+            if (p.offset == p.record->data.size())
+                m_pending.pop_front();
+        }
+        return static_cast<int>(copied);
+    }
+
+} // namespace FuelMaster
@@ -0,0 +1,89 @@
+// ============================================================
+// ReplayTransport.h — Plays a WireCapture back as a line
+// ============================================================
+// Port name "replay:<capture file>", optionally "?speed=N".
+// The capture is replayed in lockstep with the controller:
+// each Write is matched to the next TX record, and the RX
+// records that followed it in the capture arrive at their
+// recorded offsets from that TX, divided by the speed factor
+// (speed 0 = as fast as possible). A controller running the
+// same FSM therefore sees the same replies with the same
+// relative timing, without hardware. Writes that differ from
+// the recorded TX are counted (GetDivergences); RX recorded
+// before the first TX is skipped.
+// ============================================================
+#pragma once
+
+#include "Transport.h"
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace FuelMaster {
+
+    class ReplayTransport : public Transport
+    {
+    public:
+        ReplayTransport();
+        ~ReplayTransport() override;
+
+        /// True for "replay:..." port names
+        static bool IsReplayPortName(const std::string& portName);
+
+        /// Loads the capture; settings are only recorded
+        bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default()) override;
+        void Close() override;
+        bool IsOpen() const override;
+
+        bool Configure(const SerialSettings& settings) override;
+        void PurgeInput() override;
+
+        /// Playback speed: 1 = recorded timing, 10 = ten times faster,
+        /// 0 = replies available at once. Open resets it to the port
+        /// name's "?speed=N", or 1
+        void SetSpeed(double speed) { m_speed = speed; }
+        double GetSpeed() const { return m_speed; }
+
+        /// Port the capture was taken on
+        std::string GetCapturedPortName() const { return m_capturedPort; }
+
+        size_t GetRecordCount() const { return m_records.size(); }
+        uint64_t GetTxReplayed() const { return m_txReplayed.load(); }
+        uint64_t GetDivergences() const { return m_divergences.load(); }
+
+        /// Every TX record has been replayed
+        bool IsFinished() const { return m_next >= m_records.size(); }
+
+    protected:
+        int Write(const uint8_t* data, size_t size) override;
+        int WaitForData(int timeoutMs, size_t minBytes) override;
+        int ReadNow(uint8_t* buffer, size_t size) override;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct PendingRx
+        {
+            Clock::time_point due;      // when the chunk "arrives"
+            const WireRecord* record;
+            size_t offset;              // bytes already read
+        };
+
+        std::vector<WireRecord> m_records;
+        std::string m_capturedPort;
+        size_t m_next;                  // index of the next record to replay
+        std::deque<PendingRx> m_pending;
+        double m_speed;
+        bool m_open;
+
+        std::atomic<uint64_t> m_txReplayed;
+        std::atomic<uint64_t> m_divergences;
+
+        /// Bytes of pending chunks already due at `now`
+        size_t BytesArrived(Clock::time_point now) const;
+    };
+
+} // namespace FuelMaster
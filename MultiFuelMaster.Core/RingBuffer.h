@@ -0,0 +1,62 @@
+// ============================================================
+// RingBuffer.h — Fixed-capacity byte ring (no heap allocation)
+// ============================================================
+// Receive path storage: the backend reads straight into the
+// free region (WritableSpan / Commit), the decoder consumes
+// from the readable region (ReadableSpan / Consume). Bytes not
+// consumed by one exchange stay for the next. Single-threaded
+// (polling thread only).
+// ============================================================
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace FuelMaster {
+
+    template <size_t Capacity>
+    class RingBuffer
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                      "RingBuffer capacity must be a power of two");
+
+    public:
+        size_t size() const { return m_tail - m_head; }
+        bool empty() const { return m_tail == m_head; }
+        static constexpr size_t capacity() { return Capacity; }
+
+        void Clear() { m_head = m_tail = 0; }
+
+        /// Contiguous free region at the write position
+        std::span<uint8_t> WritableSpan()
+        {
+            size_t pos = m_tail & (Capacity - 1);
+            size_t free = Capacity - size();
+            size_t contiguous = Capacity - pos;
+            return { m_data.data() + pos, free < contiguous ? free : contiguous };
+        }
+
+        /// Mark `count` bytes of WritableSpan() as filled
+        void Commit(size_t count) { m_tail += count; }
+
+        /// Contiguous filled region at the read position
+        std::span<const uint8_t> ReadableSpan() const
+        {
+            size_t pos = m_head & (Capacity - 1);
+            size_t used = size();
+            size_t contiguous = Capacity - pos;
+            return { m_data.data() + pos, used < contiguous ? used : contiguous };
+        }
+
+        /// Drop `count` bytes from the read position
+        void Consume(size_t count) { m_head += (count < size()) ? count : size(); }
+
+    private:
+        std::array<uint8_t, Capacity> m_data{};
+        size_t m_head = 0;  // read counter (monotonic)
+        size_t m_tail = 0;  // write counter (monotonic)
+    };
+
+} // namespace FuelMaster
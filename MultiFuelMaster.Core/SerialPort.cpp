@@ -1,25 +1,43 @@
 // ============================================================
-// SerialPort.cpp — COM-port (v5 — improved frame reception)
+// SerialPort.cpp — COM-port (overlapped I/O, per-adapter latency)
 // ============================================================
-// Key fixes v5:
-// 1. Increased interByteTimeout to 20ms (instead of 3ms) — Windows USB-UART
-//    can group bytes into packets with 5-16ms delay between packets
-// 2. Accumulate data in buffer and read until we receive valid frame
-//    or total timeout expires
-// 3. Removed dependency on inter-byte timeout as the only
-//    end-of-frame criterion
+// 1. Frame accumulation / end-of-frame detection live in Transport
+// 2. Overlapped I/O: WaitCommEvent(EV_RXCHAR) wakes the polling
+//    thread when bytes arrive instead of blocking ReadFile calls;
+//    EV_TXEMPTY marks the end of transmission (response timer start)
+// 3. USB-UART adapters deliver a reply in packets up to their
+//    latency timer apart. SetupAPI tells a native UART from an
+//    FTDI / CH340 / PL2303 dongle at Open; the identified adapter's
+//    latency is added to the reply budget and to the RX gap limit
+//    (interByteTimeoutMs, 3ms by default), so only dongles pay it
 // ============================================================
 
 #include "pch.h"
 #include "SerialPort.h"
-#include <sstream>
+
+#if defined(_WIN32)
+
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <sstream>
+#include <initguid.h>
+#include <devguid.h>        // GUID_DEVCLASS_PORTS
+#include <SetupAPI.h>
+#pragma comment(lib, "setupapi.lib")
 
 namespace FuelMaster {
 
     SerialPort::SerialPort()
         : m_handle(INVALID_HANDLE_VALUE)
         , m_isOpen(false)
+        , m_readOv{}
+        , m_writeOv{}
+        , m_waitOv{}
+        , m_eventMask(0)
+        , m_waitPending(false)
+        , m_txEmpty(false)
     {
     }
 
@@ -28,7 +46,7 @@ namespace FuelMaster {
         Close();
     }
 
-    bool SerialPort::Open(const std::string& portName, int baudRate)
+    bool SerialPort::Open(const std::string& portName, const SerialSettings& settings)
     {
         if (m_isOpen) Close();
         m_portName = portName;
@@ -38,7 +56,7 @@ namespace FuelMaster {
         m_handle = CreateFileA(
             fullName.c_str(),
             GENERIC_READ | GENERIC_WRITE,
-            0, nullptr, OPEN_EXISTING, 0, nullptr);
+            0, nullptr, OPEN_EXISTING, FILE_FLAG_OVERLAPPED, nullptr);
 
         if (m_handle == INVALID_HANDLE_VALUE)
         {
@@ -49,13 +67,28 @@ namespace FuelMaster {
             return false;
         }
 
-        if (!ConfigurePort(baudRate))
+        if (!ConfigurePort(settings))
+        {
+            Close();
+            return false;
+        }
+
+        // Manual-reset events for the overlapped operations
+        m_readOv.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        m_writeOv.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        m_waitOv.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+        if (!m_readOv.hEvent || !m_writeOv.hEvent || !m_waitOv.hEvent ||
+            !SetCommMask(m_handle, EV_RXCHAR | EV_TXEMPTY))
         {
+            m_lastError = "Cannot set up RX events";
             Close();
             return false;
         }
 
+        IdentifyAdapter();
+
         PurgeComm(m_handle, PURGE_RXCLEAR | PURGE_TXCLEAR);
+        m_waitPending = false;
         m_isOpen = true;
         m_lastError = "";
         return true;
@@ -65,139 +98,202 @@ namespace FuelMaster {
     {
         if (m_handle != INVALID_HANDLE_VALUE)
         {
+            if (m_waitPending)
+            {
+                // Clearing the mask completes the armed WaitCommEvent
+                SetCommMask(m_handle, 0);
+                CancelIo(m_handle);
+                DWORD unused = 0;
+                GetOverlappedResult(m_handle, &m_waitOv, &unused, TRUE);
+                m_waitPending = false;
+            }
             CloseHandle(m_handle);
             m_handle = INVALID_HANDLE_VALUE;
         }
+        CloseEvents();
         m_isOpen = false;
     }
 
+    void SerialPort::CloseEvents()
+    {
+        for (OVERLAPPED* ov : { &m_readOv, &m_writeOv, &m_waitOv })
+        {
+            if (ov->hEvent)
+                CloseHandle(ov->hEvent);
+            *ov = {};
+        }
+    }
+
     bool SerialPort::IsOpen() const
     {
         return m_isOpen;
     }
 
+    bool SerialPort::Configure(const SerialSettings& settings)
+    {
+        if (!m_isOpen) return false;
+        if (!ConfigurePort(settings)) return false;
+
+        // Bytes received at the old rate are garbage at the new one
+        PurgeComm(m_handle, PURGE_RXCLEAR | PURGE_TXCLEAR);
+        return true;
+    }
+
     // ============================================================
-    // Set read timeouts
+    // READ
+    // WaitCommEvent(EV_RXCHAR) is armed once and waited on with
+    // WaitForSingleObject; a timed-out wait stays armed for the
+    // next call. Reads run with MAXDWORD interval / zero totals,
+    // so ReadFile returns at once with what the driver holds.
     // ============================================================
 
-    void SerialPort::SetReadTimeouts(int totalTimeoutMs, int interByteTimeoutMs)
+    bool SerialPort::QueuedBytes(DWORD& count)
     {
-        COMMTIMEOUTS timeouts = {};
-        timeouts.ReadIntervalTimeout = interByteTimeoutMs;
-        timeouts.ReadTotalTimeoutMultiplier = 0;
-        timeouts.ReadTotalTimeoutConstant = totalTimeoutMs;
-        timeouts.WriteTotalTimeoutMultiplier = 0;
-        timeouts.WriteTotalTimeoutConstant = 100;
-        SetCommTimeouts(m_handle, &timeouts);
+        DWORD txCount = 0;
+        return QueuedBytes(count, txCount);
     }
 
-    // ============================================================
-    // SEND AND RECEIVE RESPONSE
-    // ============================================================
+    bool SerialPort::QueuedBytes(DWORD& rxCount, DWORD& txCount)
+    {
+        DWORD errors = 0;
+        COMSTAT stat = {};
+        if (!ClearCommError(m_handle, &errors, &stat))
+        {
+            m_lastError = "ClearCommError failed (error " + std::to_string(::GetLastError()) + ")";
+            return false;
+        }
+        rxCount = stat.cbInQue;
+        txCount = stat.cbOutQue;
+        return true;
+    }
 
-    std::vector<uint8_t> SerialPort::SendAndReceive(
-        const std::vector<uint8_t>& command,
-        int responseTimeoutMs,
-        int interByteTimeoutMs,
-        bool forceBufferClear)
+    int SerialPort::WaitForData(int timeoutMs, size_t minBytes)
     {
-        if (!m_isOpen) return {};
+        if (!m_isOpen) return -1;
 
-        // 1. Clear input buffer (if enabled)
-        if (forceBufferClear)
-            PurgeInput();
+        // EV_RXCHAR fires per driver receive event; keep the decode
+        // pass asleep until the bytes the decoder needs are queued
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true)
+        {
+            DWORD queued = 0;
+            if (!QueuedBytes(queued)) return -1;
+            if (queued > 0 && queued >= minBytes) return 1;
 
-        // 2. Send command
-        if (Write(command) == 0)
-            return {};
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0) return 0;
 
-        // 3. Read response - Windows itself waits for first byte up to responseTimeoutMs,
-        //    then reads while pause < interByteTimeoutMs
-        return ReadAvailable(64, responseTimeoutMs, interByteTimeoutMs);
+            int result = WaitRxEvent(static_cast<DWORD>(remaining));
+            if (result <= 0) return result;
+        }
     }
 
-    // ============================================================
-    // IMPROVED TIMEOUT READ (v5)
-    // Key change: read data in chunks and accumulate in buffer,
-    //until we get complete frame or total timeout expires.
-    // This solves the packet fragmentation problem on USB-UART adapters.
-    // ============================================================
-
-    std::vector<uint8_t> SerialPort::ReadAvailable(int maxBytes, int totalTimeoutMs, int interByteTimeoutMs)
+    int SerialPort::WaitRxEvent(DWORD timeoutMs, bool rxShortcut)
     {
-        // Configure Windows timeouts:
-        // ReadIntervalTimeout = interByteTimeoutMs - pause between bytes = "silence" indicator
-        // ReadTotalTimeoutConstant = totalTimeoutMs - total wait timeout
-        SetReadTimeouts(totalTimeoutMs, interByteTimeoutMs);
+        if (!m_waitPending)
+        {
+            m_eventMask = 0;
+            ResetEvent(m_waitOv.hEvent);
+            if (WaitCommEvent(m_handle, &m_eventMask, &m_waitOv))
+            {
+                if (m_eventMask & EV_TXEMPTY) m_txEmpty = true;
+                return 1;   // completed synchronously
+            }
+            if (::GetLastError() != ERROR_IO_PENDING)
+            {
+                m_lastError = "WaitCommEvent failed (error " + std::to_string(::GetLastError()) + ")";
+                return -1;
+            }
+            m_waitPending = true;
 
-        std::vector<uint8_t> accumulatedBuffer;
-        accumulatedBuffer.reserve(64); // Minimum size for typical frame
+            // Bytes that arrived between the queue check and arming the
+            // wait; the caller re-checks the count
+            DWORD queued = 0;
+            if (rxShortcut && !QueuedBytes(queued)) return -1;
+            if (queued > 0) return 1;
+        }
 
-        auto startTime = std::chrono::steady_clock::now();
+        DWORD result = WaitForSingleObject(m_waitOv.hEvent, timeoutMs);
+        if (result == WAIT_TIMEOUT)
+            return 0;   // the wait stays armed for the next call
 
-        while (true)
+        m_waitPending = false;
+        DWORD unused = 0;
+        if (result != WAIT_OBJECT_0 || !GetOverlappedResult(m_handle, &m_waitOv, &unused, FALSE))
         {
-            // Read available data
-            std::vector<uint8_t> chunk(maxBytes);
-            DWORD bytesRead = 0;
-
-            BOOL success = ReadFile(
-                m_handle,
-                chunk.data(),
-                (DWORD)maxBytes,
-                &bytesRead,
-                nullptr);
+            m_lastError = "RX wait failed (error " + std::to_string(::GetLastError()) + ")";
+            return -1;
+        }
+        if (m_eventMask & EV_TXEMPTY) m_txEmpty = true;
+        return 1;
+    }
 
-            if (success && bytesRead > 0)
-            {
-                // Add received data to buffer
-                chunk.resize(bytesRead);
-                accumulatedBuffer.insert(accumulatedBuffer.end(), chunk.begin(), chunk.end());
-
-                // Check minimum frame size:
-                // STX(1) + ADDR_HI(1) + ADDR_LO(1) + CMD(1) + DATA + CRC(1) = minimum ~7 bytes
-                // For L/R commands (volume/sum) minimum 14-15 bytes
-                // Wait at least 14 bytes to get complete response frame for LM/RS
-                if (accumulatedBuffer.size() >= 14)
-                {
-                    // Enough data - return accumulated buffer
-                    return accumulatedBuffer;
-                }
-            }
+    int SerialPort::ReadNow(uint8_t* buffer, size_t size)
+    {
+        if (!m_isOpen) return -1;
 
-            // Check total timeout
-            auto elapsed = std::chrono::steady_clock::now() - startTime;
-            auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        DWORD queued = 0;
+        if (!QueuedBytes(queued)) return -1;
+        if (queued == 0) return 0;
 
-            if (elapsedMs >= totalTimeoutMs)
+        DWORD toRead = queued < size ? queued : static_cast<DWORD>(size);
+        DWORD bytesRead = 0;
+        ResetEvent(m_readOv.hEvent);
+        if (!ReadFile(m_handle, buffer, toRead, &bytesRead, &m_readOv))
+        {
+            if (::GetLastError() != ERROR_IO_PENDING ||
+                !GetOverlappedResult(m_handle, &m_readOv, &bytesRead, TRUE))
             {
-                // Timeout expired - return what we have (may be empty)
-                break;
+                m_lastError = "ReadFile failed (error " + std::to_string(::GetLastError()) + ")";
+                return -1;
             }
-
-            // Small pause before next read attempt
-            // This gives USB-UART driver time to collect data into packet
-            Sleep(1);
         }
-
-        // Return accumulated data (may be empty on timeout)
-        return accumulatedBuffer;
+        return static_cast<int>(bytesRead);
     }
 
     // ============================================================
     // WRITE
     // ============================================================
 
-    int SerialPort::Write(const std::vector<uint8_t>& data)
+    int SerialPort::Write(const uint8_t* data, size_t size)
     {
-        if (!m_isOpen || data.empty()) return 0;
+        if (!m_isOpen || size == 0) return 0;
 
         DWORD bytesWritten = 0;
-        BOOL success = WriteFile(
-            m_handle, data.data(), (DWORD)data.size(),
-            &bytesWritten, nullptr);
+        m_txEmpty = false;
+        ResetEvent(m_writeOv.hEvent);
+        if (!WriteFile(m_handle, data, (DWORD)size, &bytesWritten, &m_writeOv))
+        {
+            // Completion is bounded by WriteTotalTimeoutConstant
+            if (::GetLastError() != ERROR_IO_PENDING ||
+                !GetOverlappedResult(m_handle, &m_writeOv, &bytesWritten, TRUE))
+                return 0;
+        }
+        return static_cast<int>(bytesWritten);
+    }
 
-        return success ? static_cast<int>(bytesWritten) : 0;
+    bool SerialPort::DrainTx(int timeoutMs)
+    {
+        if (!m_isOpen) return false;
+
+        // WriteFile completes once the bytes are in the driver; EV_TXEMPTY
+        // (via the same armed wait as RX) once the last one left the UART.
+        // An RX event meanwhile (echo, early reply) just loops.
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true)
+        {
+            DWORD rxQueued = 0, txQueued = 0;
+            if (!QueuedBytes(rxQueued, txQueued)) return false;
+            if (m_txEmpty && txQueued == 0) return true;
+
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0) return false;
+
+            if (WaitRxEvent(static_cast<DWORD>(remaining), false) <= 0)
+                return false;
+        }
     }
 
     // ============================================================
@@ -214,7 +310,7 @@ namespace FuelMaster {
     // PORT CONFIGURATION
     // ============================================================
 
-    bool SerialPort::ConfigurePort(int baudRate)
+    bool SerialPort::ConfigurePort(const SerialSettings& settings)
     {
         DCB dcb = {};
         dcb.DCBlength = sizeof(DCB);
@@ -225,17 +321,24 @@ namespace FuelMaster {
             return false;
         }
 
-        // GasKitLink: 9600, 8N1
-        dcb.BaudRate = baudRate;
-        dcb.ByteSize = 8;
-        dcb.Parity = NOPARITY;
-        dcb.StopBits = ONESTOPBIT;
+        // GasKitLink: 9600, 8N1 by default
+        dcb.BaudRate = settings.baudRate;
+        dcb.ByteSize = static_cast<BYTE>(settings.dataBits);
+        switch (settings.parity)
+        {
+        case Parity::Odd:  dcb.Parity = ODDPARITY; break;
+        case Parity::Even: dcb.Parity = EVENPARITY; break;
+        default:           dcb.Parity = NOPARITY; break;
+        }
+        dcb.fParity = (settings.parity != Parity::None) ? TRUE : FALSE;
+        dcb.StopBits = (settings.stopBits == 2) ? TWOSTOPBITS : ONESTOPBIT;
 
         // Disable flow control
         dcb.fOutxCtsFlow = FALSE;
         dcb.fOutxDsrFlow = FALSE;
         dcb.fDtrControl = DTR_CONTROL_ENABLE;
-        dcb.fRtsControl = RTS_CONTROL_ENABLE;
+        // Receive-only: RTS low keeps an RTS-keyed RS-485 driver off the bus
+        dcb.fRtsControl = IsReceiveOnly() ? RTS_CONTROL_DISABLE : RTS_CONTROL_ENABLE;
         dcb.fOutX = FALSE;
         dcb.fInX = FALSE;
 
@@ -245,7 +348,121 @@ namespace FuelMaster {
             return false;
         }
 
+        // Reads never wait in the driver (waiting is WaitCommEvent's job):
+        // MAXDWORD interval + zero totals = return at once with what is queued
+        COMMTIMEOUTS timeouts = {};
+        timeouts.ReadIntervalTimeout = MAXDWORD;
+        timeouts.ReadTotalTimeoutMultiplier = 0;
+        timeouts.ReadTotalTimeoutConstant = 0;
+        timeouts.WriteTotalTimeoutMultiplier = 0;
+        timeouts.WriteTotalTimeoutConstant = 100;
+        if (!SetCommTimeouts(m_handle, &timeouts))
+        {
+            m_lastError = "Cannot set port timeouts";
+            return false;
+        }
+
+        m_settings = settings;
         return true;
     }
 
+    // ============================================================
+    // ADAPTER
+    // Hardware IDs: "USB\VID_1A86&PID_7523", "FTDIBUS\VID_0403+PID_6001",
+    // "ACPI\PNP0501" (on-board 16550), "PCI\VEN_..." (UART card).
+    // FTDI's VCP driver keeps the latency timer in the device key;
+    // changing it needs elevation and a replug, so it is only read.
+    // ============================================================
+
+    namespace
+    {
+        /// Hex value after `tag` in a hardware ID (-1 if absent)
+        long HardwareIdField(const std::string& hardwareId, const char* tag)
+        {
+            const size_t at = hardwareId.find(tag);
+            if (at == std::string::npos) return -1;
+            return std::strtol(hardwareId.c_str() + at + std::strlen(tag), nullptr, 16);
+        }
+    } // anonymous namespace
+
+    void SerialPort::IdentifyAdapter()
+    {
+        m_adapter = AdapterOfKind(AdapterKind::Unknown);
+
+        HDEVINFO devices = SetupDiGetClassDevsA(&GUID_DEVCLASS_PORTS, nullptr, nullptr, DIGCF_PRESENT);
+        if (devices == INVALID_HANDLE_VALUE) return;
+
+        SP_DEVINFO_DATA device = {};
+        device.cbSize = sizeof(device);
+        for (DWORD index = 0; SetupDiEnumDeviceInfo(devices, index, &device); index++)
+        {
+            HKEY key = SetupDiOpenDevRegKey(devices, &device, DICS_FLAG_GLOBAL, 0, DIREG_DEV, KEY_READ);
+            if (key == INVALID_HANDLE_VALUE) continue;
+
+            char name[64] = {};
+            DWORD type = 0;
+            DWORD size = sizeof(name) - 1;
+            const bool ours = RegQueryValueExA(key, "PortName", nullptr, &type,
+                reinterpret_cast<LPBYTE>(name), &size) == ERROR_SUCCESS &&
+                type == REG_SZ && _stricmp(name, m_portName.c_str()) == 0;
+
+            DWORD latencyTimer = 0;
+            size = sizeof(latencyTimer);
+            const bool hasLatencyTimer = ours && RegQueryValueExA(key, "LatencyTimer", nullptr, &type,
+                reinterpret_cast<LPBYTE>(&latencyTimer), &size) == ERROR_SUCCESS && type == REG_DWORD;
+            RegCloseKey(key);
+            if (!ours) continue;
+
+            // REG_MULTI_SZ, most specific ID first
+            char ids[512] = {};
+            SetupDiGetDeviceRegistryPropertyA(devices, &device, SPDRP_HARDWAREID, nullptr,
+                reinterpret_cast<PBYTE>(ids), sizeof(ids) - 2, nullptr);
+            const std::string hardwareId = ids;
+
+            const long vendorId = HardwareIdField(hardwareId, "VID_");
+            const long productId = HardwareIdField(hardwareId, "PID_");
+            AdapterInfo info = AdapterOfKind(AdapterKind::Unknown);
+            if (vendorId > 0)
+            {
+                info = AdapterFromUsbId(static_cast<uint16_t>(vendorId),
+                    static_cast<uint16_t>(productId > 0 ? productId : 0));
+                if (info.kind == AdapterKind::UsbOther &&
+                    hardwareId.find("Class_02") != std::string::npos)
+                {
+                    info.kind = AdapterKind::CdcAcm;
+                    info.latencyMs = AdapterOfKind(AdapterKind::CdcAcm).latencyMs;
+                }
+            }
+            else if (hardwareId.rfind("ACPI\\", 0) == 0 || hardwareId.rfind("PCI\\", 0) == 0 ||
+                hardwareId.find("PNP0501") != std::string::npos)
+            {
+                info = AdapterOfKind(AdapterKind::Native);
+            }
+
+            char friendlyName[256] = {};
+            if (SetupDiGetDeviceRegistryPropertyA(devices, &device, SPDRP_FRIENDLYNAME, nullptr,
+                reinterpret_cast<PBYTE>(friendlyName), sizeof(friendlyName) - 1, nullptr))
+            {
+                info.driver = friendlyName;
+            }
+
+            if (info.kind == AdapterKind::Ftdi && hasLatencyTimer && latencyTimer > 0)
+            {
+                info.latencyMs = static_cast<int>(latencyTimer);
+                if (info.latencyMs > FTDI_LOW_LATENCY_MS)
+                {
+                    info.hint = "set Latency Timer to " + std::to_string(FTDI_LOW_LATENCY_MS) +
+                        " ms in the port's Advanced settings (Device Manager) for faster replies";
+                }
+            }
+
+            m_adapter = info;
+            break;
+        }
+
+        SetupDiDestroyDeviceInfoList(devices);
+    }
+
 } // namespace FuelMaster
+
+#endif // _WIN32
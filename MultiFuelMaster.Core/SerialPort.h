@@ -1,62 +1,78 @@
 // ============================================================
-// SerialPort.h — COM-port (v4 — request-response model)
+// SerialPort.h — COM-port (Win32 backend of Transport)
+// ============================================================
+// The port is opened overlapped: RX waits are
+// WaitCommEvent(EV_RXCHAR) on an event handle, reads only drain
+// what the driver already holds; the same wait reports
+// EV_TXEMPTY for DrainTx. The adapter is identified through
+// SetupAPI at Open (see AdapterProfile.h); its latency widens
+// the RX gap limit Transport applies inside a reply.
+// Request/response logic lives in Transport.
 // ============================================================
 #pragma once
 
-#include <cstdint>
-#include <vector>
-#include <string>
+#include "Transport.h"
+
+#if defined(_WIN32)
 
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 
 namespace FuelMaster {
 
-    class SerialPort
+    class SerialPort : public Transport
     {
     public:
         SerialPort();
-        ~SerialPort();
-
-        SerialPort(const SerialPort&) = delete;
-        SerialPort& operator=(const SerialPort&) = delete;
-
-        bool Open(const std::string& portName, int baudRate = 9600);
-        void Close();
-        bool IsOpen() const;
-
-        /// Send command and get full response.
-        /// Algorithm:
-        /// 1. Clear input buffer (if forceBufferClear = true)
-        /// 2. Send command
-        /// 3. Wait for data with responseTimeoutMs timeout
-        /// 4. After first byte - read remaining with interByteTimeoutMs
-        /// 5. Return full frame (or empty vector if timeout)
-        std::vector<uint8_t> SendAndReceive(const std::vector<uint8_t>& command,
-            int responseTimeoutMs,
-            int interByteTimeoutMs,
-            bool forceBufferClear = true);
+        ~SerialPort() override;
+
+        bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default()) override;
+        void Close() override;
+        bool IsOpen() const override;
+        bool Configure(const SerialSettings& settings) override;
 
         /// Clear input buffer
-        void PurgeInput();
+        void PurgeInput() override;
 
-        std::string GetPortName() const { return m_portName; }
-        std::string GetLastError() const { return m_lastError; }
+    protected:
+        int Write(const uint8_t* data, size_t size) override;
+        bool DrainTx(int timeoutMs) override;
+        int WaitForData(int timeoutMs, size_t minBytes) override;
+        int ReadNow(uint8_t* buffer, size_t size) override;
+        bool IsHotPluggable() const override { return true; }
 
     private:
         HANDLE m_handle;
-        std::string m_portName;
-        std::string m_lastError;
         bool m_isOpen;
 
-        bool ConfigurePort(int baudRate);
-        int Write(const std::vector<uint8_t>& data);
+        // Overlapped state (one event per operation kind)
+        OVERLAPPED m_readOv;
+        OVERLAPPED m_writeOv;
+        OVERLAPPED m_waitOv;
+        DWORD m_eventMask;          // filled by WaitCommEvent
+        bool m_waitPending;         // WaitCommEvent armed, not completed yet
+        bool m_txEmpty;             // EV_TXEMPTY seen since the last Write
+
+        bool ConfigurePort(const SerialSettings& settings);
 
-        /// Set read timeouts
-        void SetReadTimeouts(int totalTimeoutMs, int interByteTimeoutMs);
+        /// Bytes in the driver RX / TX queues (false on a device error)
+        bool QueuedBytes(DWORD& count);
+        bool QueuedBytes(DWORD& rxCount, DWORD& txCount);
 
-        /// Read available bytes (up to maxBytes)
-        std::vector<uint8_t> ReadAvailable(int maxBytes, int totalTimeoutMs, int interByteTimeoutMs);
+        /// One armed WaitCommEvent wait: 1 on EV_RXCHAR / EV_TXEMPTY,
+        /// 0 on timeout, <0 on error. rxShortcut: return 1 at once if
+        /// RX bytes are already queued when the wait is armed.
+        int WaitRxEvent(DWORD timeoutMs, bool rxShortcut = true);
+
+        void CloseEvents();
+
+        /// Fill m_adapter from SetupAPI: the Ports-class device whose
+        /// PortName is ours, its hardware ID (USB VID/PID, ACPI UART)
+        /// and, for FTDI, the LatencyTimer of its Device Parameters
+        void IdentifyAdapter();
     };
 
 } // namespace FuelMaster
+
+#endif // _WIN32
@@ -0,0 +1,74 @@
+// ============================================================
+// SerialSettings.h — Line speed and framing of a post
+// ============================================================
+// GasKitLink posts run 9600 8N1 by default; some firmware
+// supports faster rates. Wire-time helpers let timeouts that
+// were tuned at 9600 8N1 follow the actual line speed.
+// ============================================================
+#pragma once
+
+#include <cstddef>
+
+namespace FuelMaster {
+
+    enum class Parity : int
+    {
+        None = 0,
+        Odd = 1,
+        Even = 2
+    };
+
+    struct SerialSettings
+    {
+        int baudRate;       // bits per second
+        int dataBits;       // 5..8
+        Parity parity;
+        int stopBits;       // 1 or 2
+        bool autoBaud;      // probe AUTO_BAUD_CANDIDATES at Connect, keep the fastest clean one
+
+        static SerialSettings Default()
+        {
+            return SerialSettings{
+                9600,           // baudRate - GasKitLink default
+                8,              // dataBits
+                Parity::None,   // parity
+                1,              // stopBits
+                false           // autoBaud
+            };
+        }
+
+        /// Bits on the wire per byte: start + data + parity + stop
+        int BitsPerByte() const
+        {
+            return 1 + dataBits + (parity != Parity::None ? 1 : 0) + stopBits;
+        }
+
+        /// Time `bytes` take on the wire, in microseconds
+        long long WireTimeUs(size_t bytes) const
+        {
+            if (baudRate <= 0) return 0;
+            return static_cast<long long>(bytes) * BitsPerByte() * 1000000LL / baudRate;
+        }
+
+        /// Timeout tuned at 9600 8N1 for an exchange of `wireBytes`
+        /// (request + reply), rescaled to this line speed: the wire-time
+        /// share follows the baud rate, the dispenser's turnaround stays
+        int ScaleTimeoutMs(int timeoutAt9600Ms, size_t wireBytes) const
+        {
+            const long long reference = Default().WireTimeUs(wireBytes);
+            const long long actual = WireTimeUs(wireBytes);
+            const long long scaledUs = timeoutAt9600Ms * 1000LL - reference + actual;
+
+            // Never below the wire time itself plus a few ms of turnaround
+            const long long floorUs = actual + 5000;
+            const long long us = scaledUs > floorUs ? scaledUs : floorUs;
+            return static_cast<int>((us + 999) / 1000);
+        }
+
+        bool operator==(const SerialSettings&) const = default;
+    };
+
+    /// Rates tried by auto-baud, fastest first
+    inline constexpr int AUTO_BAUD_CANDIDATES[] = { 115200, 57600, 38400, 19200, 9600 };
+
+} // namespace FuelMaster
@@ -0,0 +1,599 @@
+// ============================================================
+// TcpTransport.cpp — Ethernet serial server backend (TCP)
+// ============================================================
+
+#include "pch.h"
+#include "TcpTransport.h"
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#if defined(_MSC_VER)
+#pragma comment(lib, "Ws2_32.lib")
+#endif
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "PreciseWait.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace FuelMaster {
+
+    namespace
+    {
+        // ============================================================
+        // Socket API differences (Winsock / BSD sockets)
+        // ============================================================
+#if defined(_WIN32)
+        using NativeSocket = SOCKET;
+        const NativeSocket BAD_SOCKET = INVALID_SOCKET;
+        using PollFd = WSAPOLLFD;
+        constexpr int SEND_FLAGS = 0;
+
+        int SocketError() { return WSAGetLastError(); }
+        bool WouldBlock(int err) { return err == WSAEWOULDBLOCK; }
+        bool Interrupted(int err) { return err == WSAEINTR; }
+        void CloseNative(NativeSocket s) { closesocket(s); }
+        int PollNative(PollFd* fd, int timeoutMs) { return WSAPoll(fd, 1, timeoutMs); }
+
+        bool SetNonBlocking(NativeSocket s)
+        {
+            u_long on = 1;
+            return ioctlsocket(s, FIONBIO, &on) == 0;
+        }
+
+        size_t BytesAvailable(NativeSocket s)
+        {
+            u_long n = 0;
+            return ioctlsocket(s, FIONREAD, &n) == 0 ? static_cast<size_t>(n) : 0;
+        }
+#else
+        using NativeSocket = int;
+        const NativeSocket BAD_SOCKET = -1;
+        using PollFd = pollfd;
+        constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+
+        int SocketError() { return errno; }
+        bool WouldBlock(int err) { return err == EAGAIN || err == EWOULDBLOCK || err == EINPROGRESS; }
+        bool Interrupted(int err) { return err == EINTR; }
+        void CloseNative(NativeSocket s) { ::close(s); }
+        int PollNative(PollFd* fd, int timeoutMs) { return ::poll(fd, 1, timeoutMs); }
+
+        bool SetNonBlocking(NativeSocket s)
+        {
+            int flags = fcntl(s, F_GETFL, 0);
+            return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+        }
+
+        size_t BytesAvailable(NativeSocket s)
+        {
+            int n = 0;
+            return ioctl(s, FIONREAD, &n) == 0 && n > 0 ? static_cast<size_t>(n) : 0;
+        }
+#endif
+
+        // ============================================================
+        // Telnet / RFC 2217 constants
+        // ============================================================
+        constexpr uint8_t IAC = 255;
+        constexpr uint8_t DONT = 254;
+        constexpr uint8_t DO = 253;
+        constexpr uint8_t WONT = 252;
+        constexpr uint8_t WILL = 251;
+        constexpr uint8_t SB = 250;
+        constexpr uint8_t SE = 240;
+
+        constexpr uint8_t OPT_BINARY = 0;
+        constexpr uint8_t OPT_SGA = 3;
+        constexpr uint8_t OPT_COM_PORT = 44;
+
+        // COM-PORT-OPTION client commands
+        constexpr uint8_t CPO_SET_BAUDRATE = 1;
+        constexpr uint8_t CPO_SET_DATASIZE = 2;
+        constexpr uint8_t CPO_SET_PARITY = 3;
+        constexpr uint8_t CPO_SET_STOPSIZE = 4;
+        constexpr uint8_t CPO_SET_CONTROL = 5;
+        constexpr uint8_t CPO_PURGE_DATA = 12;
+
+        constexpr int CONNECT_TIMEOUT_MS = 3000;
+        constexpr int SEND_TIMEOUT_MS = 100;    // same budget as the serial write timeout
+
+        bool StartsWith(const std::string& s, const char* prefix)
+        {
+            return s.compare(0, std::strlen(prefix), prefix) == 0;
+        }
+    } // anonymous namespace
+
+    TcpTransport::TcpTransport(Mode mode)
+        : m_socket(static_cast<SocketHandle>(BAD_SOCKET))
+        , m_mode(mode)
+        , m_quickAck(false)
+        , m_lowWater(1)
+        , m_telnetState(TelnetState::Data)
+        , m_telnetVerb(0)
+    {
+#if defined(_WIN32)
+        WSADATA wsa;
+        WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+    }
+
+    TcpTransport::~TcpTransport()
+    {
+        Close();
+#if defined(_WIN32)
+        WSACleanup();
+#endif
+    }
+
+    bool TcpTransport::IsNetworkPortName(const std::string& portName)
+    {
+        return StartsWith(portName, "tcp://") || StartsWith(portName, "rfc2217://");
+    }
+
+    // ============================================================
+    // OPEN / CLOSE
+    // ============================================================
+
+    bool TcpTransport::Open(const std::string& portName, const SerialSettings& settings)
+    {
+        if (IsOpen()) Close();
+
+        std::string address = portName;
+        if (StartsWith(address, "tcp://"))
+        {
+            m_mode = Mode::Raw;
+            address.erase(0, 6);
+        }
+        else if (StartsWith(address, "rfc2217://"))
+        {
+            m_mode = Mode::Rfc2217;
+            address.erase(0, 10);
+        }
+
+        size_t query = address.find('?');
+        if (query != std::string::npos)
+        {
+            if (address.find("quickack", query) != std::string::npos)
+                m_quickAck = true;
+            address.erase(query);
+        }
+
+        size_t colon = address.rfind(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 == address.size())
+        {
+            m_lastError = "Expected host:port in " + portName;
+            return false;
+        }
+        std::string host = address.substr(0, colon);
+        std::string port = address.substr(colon + 1);
+        if (host.size() > 2 && host.front() == '[' && host.back() == ']')
+            host = host.substr(1, host.size() - 2);  // [IPv6]
+
+        if (!Connect(host, port))
+            return false;
+
+        m_portName = portName;
+        m_telnetState = TelnetState::Data;
+        m_lowWater = 1;
+
+        if (m_mode == Mode::Rfc2217)
+        {
+            // Offer COM-PORT-OPTION, 8-bit clean data both ways, no go-ahead
+            const uint8_t hello[] = {
+                IAC, WILL, OPT_COM_PORT,
+                IAC, WILL, OPT_BINARY, IAC, DO, OPT_BINARY,
+                IAC, WILL, OPT_SGA, IAC, DO, OPT_SGA
+            };
+            if (!SendAll(hello, sizeof(hello)))
+            {
+                m_lastError = "Telnet negotiation failed";
+                Close();
+                return false;
+            }
+        }
+
+        if (!Configure(settings))
+        {
+            Close();
+            return false;
+        }
+
+        // The serial server's own UART and packing timer are not visible from here
+        m_adapter = AdapterOfKind(AdapterKind::Network);
+        m_lastError = "";
+        return true;
+    }
+
+    bool TcpTransport::Connect(const std::string& host, const std::string& port)
+    {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+
+        addrinfo* list = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &list) != 0 || !list)
+        {
+            m_lastError = "Cannot resolve " + host;
+            return false;
+        }
+
+        NativeSocket s = BAD_SOCKET;
+        for (addrinfo* ai = list; ai; ai = ai->ai_next)
+        {
+            s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (s == BAD_SOCKET) continue;
+
+            bool connected = false;
+            if (SetNonBlocking(s))
+            {
+                if (connect(s, ai->ai_addr, static_cast<int>(ai->ai_addrlen)) == 0)
+                {
+                    connected = true;
+                }
+                else if (WouldBlock(SocketError()))
+                {
+                    PollFd pfd = {};
+                    pfd.fd = s;
+                    pfd.events = POLLOUT;
+                    int soError = 0;
+                    socklen_t len = sizeof(soError);
+                    connected = PollNative(&pfd, CONNECT_TIMEOUT_MS) > 0 &&
+                        getsockopt(s, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&soError), &len) == 0 &&
+                        soError == 0;
+                }
+            }
+
+            if (connected) break;
+            CloseNative(s);
+            s = BAD_SOCKET;
+        }
+        freeaddrinfo(list);
+
+        if (s == BAD_SOCKET)
+        {
+            m_lastError = "Cannot connect to " + host + ":" + port;
+            return false;
+        }
+
+        // Request frames are tiny: never hold them back for coalescing
+        int on = 1;
+        setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&on), sizeof(on));
+        setsockopt(s, SOL_SOCKET, SO_KEEPALIVE, reinterpret_cast<const char*>(&on), sizeof(on));
+
+        m_socket = static_cast<SocketHandle>(s);
+        ApplyQuickAck();
+        return true;
+    }
+
+    void TcpTransport::CloseSocket()
+    {
+        if (m_socket != static_cast<SocketHandle>(BAD_SOCKET))
+        {
+            CloseNative(static_cast<NativeSocket>(m_socket));
+            m_socket = static_cast<SocketHandle>(BAD_SOCKET);
+        }
+    }
+
+    void TcpTransport::Close()
+    {
+        CloseSocket();
+    }
+
+    bool TcpTransport::IsOpen() const
+    {
+        return m_socket != static_cast<SocketHandle>(BAD_SOCKET);
+    }
+
+    // ============================================================
+    // LINE SETTINGS
+    // ============================================================
+
+    bool TcpTransport::Configure(const SerialSettings& settings)
+    {
+        if (!IsOpen()) return false;
+
+        if (m_mode == Mode::Rfc2217 && !SendLineSettings(settings))
+        {
+            m_lastError = "Cannot send line settings to the serial server";
+            return false;
+        }
+
+        m_settings = settings;
+        return true;
+    }
+
+    bool TcpTransport::SendLineSettings(const SerialSettings& settings)
+    {
+        const uint32_t baud = static_cast<uint32_t>(settings.baudRate);
+        const uint8_t baudBytes[] = {
+            static_cast<uint8_t>(baud >> 24), static_cast<uint8_t>(baud >> 16),
+            static_cast<uint8_t>(baud >> 8), static_cast<uint8_t>(baud)
+        };
+        const uint8_t dataSize = static_cast<uint8_t>(settings.dataBits);
+        const uint8_t parity = (settings.parity == Parity::Odd) ? 2 :
+                               (settings.parity == Parity::Even) ? 3 : 1;
+        const uint8_t stopSize = (settings.stopBits == 2) ? 2 : 1;
+        const uint8_t noFlowControl = 1;
+
+        return SendComPortCommand(CPO_SET_BAUDRATE, baudBytes, sizeof(baudBytes)) &&
+               SendComPortCommand(CPO_SET_DATASIZE, &dataSize, 1) &&
+               SendComPortCommand(CPO_SET_PARITY, &parity, 1) &&
+               SendComPortCommand(CPO_SET_STOPSIZE, &stopSize, 1) &&
+               SendComPortCommand(CPO_SET_CONTROL, &noFlowControl, 1);
+    }
+
+    bool TcpTransport::SendComPortCommand(uint8_t command, const uint8_t* value, size_t size)
+    {
+        uint8_t buffer[32];
+        size_t n = 0;
+        buffer[n++] = IAC;
+        buffer[n++] = SB;
+        buffer[n++] = OPT_COM_PORT;
+        buffer[n++] = command;
+        for (size_t i = 0; i < size && n + 4 <= sizeof(buffer); i++)
+        {
+            buffer[n++] = value[i];
+            if (value[i] == IAC) buffer[n++] = IAC;
+        }
+        buffer[n++] = IAC;
+        buffer[n++] = SE;
+        return SendAll(buffer, n);
+    }
+
+    // ============================================================
+    // READ
+    // poll() until the socket holds the bytes the decoder still
+    // needs (SO_RCVLOWAT on Linux). Without a low-water mark the
+    // socket polls readable while too few bytes are queued; the
+    // wait then sleeps for the wire time of the missing bytes
+    // instead of polling again at once.
+    // ============================================================
+
+    int TcpTransport::WaitForData(int timeoutMs, size_t minBytes)
+    {
+        if (!IsOpen()) return -1;
+        const NativeSocket s = static_cast<NativeSocket>(m_socket);
+        if (minBytes < 1) minBytes = 1;
+
+#if defined(__linux__)
+        // Telnet escapes only add bytes, so the data threshold is a safe
+        // lower bound for the raw stream in both modes
+        if (minBytes != m_lowWater)
+        {
+            int lowWater = static_cast<int>(minBytes);
+            if (setsockopt(s, SOL_SOCKET, SO_RCVLOWAT, &lowWater, sizeof(lowWater)) == 0)
+                m_lowWater = minBytes;
+        }
+#endif
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (true)
+        {
+            const size_t queued = BytesAvailable(s);
+            if (queued >= minBytes) return 1;
+
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0) return 0;
+
+            // Part of the reply is here: poll() would return at once
+            // unless SO_RCVLOWAT holds it back
+            if (queued > 0 && m_lowWater != minBytes)
+            {
+                const long long sliceUs = std::max(m_settings.WireTimeUs(minBytes - queued), 1000LL);
+                SleepUs(std::min(sliceUs, static_cast<long long>(remaining) * 1000));
+                continue;
+            }
+
+            PollFd pfd = {};
+            pfd.fd = s;
+            pfd.events = POLLIN;
+            int r = PollNative(&pfd, static_cast<int>(remaining));
+            if (r < 0)
+            {
+                if (Interrupted(SocketError())) continue;
+                m_lastError = "poll failed (error " + std::to_string(SocketError()) + ")";
+                return -1;
+            }
+            if (r == 0) return 0;
+
+            // Readable with nothing queued: peer closed or socket error -
+            // ReadNow reports it
+            if ((pfd.revents & (POLLERR | POLLHUP)) || BytesAvailable(s) == 0)
+                return 1;
+        }
+    }
+
+    int TcpTransport::ReadNow(uint8_t* buffer, size_t size)
+    {
+        if (!IsOpen()) return -1;
+
+        int n = recv(static_cast<NativeSocket>(m_socket), reinterpret_cast<char*>(buffer),
+            static_cast<int>(size), 0);
+        if (n > 0)
+        {
+            if (m_quickAck) ApplyQuickAck();
+            if (m_mode == Mode::Rfc2217)
+                return static_cast<int>(FilterTelnet(buffer, static_cast<size_t>(n)));
+            return n;
+        }
+
+        if (n < 0)
+        {
+            int err = SocketError();
+            if (WouldBlock(err) || Interrupted(err)) return 0;
+            m_lastError = "recv failed (error " + std::to_string(err) + ")";
+        }
+        else
+        {
+            m_lastError = "Connection closed by the serial server";
+        }
+        CloseSocket();
+        return -1;
+    }
+
+    size_t TcpTransport::FilterTelnet(uint8_t* buffer, size_t size)
+    {
+        // Refuse everything but the options offered in Open; accepted ones
+        // need no answer (our WILL/DO already went out)
+        auto answerOption = [this](uint8_t verb, uint8_t option) {
+            if (option == OPT_BINARY || option == OPT_SGA || option == OPT_COM_PORT) return;
+            if (verb == DO || verb == WILL)
+            {
+                const uint8_t refusal[] = { IAC, static_cast<uint8_t>(verb == DO ? WONT : DONT), option };
+                SendAll(refusal, sizeof(refusal));
+            }
+        };
+
+        size_t out = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            const uint8_t b = buffer[i];
+            switch (m_telnetState)
+            {
+            case TelnetState::Data:
+                if (b == IAC) m_telnetState = TelnetState::Iac;
+                else buffer[out++] = b;
+                break;
+
+            case TelnetState::Iac:
+                if (b == IAC)
+                {
+                    buffer[out++] = IAC;    // escaped 0xFF data byte
+                    m_telnetState = TelnetState::Data;
+                }
+                else if (b >= WILL && b <= DONT)
+                {
+                    m_telnetVerb = b;
+                    m_telnetState = TelnetState::Option;
+                }
+                else if (b == SB)
+                {
+                    m_telnetState = TelnetState::Sub;
+                }
+                else
+                {
+                    m_telnetState = TelnetState::Data;  // NOP, GA, ...
+                }
+                break;
+
+            case TelnetState::Option:
+                answerOption(m_telnetVerb, b);
+                m_telnetState = TelnetState::Data;
+                break;
+
+            case TelnetState::Sub:
+                // Server notifications (line state, baud echo) - not used
+                if (b == IAC) m_telnetState = TelnetState::SubIac;
+                break;
+
+            case TelnetState::SubIac:
+                m_telnetState = (b == SE) ? TelnetState::Data : TelnetState::Sub;
+                break;
+            }
+        }
+        return out;
+    }
+
+    void TcpTransport::ApplyQuickAck()
+    {
+#if defined(__linux__)
+        if (!m_quickAck || !IsOpen()) return;
+        int on = 1;
+        setsockopt(static_cast<NativeSocket>(m_socket), IPPROTO_TCP, TCP_QUICKACK, &on, sizeof(on));
+#endif
+    }
+
+    // ============================================================
+    // WRITE
+    // ============================================================
+
+    bool TcpTransport::SendAll(const uint8_t* data, size_t size)
+    {
+        const NativeSocket s = static_cast<NativeSocket>(m_socket);
+        size_t sent = 0;
+        while (sent < size)
+        {
+            int n = send(s, reinterpret_cast<const char*>(data + sent),
+                static_cast<int>(size - sent), SEND_FLAGS);
+            if (n > 0)
+            {
+                sent += static_cast<size_t>(n);
+                continue;
+            }
+
+            int err = SocketError();
+            if (n < 0 && Interrupted(err)) continue;
+            if (n < 0 && WouldBlock(err))
+            {
+                PollFd pfd = {};
+                pfd.fd = s;
+                pfd.events = POLLOUT;
+                if (PollNative(&pfd, SEND_TIMEOUT_MS) > 0) continue;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    int TcpTransport::Write(const uint8_t* data, size_t size)
+    {
+        if (!IsOpen() || size == 0) return 0;
+
+        if (m_mode == Mode::Raw)
+            return SendAll(data, size) ? static_cast<int>(size) : 0;
+
+        // RFC 2217: a 0xFF data byte (possible CRC value) goes as IAC IAC.
+        // Frames are short - escape into one buffer, one segment.
+        uint8_t escaped[2 * Protocol::MAX_FRAME_CAPACITY];
+        size_t offset = 0;
+        while (offset < size)
+        {
+            size_t n = 0;
+            while (offset < size && n + 2 <= sizeof(escaped))
+            {
+                escaped[n++] = data[offset];
+                if (data[offset] == IAC) escaped[n++] = IAC;
+                offset++;
+            }
+            if (!SendAll(escaped, n)) return 0;
+        }
+        return static_cast<int>(size);
+    }
+
+    // ============================================================
+    // CLEAR
+    // ============================================================
+
+    void TcpTransport::PurgeInput()
+    {
+        if (!IsOpen()) return;
+
+        if (m_mode == Mode::Rfc2217)
+        {
+            const uint8_t purgeReceive = 1;  // access server receive buffer
+            SendComPortCommand(CPO_PURGE_DATA, &purgeReceive, 1);
+        }
+
+        // Drop what already reached us (telnet state still tracked)
+        uint8_t discard[256];
+        while (BytesAvailable(static_cast<NativeSocket>(m_socket)) > 0)
+        {
+            if (ReadNow(discard, sizeof(discard)) < 0) break;
+        }
+    }
+
+} // namespace FuelMaster
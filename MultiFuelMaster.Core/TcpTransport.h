@@ -0,0 +1,102 @@
+// ============================================================
+// TcpTransport.h — Ethernet serial server backend (TCP)
+// ============================================================
+// Port names:
+//   tcp://host:port       — raw TCP: bytes go to the line as is,
+//                           line settings are the server's own
+//   rfc2217://host:port   — Telnet COM-PORT-OPTION (RFC 2217):
+//                           baud/framing/purge are sent to the
+//                           server, 0xFF data bytes are escaped
+// Suffix "?quickack" enables TCP_QUICKACK (Linux) so a reply
+// is ACKed at once instead of waiting for delayed-ACK.
+// Nagle is always off (TCP_NODELAY): every request frame goes
+// out in its own segment immediately.
+// Waiting is poll()/WSAPoll on the socket, the same frame
+// completion path as the serial backends (Transport).
+// ============================================================
+#pragma once
+
+#include "Transport.h"
+#include <cstdint>
+#include <string>
+
+namespace FuelMaster {
+
+    class TcpTransport : public Transport
+    {
+    public:
+        enum class Mode
+        {
+            Raw,
+            Rfc2217
+        };
+
+        explicit TcpTransport(Mode mode = Mode::Raw);
+        ~TcpTransport() override;
+
+        /// True for names this backend handles (tcp:// or rfc2217://)
+        static bool IsNetworkPortName(const std::string& portName);
+
+        /// portName: "tcp://host:port" / "rfc2217://host:port" / "host:port"
+        bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default()) override;
+        void Close() override;
+        bool IsOpen() const override;
+
+        /// RFC 2217: sends the settings to the server. Raw: the server's
+        /// line settings cannot be changed from here, only recorded.
+        bool Configure(const SerialSettings& settings) override;
+
+        /// Drop received bytes (RFC 2217: the server's buffer too)
+        void PurgeInput() override;
+
+        void SetQuickAck(bool enabled) { m_quickAck = enabled; }
+        Mode GetMode() const { return m_mode; }
+
+    protected:
+        int Write(const uint8_t* data, size_t size) override;
+        int WaitForData(int timeoutMs, size_t minBytes) override;
+        int ReadNow(uint8_t* buffer, size_t size) override;
+
+    private:
+#if defined(_WIN32)
+        using SocketHandle = uintptr_t;     // SOCKET
+#else
+        using SocketHandle = int;
+#endif
+        SocketHandle m_socket;
+        Mode m_mode;
+        bool m_quickAck;
+        size_t m_lowWater;                  // SO_RCVLOWAT currently set (Linux)
+
+        // --- Telnet receive state (RFC 2217), persists across reads ---
+        enum class TelnetState : uint8_t
+        {
+            Data,       // plain bytes
+            Iac,        // after IAC
+            Option,     // after IAC WILL/WONT/DO/DONT, option byte next
+            Sub,        // inside IAC SB ... (skipped)
+            SubIac      // IAC inside SB (SE ends it)
+        };
+        TelnetState m_telnetState;
+        uint8_t m_telnetVerb;               // WILL/WONT/DO/DONT awaiting its option
+
+        bool Connect(const std::string& host, const std::string& port);
+        void CloseSocket();
+
+        /// send() everything (blocking up to 100 ms on a full socket buffer)
+        bool SendAll(const uint8_t* data, size_t size);
+
+        /// Strip telnet commands from `size` received bytes in place,
+        /// answering option requests. Returns the data bytes left.
+        size_t FilterTelnet(uint8_t* buffer, size_t size);
+
+        /// IAC SB COM-PORT-OPTION <command> <value...> IAC SE
+        bool SendComPortCommand(uint8_t command, const uint8_t* value, size_t size);
+        bool SendLineSettings(const SerialSettings& settings);
+
+        /// Re-arm TCP_QUICKACK (the kernel clears it after a while)
+        void ApplyQuickAck();
+    };
+
+} // namespace FuelMaster
@@ -0,0 +1,408 @@
+// ============================================================
+// Transport.cpp — Request/response logic shared by all backends
+// ============================================================
+// Frame reception:
+// 1. Accumulate data in buffer and read until we receive valid frame
+//    or total timeout expires (frame end found by FrameDecoder)
+// 2. The inter-byte timeout is not an end-of-frame criterion, only
+//    a gap limit: a reply that stalls for longer ends the read early
+// 3. Event-driven: sleep in WaitForData until the driver has bytes,
+//    no Sleep(1) polling, no per-read allocation (RX ring; raw
+//    bytes returned as a span over a reused buffer)
+// ============================================================
+
+#include "pch.h"
+#include "Transport.h"
+#include "FailoverTransport.h"
+#include "PreciseWait.h"
+#include "ReplayTransport.h"
+#include "TcpTransport.h"
+#include <chrono>
+
+#if defined(_WIN32)
+#include "SerialPort.h"
+#elif defined(__linux__)
+#include "PosixSerialPort.h"
+#include "PtyTransport.h"
+#endif
+
+namespace FuelMaster {
+
+    Transport::Transport()
+        : m_settings(SerialSettings::Default())
+        , m_adapter(AdapterOfKind(AdapterKind::Unknown))
+        , m_echoCancel(false)
+        , m_echoMatched(0)
+        , m_echoPending(false)
+        , m_echoesRemoved(0)
+        , m_echoBytesRemoved(0)
+        , m_receiveOnly(false)
+        , m_txNotBefore()
+        , m_rxWakeups(0)
+        , m_rxBytes(0)
+        , m_deviceLost(false)
+    {
+        m_rawRx.reserve(RX_RING_SIZE);
+    }
+
+    // ============================================================
+    // FACTORY
+    // ============================================================
+
+    std::unique_ptr<Transport> Transport::Create(const std::string& portName)
+    {
+        if (TcpTransport::IsNetworkPortName(portName))
+            return std::make_unique<TcpTransport>();
+        if (ReplayTransport::IsReplayPortName(portName))
+            return std::make_unique<ReplayTransport>();
+        if (FailoverTransport::IsFailoverPortName(portName))
+            return std::make_unique<FailoverTransport>();
+
+#if defined(_WIN32)
+        return std::make_unique<SerialPort>();
+#elif defined(__linux__)
+        if (portName == "pty")
+            return std::make_unique<PtyTransport>();
+        return std::make_unique<PosixSerialPort>();
+#else
+        (void)portName;
+        return nullptr;
+#endif
+    }
+
+    // ============================================================
+    // SEND AND RECEIVE RESPONSE
+    // ============================================================
+
+    std::span<const uint8_t> Transport::SendAndReceive(
+        const Protocol::Frame& command,
+        Protocol::FrameDecoder& decoder,
+        int responseTimeoutMs,
+        int interByteTimeoutMs,
+        bool forceBufferClear)
+    {
+        if (!IsOpen())
+        {
+            // Only Disconnect closes the port on purpose, after the
+            // polling thread has stopped: the backend dropped it
+            m_deviceLost.store(true);
+            return {};
+        }
+        if (m_receiveOnly.load())
+        {
+            m_lastError = "Receive-only: nothing is transmitted";
+            return {};
+        }
+
+        // Line gap after the previous reply (HoldTxUntil)
+        SleepUntil(m_txNotBefore);
+
+        // 1. Clear input buffer (if enabled). Late replies must have been
+        //    collected with TakeUnread() before this point.
+        decoder.Reset();
+        const uint64_t crcErrorsBefore = decoder.GetCrcErrors();
+        if (forceBufferClear)
+        {
+            PurgeInput();
+            m_rx.Clear();
+        }
+
+        // 2. Send command (remember it: an RS-485 adapter may echo it back)
+        m_lastTx = command;
+        m_echoMatched = 0;
+        m_echoPending = m_echoCancel.load();
+
+        if (Write(command.data(), command.size()) == 0)
+        {
+            // Flow control is off: a write only fails on a dead device
+            m_deviceLost.store(true);
+            return {};
+        }
+        m_capture.Record(WireDirection::Tx, LastTxAddress(), command.data(), command.size());
+
+        // 3. The response timeout runs from the end of transmission: a long
+        //    preset frame at 9600 baud must not eat its own reply budget
+        DrainTx(static_cast<int>(m_settings.WireTimeUs(command.size()) / 1000) + TX_DRAIN_SLACK_MS);
+        const auto txEnd = std::chrono::steady_clock::now();
+
+        // 4. Read response - sleep until RX data, up to responseTimeoutMs
+        const std::span<const uint8_t> response = ReadAvailable(decoder, responseTimeoutMs,
+            RxGapLimitMs(interByteTimeoutMs));
+
+        OnExchangeEnd(decoder.HasFrame(), decoder.GetCrcErrors() - crcErrorsBefore,
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - txEnd).count());
+        return response;
+    }
+
+    std::span<const uint8_t> Transport::Receive(Protocol::FrameDecoder& decoder,
+        int totalTimeoutMs, int interByteTimeoutMs)
+    {
+        if (!IsOpen()) return {};
+        return ReadAvailable(decoder, totalTimeoutMs, RxGapLimitMs(interByteTimeoutMs));
+    }
+
+    int Transport::RxGapLimitMs(int interByteTimeoutMs) const
+    {
+        // The adapter may hold received bytes back for its latency
+        // before the driver sees them (USB latency timer)
+        if (interByteTimeoutMs <= 0) return 0;
+        return interByteTimeoutMs + GetAdapter().latencyMs;
+    }
+
+    // ============================================================
+    // LATE BYTES — leftover of the last read + driver queue, no wait
+    // ============================================================
+
+    std::span<const uint8_t> Transport::TakeUnread()
+    {
+        m_rawRx.clear();
+        while (!m_rx.empty())
+        {
+            auto span = m_rx.ReadableSpan();
+            m_rawRx.insert(m_rawRx.end(), span.begin(), span.end());
+            m_rx.Consume(span.size());
+        }
+
+        if (IsOpen())
+        {
+            uint8_t chunk[256];
+            int n;
+            while ((n = ReadNow(chunk, sizeof(chunk))) > 0)
+            {
+                m_capture.Record(WireDirection::Rx, LastTxAddress(), chunk, static_cast<size_t>(n));
+                m_rawRx.insert(m_rawRx.end(), chunk, chunk + n);
+            }
+            if (n < 0) m_deviceLost.store(true);
+        }
+        return m_rawRx;
+    }
+
+    // ============================================================
+    // DEVICE LOSS
+    // The dead handle is closed first: while it is held, Linux
+    // gives the re-enumerated adapter another node (ttyUSB1) and
+    // Windows may refuse the COM name. Arrivals of any serial
+    // device trigger an attempt; without notifications (network,
+    // replay, platform refused) one attempt per timeoutMs.
+    // ============================================================
+
+    bool Transport::AwaitDevice(int timeoutMs)
+    {
+        if (!m_deviceLost.load()) return true;
+
+        if (IsOpen())
+        {
+            Close();
+            if (IsHotPluggable()) m_watcher.Start();
+        }
+
+        const DeviceEvent event = m_watcher.Wait(timeoutMs);
+        if (event == DeviceEvent::Interrupted) return false;
+
+        // A new node may not be openable at once
+        const auto settleEnd = std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(event == DeviceEvent::Arrived ? REOPEN_SETTLE_MS : 0);
+        while (!Reopen())
+        {
+            if (std::chrono::steady_clock::now() >= settleEnd ||
+                m_watcher.Wait(REOPEN_SETTLE_STEP_MS) == DeviceEvent::Interrupted)
+                return false;
+        }
+
+        m_watcher.Stop();
+        return true;
+    }
+
+    bool Transport::Reopen()
+    {
+        const std::string portName = m_portName;
+        const SerialSettings settings = m_settings;
+
+        Close();
+        if (!Open(portName, settings))
+            return false;
+
+        // Nothing from before the loss belongs to the next exchange
+        m_rx.Clear();
+        m_echoPending = false;
+        m_echoMatched = 0;
+        m_deviceLost.store(false);
+        return true;
+    }
+
+    // ============================================================
+    // TIMEOUT READ
+    // Sleep until the driver holds the bytes the decoder still
+    // needs (the whole 7-byte S reply, or the rest of a frame
+    // once its command letter is known), drain them into the
+    // ring and decode, until we get a complete frame or the total
+    // timeout expires. The read ends on the frame's CRC byte.
+    // With a gap limit, the read wakes on the first byte of a
+    // reply; the remaining bytes must then follow within their
+    // wire time plus the limit. A frame that lost bytes on the
+    // line ends the read there instead of holding it until the
+    // total timeout.
+    // ============================================================
+
+    std::span<const uint8_t> Transport::ReadAvailable(Protocol::FrameDecoder& decoder,
+        int totalTimeoutMs, int gapLimitMs)
+    {
+        m_rawRx.clear();
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(totalTimeoutMs);
+        auto lastProgress = std::chrono::steady_clock::now();
+        size_t progress = 0;
+
+        while (true)
+        {
+            // Feed buffered bytes to the caller's streaming decoder: the
+            // frame is complete the moment its CRC byte arrives, whatever
+            // its length (7-byte S ... 27-byte T) and whatever noise
+            // precedes it. Our own echo never reaches the decoder.
+            if (AcceptBuffered(decoder, m_rawRx))
+                return m_rawRx;
+
+            const auto now = std::chrono::steady_clock::now();
+            if (m_rawRx.size() != progress)
+            {
+                progress = m_rawRx.size();
+                lastProgress = now;
+            }
+
+            auto waitUntil = deadline;
+            if (gapLimitMs > 0 && decoder.HasPartialFrame())
+            {
+                const auto frameDeadline = lastProgress +
+                    std::chrono::microseconds(m_settings.WireTimeUs(BytesNeeded(decoder))) +
+                    std::chrono::milliseconds(gapLimitMs);
+                if (frameDeadline < waitUntil) waitUntil = frameDeadline;
+            }
+
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(waitUntil - now).count();
+            if (remaining <= 0)
+            {
+                // Timeout expired, or the line went silent inside a
+                // frame - return what we have (may be empty)
+                break;
+            }
+
+            // With a gap limit the start of a reply must be seen when it
+            // arrives, not once the shortest reply is complete
+            const size_t minBytes = (gapLimitMs > 0 && !decoder.HasPartialFrame())
+                ? 1 : BytesNeeded(decoder);
+            int ready = WaitForData(static_cast<int>(remaining), minBytes);
+            if (ready < 0)
+            {
+                // Device error - nothing more will arrive
+                m_deviceLost.store(true);
+                break;
+            }
+            if (ready > 0)
+                m_rxWakeups.fetch_add(1, std::memory_order_relaxed);
+
+            // Drained on timeout too: the threshold may have held back a
+            // frame shorter than expected (e.g. a late S reply)
+            if (DrainDriver() < 0)
+            {
+                m_deviceLost.store(true);
+                break;
+            }
+        }
+
+        // Return accumulated data (may be empty on timeout)
+        return m_rawRx;
+    }
+
+    size_t Transport::BytesNeeded(const Protocol::FrameDecoder& decoder) const
+    {
+        // Echo bytes held back may still turn out to be reply data
+        size_t needed = decoder.BytesNeeded();
+        if (m_echoPending)
+            needed = (needed > m_echoMatched) ? needed - m_echoMatched : 1;
+        return needed;
+    }
+
+    int Transport::DrainDriver()
+    {
+        int total = 0;
+        while (true)
+        {
+            auto space = m_rx.WritableSpan();
+            if (space.empty())
+                break;  // ring full: decode first, the rest stays queued in the driver
+
+            int n = ReadNow(space.data(), space.size());
+            if (n < 0) return total > 0 ? total : -1;
+            if (n == 0) break;
+
+            m_capture.Record(WireDirection::Rx, LastTxAddress(), space.data(), static_cast<size_t>(n));
+            m_rx.Commit(static_cast<size_t>(n));
+            total += n;
+        }
+        m_rxBytes.fetch_add(static_cast<uint64_t>(total), std::memory_order_relaxed);
+        return total;
+    }
+
+    // ============================================================
+    // ECHO FILTER
+    // The echo, if any, is the first thing on the line after TX.
+    // Matching bytes are held back; once the whole TX frame has
+    // matched it is dropped. On the first mismatch the held bytes
+    // were real data after all and are released to the decoder.
+    // ============================================================
+
+    bool Transport::AcceptBuffered(Protocol::FrameDecoder& decoder, std::vector<uint8_t>& raw)
+    {
+        while (!m_rx.empty())
+        {
+            auto span = m_rx.ReadableSpan();
+            for (size_t i = 0; i < span.size(); i++)
+            {
+                if (AcceptByte(span[i], decoder, raw))
+                {
+                    // Whatever follows the frame belongs to the next read
+                    m_rx.Consume(i + 1);
+                    return true;
+                }
+            }
+            m_rx.Consume(span.size());
+        }
+        return false;
+    }
+
+    bool Transport::AcceptByte(uint8_t byte, Protocol::FrameDecoder& decoder,
+        std::vector<uint8_t>& raw)
+    {
+        if (m_echoPending)
+        {
+            if (byte == m_lastTx[m_echoMatched])
+            {
+                if (++m_echoMatched == m_lastTx.size())
+                {
+                    m_echoPending = false;
+                    m_echoesRemoved.fetch_add(1);
+                    m_echoBytesRemoved.fetch_add(m_echoMatched);
+                }
+                return false;
+            }
+
+            // Not an echo: release what was held, then continue normally
+            m_echoPending = false;
+            bool frameComplete = false;
+            for (size_t i = 0; i < m_echoMatched; i++)
+            {
+                raw.push_back(m_lastTx[i]);
+                frameComplete = decoder.Push(m_lastTx[i]) || frameComplete;
+            }
+            m_echoMatched = 0;
+
+            raw.push_back(byte);
+            return decoder.Push(byte) || frameComplete;
+        }
+
+        raw.push_back(byte);
+        return decoder.Push(byte);
+    }
+
+} // namespace FuelMaster
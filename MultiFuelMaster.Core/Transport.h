@@ -0,0 +1,287 @@
+// ============================================================
+// Transport.h — Byte transport to the dispenser line
+// ============================================================
+// DispenserController talks to the line only through this
+// interface. The request/response logic (echo cancellation,
+// persistent RX ring, streaming decode) lives here once;
+// backends implement a handful of raw I/O primitives. Receive
+// is event-driven: the polling thread sleeps in WaitForData
+// (WaitCommEvent / epoll) until the driver has bytes, drains
+// them into a preallocated ring and decodes in place.
+//   SerialPort       — Win32 COM port (Windows)
+//   PosixSerialPort  — termios + epoll (Linux)
+//   PtyTransport     — pseudo-terminal pair for tests (Linux)
+//   TcpTransport     — Ethernet serial server, raw TCP / RFC 2217
+//   FailoverTransport — primary + standby path to the same post
+// ============================================================
+#pragma once
+
+#include "AdapterProfile.h"
+#include "DeviceWatcher.h"
+#include "GasKitFrame.h"
+#include "GasKitFrameDecoder.h"
+#include "RingBuffer.h"
+#include "SerialSettings.h"
+#include "WireCapture.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace FuelMaster {
+
+    class Transport
+    {
+    public:
+        Transport();
+        virtual ~Transport() = default;
+
+        Transport(const Transport&) = delete;
+        Transport& operator=(const Transport&) = delete;
+
+        /// Backend for a port name:
+        ///   "pty"            — PtyTransport (Linux)
+        ///   "tcp://h:p", "rfc2217://h:p" — TcpTransport
+        ///   "replay:<capture file>" — ReplayTransport
+        ///   "failover:<primary>|<standby>" — FailoverTransport
+        ///   anything else    — SerialPort (Windows) / PosixSerialPort (Linux)
+        static std::unique_ptr<Transport> Create(const std::string& portName);
+
+        virtual bool Open(const std::string& portName,
+            const SerialSettings& settings = SerialSettings::Default()) = 0;
+        virtual void Close() = 0;
+        virtual bool IsOpen() const = 0;
+
+        /// Change line speed / framing of the open port (no reopen)
+        virtual bool Configure(const SerialSettings& settings) = 0;
+
+        /// Settings currently applied to the line
+        SerialSettings GetSettings() const { return m_settings; }
+
+        /// Clear input buffer
+        virtual void PurgeInput() = 0;
+
+        /// Send command and get full response.
+        /// Algorithm:
+        /// 1. Clear input buffer (if forceBufferClear = true)
+        /// 2. Send command
+        /// 3. Wait until the last byte has left the UART (DrainTx), then
+        ///    sleep until the driver signals RX data, up to responseTimeoutMs
+        ///    from the end of transmission, pushing every byte through
+        ///    `decoder` exactly once
+        /// 4. Return as soon as the decoder completes a frame
+        ///    (decoder.HasFrame()), otherwise whatever arrived before
+        ///    the timeout (may be empty). Returned bytes are the raw
+        ///    line data, for logging; they live in a buffer of the
+        ///    transport, valid until its next SendAndReceive / Receive /
+        ///    TakeUnread (no allocation per exchange).
+        /// interByteTimeoutMs: silence allowed inside a reply once it has
+        /// started, on top of the wire time of its missing bytes and the
+        /// adapter's RX latency; a longer gap ends the read early.
+        /// 0 = no gap limit, only responseTimeoutMs.
+        std::span<const uint8_t> SendAndReceive(const Protocol::Frame& command,
+            Protocol::FrameDecoder& decoder,
+            int responseTimeoutMs,
+            int interByteTimeoutMs,
+            bool forceBufferClear = true);
+
+        /// Keep listening for the current exchange without sending.
+        /// Continues a partial frame already held by `decoder` (late reply).
+        /// Same return convention and gap limit as SendAndReceive.
+        std::span<const uint8_t> Receive(Protocol::FrameDecoder& decoder,
+            int totalTimeoutMs,
+            int interByteTimeoutMs);
+
+        /// Line gap: the next SendAndReceive transmits no earlier than
+        /// `time`, waiting for it precisely. Set after a reply instead
+        /// of sleeping on the spot, so the gap overlaps the caller's
+        /// own work; on a shared bus it holds for every post.
+        void HoldTxUntil(std::chrono::steady_clock::time_point time) { m_txNotBefore = time; }
+
+        /// Bytes received but not consumed by the last exchange, followed
+        /// by whatever the driver holds right now (no wait). Call before
+        /// SendAndReceive so a purge does not throw late replies away.
+        /// Same buffer and lifetime as the bytes SendAndReceive returns.
+        std::span<const uint8_t> TakeUnread();
+
+        /// RS-485 local echo cancellation: the last transmitted frame is
+        /// remembered and, if the adapter loops it back, removed from the
+        /// head of the RX stream before it reaches the decoder
+        void SetEchoCancellation(bool enabled) { m_echoCancel.store(enabled); }
+        bool GetEchoCancellation() const { return m_echoCancel.load(); }
+
+        /// Receive-only (passive monitoring of a line another master
+        /// polls): SendAndReceive transmits nothing, and backends keep
+        /// their line drivers off / open the device read-only at Open
+        void SetReceiveOnly(bool enabled) { m_receiveOnly.store(enabled); }
+        bool IsReceiveOnly() const { return m_receiveOnly.load(); }
+
+        uint64_t GetEchoesRemoved() const { return m_echoesRemoved.load(); }
+        uint64_t GetEchoBytesRemoved() const { return m_echoBytesRemoved.load(); }
+
+        /// Receive statistics: times the polling thread was woken by the
+        /// driver with data, and bytes drained into the RX ring
+        uint64_t GetRxWakeups() const { return m_rxWakeups.load(); }
+        uint64_t GetRxBytes() const { return m_rxBytes.load(); }
+
+        /// Binary capture of every TX frame and RX chunk (see WireCapture).
+        /// Records are tagged with the address of the last TX frame.
+        bool StartCapture(const std::string& path) { return m_capture.Open(path, m_portName); }
+        void StopCapture() { m_capture.Close(); }
+        bool IsCapturing() const { return m_capture.IsOpen(); }
+        uint64_t GetCaptureRecords() const { return m_capture.GetRecordCount(); }
+
+        /// Hot-plug: an exchange failed on the device itself (adapter
+        /// pulled or reset, socket dropped), not merely on the line.
+        /// Retrying is pointless until AwaitDevice has reopened it.
+        bool IsDeviceLost() const { return m_deviceLost.load(); }
+
+        /// Release the dead handle, sleep until the device may be back
+        /// (arrival notification, else timeoutMs) and reopen it with the
+        /// same name and settings. True once open; false on timeout or
+        /// InterruptAwaitDevice - call again to keep waiting.
+        bool AwaitDevice(int timeoutMs);
+
+        /// Wake AwaitDevice from another thread (shutdown)
+        void InterruptAwaitDevice() { m_watcher.Interrupt(); }
+
+        /// Adapter behind the port, identified (and tuned) at Open.
+        /// Its latencyMs is part of every reply's turnaround.
+        virtual AdapterInfo GetAdapter() const { return m_adapter; }
+
+        std::string GetPortName() const { return m_portName; }
+        std::string GetLastError() const { return m_lastError; }
+
+    protected:
+        std::string m_portName;
+        std::string m_lastError;
+        SerialSettings m_settings;      // set by the backend once applied
+        AdapterInfo m_adapter;          // set by the backend at Open (default: unknown)
+
+        // --- Backend primitives ---
+
+        /// Write all bytes. Returns bytes written (0 on failure).
+        virtual int Write(const uint8_t* data, size_t size) = 0;
+
+        /// Block until the bytes written so far are physically sent
+        /// (at most timeoutMs). Backends that cannot tell return at once.
+        /// Returns false on timeout or error; the exchange goes on regardless.
+        virtual bool DrainTx(int timeoutMs) { (void)timeoutMs; return true; }
+
+        /// Block until the driver holds at least minBytes (no polling).
+        /// minBytes is what the decoder still needs for a frame; a
+        /// backend that cannot wait for a count may wake earlier.
+        /// Returns 1 when data is readable, 0 on timeout, <0 on error.
+        virtual int WaitForData(int timeoutMs, size_t minBytes) = 0;
+
+        /// Copy up to `size` queued bytes without waiting.
+        /// Returns bytes read (0 if nothing queued, <0 on error).
+        virtual int ReadNow(uint8_t* buffer, size_t size) = 0;
+
+        /// The device can be unplugged and come back (USB-UART): device
+        /// arrivals are watched while it is lost instead of a timer only
+        virtual bool IsHotPluggable() const { return false; }
+
+        /// End of a SendAndReceive: whether the decoder completed a frame,
+        /// the CRC errors it met, and the time from end of TX to the end
+        /// of the read. For transports that rate their line.
+        virtual void OnExchangeEnd(bool answered, uint64_t crcErrors, int64_t replyUs)
+        {
+            (void)answered;
+            (void)crcErrors;
+            (void)replyUs;
+        }
+
+        // --- Primitives of a wrapped backend (for decorator transports) ---
+        static int InnerWrite(Transport& inner, const uint8_t* data, size_t size)
+        {
+            return inner.Write(data, size);
+        }
+        static bool InnerDrainTx(Transport& inner, int timeoutMs) { return inner.DrainTx(timeoutMs); }
+        static int InnerWaitForData(Transport& inner, int timeoutMs, size_t minBytes)
+        {
+            return inner.WaitForData(timeoutMs, minBytes);
+        }
+        static int InnerReadNow(Transport& inner, uint8_t* buffer, size_t size)
+        {
+            return inner.ReadNow(buffer, size);
+        }
+        static bool InnerIsHotPluggable(const Transport& inner) { return inner.IsHotPluggable(); }
+
+    private:
+        static constexpr size_t RX_RING_SIZE = 4096;
+
+        // DrainTx allowance beyond the frame's wire time (USB adapters
+        // hold TX bytes for up to a latency-timer tick)
+        static constexpr int TX_DRAIN_SLACK_MS = 50;
+
+        // --- Echo cancellation ---
+        std::atomic<bool> m_echoCancel;
+        Protocol::Frame m_lastTx;        // frame whose echo is expected
+        size_t m_echoMatched;            // echo bytes matched so far
+        bool m_echoPending;              // still matching the head of RX
+        std::atomic<uint64_t> m_echoesRemoved;
+        std::atomic<uint64_t> m_echoBytesRemoved;
+
+        std::atomic<bool> m_receiveOnly;
+
+        std::chrono::steady_clock::time_point m_txNotBefore;   // HoldTxUntil (polling thread only)
+
+        // Bytes read but not yet decoded; what follows the frame that
+        // ended the last read is fed to the decoder first on the next
+        // read (persistent RX buffer, no per-read allocation)
+        RingBuffer<RX_RING_SIZE> m_rx;
+
+        // Raw bytes of the last read, returned as a span: cleared, never
+        // shrunk, so its capacity is allocated once
+        std::vector<uint8_t> m_rawRx;
+
+        std::atomic<uint64_t> m_rxWakeups;
+        std::atomic<uint64_t> m_rxBytes;
+
+        WireCapture m_capture;
+
+        // --- Hot-plug ---
+        std::atomic<bool> m_deviceLost;
+        DeviceWatcher m_watcher;            // started only while the device is lost
+
+        // Time an arrived device gets to become openable (driver
+        // binding, udev permissions), and the retry step within it
+        static constexpr int REOPEN_SETTLE_MS = 2000;
+        static constexpr int REOPEN_SETTLE_STEP_MS = 100;
+
+        /// Close and Open with the current name and settings
+        bool Reopen();
+
+        /// Address byte (addrLo) of the last TX frame, for capture tags
+        uint8_t LastTxAddress() const { return m_lastTx.size() > 2 ? m_lastTx[2] : 0; }
+
+        /// Wait/drain/decode until a frame completes, totalTimeoutMs
+        /// expires or a started frame stalls for gapLimitMs (0 = never)
+        std::span<const uint8_t> ReadAvailable(Protocol::FrameDecoder& decoder,
+            int totalTimeoutMs, int gapLimitMs);
+
+        /// Gap limit of a read: interByteTimeoutMs plus the adapter's latency
+        int RxGapLimitMs(int interByteTimeoutMs) const;
+
+        /// Bytes to wait for before waking up (decoder lower bound)
+        size_t BytesNeeded(const Protocol::FrameDecoder& decoder) const;
+
+        /// Move everything the driver holds into the RX ring.
+        /// Returns bytes moved, <0 on device error.
+        int DrainDriver();
+
+        /// Pass one received byte through the echo filter into the
+        /// decoder/raw buffer. Returns true when the decoder completes a frame.
+        bool AcceptByte(uint8_t byte, Protocol::FrameDecoder& decoder,
+            std::vector<uint8_t>& raw);
+
+        /// AcceptByte over the RX ring; stops at the first completed frame
+        /// and leaves the bytes after it in the ring
+        bool AcceptBuffered(Protocol::FrameDecoder& decoder, std::vector<uint8_t>& raw);
+    };
+
+} // namespace FuelMaster
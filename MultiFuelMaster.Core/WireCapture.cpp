@@ -0,0 +1,181 @@
+// ============================================================
+// WireCapture.cpp — Binary capture of line traffic
+// ============================================================
+
+#include "pch.h"
+#include "WireCapture.h"
+#include <algorithm>
+#include <cstring>
+
+namespace FuelMaster {
+
+    namespace
+    {
+        constexpr char MAGIC[8] = { 'F', 'M', 'W', 'C', 'A', 'P', '0', '1' };
+        constexpr size_t RECORD_HEADER_SIZE = 12;
+
+        void PutLe(uint8_t* out, uint64_t value, size_t bytes)
+        {
+            for (size_t i = 0; i < bytes; i++)
+                out[i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+
+        uint64_t GetLe(const uint8_t* in, size_t bytes)
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; i++)
+                value |= static_cast<uint64_t>(in[i]) << (8 * i);
+            return value;
+        }
+
+        bool ReadExact(std::ifstream& file, uint8_t* out, size_t size)
+        {
+            file.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(size));
+            return static_cast<size_t>(file.gcount()) == size;
+        }
+    } // anonymous namespace
+
+    WireCapture::WireCapture()
+        : m_fileBuffer(FILE_BUFFER_SIZE)
+        , m_open(false)
+        , m_records(0)
+    {
+    }
+
+    WireCapture::~WireCapture()
+    {
+        Close();
+    }
+
+    // ============================================================
+    // WRITE
+    // ============================================================
+
+    bool WireCapture::Open(const std::string& path, const std::string& portName)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_file.is_open())
+        {
+            m_open.store(false);
+            m_file.close();
+        }
+
+        // Large stream buffer: records hit the disk in 64 KB blocks
+        m_file.rdbuf()->pubsetbuf(m_fileBuffer.data(), static_cast<std::streamsize>(m_fileBuffer.size()));
+        m_file.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!m_file.is_open())
+        {
+            m_lastError = "Cannot create capture file " + path;
+            return false;
+        }
+
+        const uint64_t wallNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        const size_t nameLength = std::min<size_t>(portName.size(), 0xFFFF);
+
+        uint8_t header[sizeof(MAGIC) + 8 + 2];
+        std::memcpy(header, MAGIC, sizeof(MAGIC));
+        PutLe(header + 8, wallNs, 8);
+        PutLe(header + 16, nameLength, 2);
+        m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        m_file.write(portName.data(), static_cast<std::streamsize>(nameLength));
+
+        m_start = std::chrono::steady_clock::now();
+        m_records.store(0);
+        m_lastError = "";
+        m_open.store(true);
+        return true;
+    }
+
+    void WireCapture::Close()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open.store(false);
+        if (m_file.is_open())
+        {
+            m_file.flush();
+            m_file.close();
+        }
+    }
+
+    void WireCapture::Record(WireDirection direction, uint8_t address, const uint8_t* data, size_t size)
+    {
+        if (!m_open.load(std::memory_order_relaxed) || size == 0)
+            return;
+
+        const auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_file.is_open())
+            return;
+
+        const uint64_t timeNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_start).count());
+
+        // Chunks longer than a record can hold are split
+        while (size > 0)
+        {
+            const size_t length = std::min<size_t>(size, 0xFFFF);
+
+            uint8_t header[RECORD_HEADER_SIZE];
+            PutLe(header, timeNs, 8);
+            header[8] = static_cast<uint8_t>(direction);
+            header[9] = address;
+            PutLe(header + 10, length, 2);
+            m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+            m_file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(length));
+
+            data += length;
+            size -= length;
+            m_records.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // ============================================================
+    // READ
+    // ============================================================
+
+    bool WireCapture::Load(const std::string& path, std::string& portName,
+        std::vector<WireRecord>& records, std::string& error)
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            error = "Cannot open capture file " + path;
+            return false;
+        }
+
+        uint8_t header[sizeof(MAGIC) + 8 + 2];
+        if (!ReadExact(file, header, sizeof(header)) || std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            error = "Not a wire capture: " + path;
+            return false;
+        }
+
+        portName.assign(static_cast<size_t>(GetLe(header + 16, 2)), '\0');
+        if (!portName.empty() &&
+            !ReadExact(file, reinterpret_cast<uint8_t*>(portName.data()), portName.size()))
+        {
+            error = "Truncated capture header: " + path;
+            return false;
+        }
+
+        records.clear();
+        uint8_t recordHeader[RECORD_HEADER_SIZE];
+        while (ReadExact(file, recordHeader, sizeof(recordHeader)))
+        {
+            WireRecord record;
+            record.timeNs = GetLe(recordHeader, 8);
+            record.direction = recordHeader[8] == 0 ? WireDirection::Tx : WireDirection::Rx;
+            record.address = recordHeader[9];
+            record.data.resize(static_cast<size_t>(GetLe(recordHeader + 10, 2)));
+            if (!ReadExact(file, record.data.data(), record.data.size()))
+                break;  // last record cut short (capture not closed) - keep the rest
+            records.push_back(std::move(record));
+        }
+
+        error = "";
+        return true;
+    }
+
+} // namespace FuelMaster
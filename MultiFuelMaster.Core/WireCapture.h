@@ -0,0 +1,81 @@
+// ============================================================
+// WireCapture.h — Binary capture of line traffic
+// ============================================================
+// Every TX frame and RX chunk as it crosses the Transport,
+// stamped with steady-clock nanoseconds. Cheap enough to keep
+// on in production: a fixed 12-byte record header plus the
+// bytes, appended to a buffered file. ReplayTransport feeds a
+// capture back into a DispenserController.
+//
+// File layout (integers little-endian):
+//   header:  "FMWCAP01"                 8 bytes
+//            wall clock at start, ns    u64 (Unix epoch)
+//            portName length, bytes     u16, char[]
+//   record:  time since start, ns       u64 (monotonic)
+//            direction                  u8  (0 = TX, 1 = RX)
+//            address                    u8  (addrLo of the last TX frame)
+//            length, bytes              u16, uint8_t[]
+// ============================================================
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace FuelMaster {
+
+    enum class WireDirection : uint8_t
+    {
+        Tx = 0,
+        Rx = 1
+    };
+
+    struct WireRecord
+    {
+        uint64_t timeNs;            // since capture start
+        WireDirection direction;
+        uint8_t address;
+        std::vector<uint8_t> data;
+    };
+
+    class WireCapture
+    {
+    public:
+        WireCapture();
+        ~WireCapture();
+
+        WireCapture(const WireCapture&) = delete;
+        WireCapture& operator=(const WireCapture&) = delete;
+
+        /// Start a new capture file (truncates), tagged with the port name
+        bool Open(const std::string& path, const std::string& portName);
+        void Close();
+        bool IsOpen() const { return m_open.load(std::memory_order_relaxed); }
+
+        /// Append one chunk; no-op while closed. Thread-safe.
+        void Record(WireDirection direction, uint8_t address, const uint8_t* data, size_t size);
+
+        uint64_t GetRecordCount() const { return m_records.load(); }
+        std::string GetLastError() const { return m_lastError; }
+
+        /// Read a whole capture file
+        static bool Load(const std::string& path, std::string& portName,
+            std::vector<WireRecord>& records, std::string& error);
+
+    private:
+        static constexpr size_t FILE_BUFFER_SIZE = 64 * 1024;
+
+        std::mutex m_mutex;
+        std::ofstream m_file;
+        std::vector<char> m_fileBuffer;
+        std::chrono::steady_clock::time_point m_start;
+        std::atomic<bool> m_open;
+        std::atomic<uint64_t> m_records;
+        std::string m_lastError;
+    };
+
+} // namespace FuelMaster
@@ -11,6 +11,9 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 // Add header files for precompilation here
+// (Windows only: on Linux the Core builds without windows.h)
+#if defined(_WIN32)
 #include "framework.h"
+#endif
 
 #endif //PCH_H
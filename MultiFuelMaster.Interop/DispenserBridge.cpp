@@ -5,6 +5,7 @@
 
 #include "pch.h"
 #include "DispenserBridge.h"
+#include "../MultiFuelMaster.Core/PreciseWait.h"
 #include <msclr/marshal_cppstd.h>
 
 namespace FuelMasterInterop {
@@ -39,13 +40,29 @@ namespace FuelMasterInterop {
     }
 
     bool DispenserBridge::Connect(String^ portName, String^ slaveAddress)
+    {
+        return Connect(portName, slaveAddress, ManagedProtocolDialect::Standard);
+    }
+
+    bool DispenserBridge::Connect(String^ portName, String^ slaveAddress, ManagedProtocolDialect dialect)
     {
         if (m_disposed || !m_controller) return false;
 
         std::string p = msclr::interop::marshal_as<std::string>(portName);
         std::string a = msclr::interop::marshal_as<std::string>(slaveAddress);
 
-        return m_controller->Connect(p, a);
+        return m_controller->Connect(p, a,
+            static_cast<FuelMaster::Protocol::Dialect>(static_cast<int>(dialect)));
+    }
+
+    bool DispenserBridge::Connect(DispenserBusBridge^ bus, String^ slaveAddress, ManagedProtocolDialect dialect)
+    {
+        if (m_disposed || !m_controller || bus == nullptr || !bus->GetNative()) return false;
+
+        std::string a = msclr::interop::marshal_as<std::string>(slaveAddress);
+
+        return m_controller->Connect(*bus->GetNative(), a,
+            static_cast<FuelMaster::Protocol::Dialect>(static_cast<int>(dialect)));
     }
 
     void DispenserBridge::Disconnect()
@@ -124,6 +141,78 @@ namespace FuelMasterInterop {
         return m_controller->GetErrorCount();
     }
 
+    bool DispenserBridge::EchoCancellation::get()
+    {
+        if (m_disposed || !m_controller) return false;
+        return m_controller->GetEchoCancellation();
+    }
+
+    void DispenserBridge::EchoCancellation::set(bool value)
+    {
+        if (m_disposed || !m_controller) return;
+        m_controller->SetEchoCancellation(value);
+    }
+
+    UInt64 DispenserBridge::EchoesRemoved::get()
+    {
+        if (m_disposed || !m_controller) return 0;
+        return m_controller->GetEchoesRemoved();
+    }
+
+    bool DispenserBridge::PassiveMode::get()
+    {
+        if (m_disposed || !m_controller) return false;
+        return m_controller->IsPassiveMode();
+    }
+
+    void DispenserBridge::PassiveMode::set(bool value)
+    {
+        if (m_disposed || !m_controller) return;
+        m_controller->SetPassiveMode(value);
+    }
+
+    UInt64 DispenserBridge::RetriesAvoided::get()
+    {
+        if (m_disposed || !m_controller) return 0;
+        return m_controller->GetRetriesAvoided();
+    }
+
+    UInt64 DispenserBridge::LateFrames::get()
+    {
+        if (m_disposed || !m_controller) return 0;
+        return m_controller->GetLateFrames();
+    }
+
+    UInt64 DispenserBridge::RxWakeups::get()
+    {
+        if (m_disposed || !m_controller) return 0;
+        return m_controller->GetRxWakeups();
+    }
+
+    String^ DispenserBridge::Adapter::get()
+    {
+        if (m_disposed || !m_controller) return String::Empty;
+        return msclr::interop::marshal_as<String^>(m_controller->GetAdapter().Describe());
+    }
+
+    bool DispenserBridge::StartCapture(String^ path)
+    {
+        if (m_disposed || !m_controller) return false;
+        return m_controller->StartCapture(msclr::interop::marshal_as<std::string>(path));
+    }
+
+    void DispenserBridge::StopCapture()
+    {
+        if (m_disposed || !m_controller) return;
+        m_controller->StopCapture();
+    }
+
+    bool DispenserBridge::IsCapturing::get()
+    {
+        if (m_disposed || !m_controller) return false;
+        return m_controller->IsCapturing();
+    }
+
     // --- Timing Parameters ---
 
     void DispenserBridge::SetTimingParams(int responseTimeoutMs, int interByteTimeoutMs, int maxRetries,
@@ -132,7 +221,8 @@ namespace FuelMasterInterop {
     {
         if (m_disposed || !m_controller) return;
 
-        FuelMaster::TimingParams params;
+        // Fields not passed here (turnaroundMs, reopenRetryMs, poll periods) keep their current value
+        FuelMaster::TimingParams params = m_controller->GetTimingParams();
         params.responseTimeoutMs = responseTimeoutMs;
         params.interByteTimeoutMs = interByteTimeoutMs;
         params.maxRetries = maxRetries;
@@ -159,7 +249,7 @@ namespace FuelMasterInterop {
         if (m_disposed || !m_controller)
         {
             responseTimeoutMs = 80;
-            interByteTimeoutMs = 20;
+            interByteTimeoutMs = 3;
             maxRetries = 3;
             interCommandDelayMs = 10;
             idlePollDelayMs = 450;
@@ -181,4 +271,119 @@ namespace FuelMasterInterop {
         errorThreshold = params.errorThreshold;
         forceBufferClear = params.forceBufferClear;
     }
+
+    int DispenserBridge::TurnaroundMs::get()
+    {
+        if (m_disposed || !m_controller) return FuelMaster::TimingParams::Default().turnaroundMs;
+        return m_controller->GetTimingParams().turnaroundMs;
+    }
+
+    void DispenserBridge::TurnaroundMs::set(int value)
+    {
+        if (m_disposed || !m_controller) return;
+        FuelMaster::TimingParams params = m_controller->GetTimingParams();
+        params.turnaroundMs = value;
+        m_controller->SetTimingParams(params);
+    }
+
+    int DispenserBridge::ReopenRetryMs::get()
+    {
+        if (m_disposed || !m_controller) return FuelMaster::TimingParams::Default().reopenRetryMs;
+        return m_controller->GetTimingParams().reopenRetryMs;
+    }
+
+    void DispenserBridge::ReopenRetryMs::set(int value)
+    {
+        if (m_disposed || !m_controller) return;
+        FuelMaster::TimingParams params = m_controller->GetTimingParams();
+        params.reopenRetryMs = value;
+        m_controller->SetTimingParams(params);
+    }
+
+    int DispenserBridge::BusyPollPeriodMs::get()
+    {
+        if (m_disposed || !m_controller) return FuelMaster::TimingParams::Default().busyPollPeriodMs;
+        return m_controller->GetTimingParams().busyPollPeriodMs;
+    }
+
+    void DispenserBridge::BusyPollPeriodMs::set(int value)
+    {
+        if (m_disposed || !m_controller) return;
+        FuelMaster::TimingParams params = m_controller->GetTimingParams();
+        params.busyPollPeriodMs = value;
+        m_controller->SetTimingParams(params);
+    }
+
+    int DispenserBridge::ActivePollPeriodMs::get()
+    {
+        if (m_disposed || !m_controller) return FuelMaster::TimingParams::Default().activePollPeriodMs;
+        return m_controller->GetTimingParams().activePollPeriodMs;
+    }
+
+    void DispenserBridge::ActivePollPeriodMs::set(int value)
+    {
+        if (m_disposed || !m_controller) return;
+        FuelMaster::TimingParams params = m_controller->GetTimingParams();
+        params.activePollPeriodMs = value;
+        m_controller->SetTimingParams(params);
+    }
+
+    // --- Poll cadence ---
+
+    int DispenserBridge::TargetPollPeriodMs::get()
+    {
+        if (m_disposed || !m_controller) return 0;
+        FuelMaster::PollCadenceStats stats = m_controller->GetPollCadence();
+        return stats.Of(stats.current).targetMs;
+    }
+
+    double DispenserBridge::AchievedPollPeriodMs::get()
+    {
+        if (m_disposed || !m_controller) return 0.0;
+        FuelMaster::PollCadenceStats stats = m_controller->GetPollCadence();
+        return stats.Of(stats.current).meanMs;
+    }
+
+    String^ DispenserBridge::PollCadence::get()
+    {
+        if (m_disposed || !m_controller) return String::Empty;
+        return msclr::interop::marshal_as<String^>(m_controller->GetPollCadence().Report());
+    }
+
+    void DispenserBridge::ResetPollCadence()
+    {
+        if (m_disposed || !m_controller) return;
+        m_controller->ResetPollCadence();
+    }
+
+    // --- Serial Settings ---
+
+    void DispenserBridge::SetSerialSettings(int baudRate, int dataBits, ManagedParity parity,
+        int stopBits, bool autoBaud)
+    {
+        if (m_disposed || !m_controller) return;
+
+        FuelMaster::SerialSettings settings;
+        settings.baudRate = baudRate;
+        settings.dataBits = dataBits;
+        settings.parity = static_cast<FuelMaster::Parity>(parity);
+        settings.stopBits = stopBits;
+        settings.autoBaud = autoBaud;
+
+        m_controller->SetSerialSettings(settings);
+    }
+
+    int DispenserBridge::BaudRate::get()
+    {
+        if (m_disposed || !m_controller) return 9600;
+        return m_controller->GetSerialSettings().baudRate;
+    }
+
+    // --- Wait precision ---
+
+    String^ DispenserBridge::MeasureWaitJitter(int requestedUs, int samples)
+    {
+        return msclr::interop::marshal_as<String^>(
+            FuelMaster::MeasureWaitJitter(requestedUs, samples).Report());
+    }
 }
@@ -7,6 +7,7 @@
 
 #include "../MultiFuelMaster.Core/DispenserController.h"
 #include "../MultiFuelMaster.Core/GasKitProtocol.h"
+#include "DispenserBusBridge.h"
 
 using namespace System;
 
@@ -26,6 +27,21 @@ namespace FuelMasterInterop {
         EndOfTransaction = 9
     };
 
+    /// Protocol dialect of a post (mirrors FuelMaster::Protocol::Dialect)
+    public enum class ManagedProtocolDialect
+    {
+        Standard = 0,
+        Wide = 1
+    };
+
+    /// Line parity (mirrors FuelMaster::Parity)
+    public enum class ManagedParity
+    {
+        None = 0,
+        Odd = 1,
+        Even = 2
+    };
+
     public ref class DispenserBridge
     {
     public:
@@ -34,6 +50,9 @@ namespace FuelMasterInterop {
         !DispenserBridge();
 
         bool Connect(String^ portName, String^ slaveAddress);
+        bool Connect(String^ portName, String^ slaveAddress, ManagedProtocolDialect dialect);
+        // Post on a shared RS-485 line (several addresses, one COM port)
+        bool Connect(DispenserBusBridge^ bus, String^ slaveAddress, ManagedProtocolDialect dialect);
         void Disconnect();
         property bool IsConnected{ bool get(); }
 
@@ -50,6 +69,29 @@ namespace FuelMasterInterop {
         property bool IsTransactionDataReady{ bool get(); }
         property int ErrorCount{ int get(); }
 
+        // RS-485 adapters that echo TX into RX
+        property bool EchoCancellation{ bool get(); void set(bool value); }
+        property UInt64 EchoesRemoved{ UInt64 get(); }
+
+        // Listen-only on a line another master polls (applied on Connect)
+        property bool PassiveMode{ bool get(); void set(bool value); }
+
+        // Replies that arrived after responseTimeoutMs
+        property UInt64 RetriesAvoided{ UInt64 get(); }
+        property UInt64 LateFrames{ UInt64 get(); }
+
+        // Times the polling thread was woken by RX data
+        property UInt64 RxWakeups{ UInt64 get(); }
+
+        // Adapter behind the port, identified at Connect, e.g.
+        // "FTDI 0403:6001, RX latency 1 ms (tuned)"
+        property String^ Adapter{ String^ get(); }
+
+        // Binary wire capture; replay with port name "replay:<file>"
+        bool StartCapture(String^ path);
+        void StopCapture();
+        property bool IsCapturing{ bool get(); }
+
         // Timing parameters
         void SetTimingParams(int responseTimeoutMs, int interByteTimeoutMs, int maxRetries,
             int interCommandDelayMs, int idlePollDelayMs, int linkLostPollMs, int postEndDelayMs,
@@ -63,6 +105,32 @@ namespace FuelMasterInterop {
             [Runtime::InteropServices::Out] int% postEndDelayMs,
             [Runtime::InteropServices::Out] int% errorThreshold,
             [Runtime::InteropServices::Out] bool% forceBufferClear);
+        // Dispenser reply latency allowed after the end of TX (per-command
+        // timeouts; the adapter's RX latency is added per port)
+        property int TurnaroundMs{ int get(); void set(int value); }
+        // Reopen attempt interval while the USB-UART is unplugged
+        property int ReopenRetryMs{ int get(); void set(int value); }
+        // Poll period targets (idle: idlePollDelayMs of SetTimingParams);
+        // 0 = back to back, the next cycle after interCommandDelayMs
+        property int BusyPollPeriodMs{ int get(); void set(int value); }
+        property int ActivePollPeriodMs{ int get(); void set(int value); }
+
+        // Poll period of the current state: target and achieved average
+        // (cycle start to start), e.g. for the fuelling display refresh
+        property int TargetPollPeriodMs{ int get(); }
+        property double AchievedPollPeriodMs{ double get(); }
+        // Target vs achieved period of every state seen
+        property String^ PollCadence{ String^ get(); }
+        void ResetPollCadence();
+
+        // Line speed / framing (applied on Connect)
+        void SetSerialSettings(int baudRate, int dataBits, ManagedParity parity, int stopBits, bool autoBaud);
+        // Rate in use (the detected one after auto-baud)
+        property int BaudRate{ int get(); }
+
+        // Requested vs achieved delays of the poll pacing waits (blocks
+        // for about 2 x samples x requestedUs)
+        static String^ MeasureWaitJitter(int requestedUs, int samples);
 
     private:
         FuelMaster::DispenserController* m_controller;
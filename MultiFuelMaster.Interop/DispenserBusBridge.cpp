@@ -0,0 +1,97 @@
+// ============================================================
+// MultiFuelMaster.Interop/DispenserBusBridge.cpp
+// C++/CLI Bridge Implementation (shared RS-485 line)
+// ============================================================
+
+#include "pch.h"
+#include "DispenserBusBridge.h"
+#include <msclr/marshal_cppstd.h>
+
+namespace FuelMasterInterop {
+
+    DispenserBusBridge::DispenserBusBridge()
+        : m_bus(new FuelMaster::DispenserBus()),
+        m_disposed(false)
+    {
+    }
+
+    DispenserBusBridge::~DispenserBusBridge()
+    {
+        Cleanup();
+    }
+
+    DispenserBusBridge::!DispenserBusBridge()
+    {
+        Cleanup();
+    }
+
+    void DispenserBusBridge::Cleanup()
+    {
+        if (m_disposed) return;
+        m_disposed = true;
+
+        if (m_bus)
+        {
+            m_bus->Close();
+            delete m_bus;
+            m_bus = nullptr;
+        }
+    }
+
+    bool DispenserBusBridge::Open(String^ portName)
+    {
+        return Open(portName, 9600);
+    }
+
+    bool DispenserBusBridge::Open(String^ portName, int baudRate)
+    {
+        if (m_disposed || !m_bus) return false;
+
+        std::string p = msclr::interop::marshal_as<std::string>(portName);
+        FuelMaster::SerialSettings settings = FuelMaster::SerialSettings::Default();
+        settings.baudRate = baudRate;
+
+        return m_bus->Open(p, settings);
+    }
+
+    void DispenserBusBridge::Close()
+    {
+        if (m_disposed || !m_bus) return;
+        m_bus->Close();
+    }
+
+    bool DispenserBusBridge::IsOpen::get()
+    {
+        if (m_disposed || !m_bus) return false;
+        return m_bus->IsOpen();
+    }
+
+    void DispenserBusBridge::EchoCancellation::set(bool value)
+    {
+        if (m_disposed || !m_bus) return;
+        m_bus->SetEchoCancellation(value);
+    }
+
+    void DispenserBusBridge::SetWeights(int active, int busy, int idle)
+    {
+        if (m_disposed || !m_bus) return;
+
+        FuelMaster::BusWeights weights;
+        weights.active = active;
+        weights.busy = busy;
+        weights.idle = idle;
+        m_bus->SetWeights(weights);
+    }
+
+    int DispenserBusBridge::MemberCount::get()
+    {
+        if (m_disposed || !m_bus) return 0;
+        return static_cast<int>(m_bus->GetMemberCount());
+    }
+
+    UInt64 DispenserBusBridge::Cycles::get()
+    {
+        if (m_disposed || !m_bus) return 0;
+        return m_bus->GetCycles();
+    }
+}
@@ -0,0 +1,45 @@
+// ============================================================
+// MultiFuelMaster.Interop/DispenserBusBridge.h
+// C++/CLI Bridge for a shared RS-485 line (DispenserBus)
+// ============================================================
+// Open one bus per COM port, then connect each post's
+// DispenserBridge to it with its own address.
+// ============================================================
+
+#pragma once
+
+#include "../MultiFuelMaster.Core/DispenserBus.h"
+
+using namespace System;
+
+namespace FuelMasterInterop {
+
+    public ref class DispenserBusBridge
+    {
+    public:
+        DispenserBusBridge();
+        ~DispenserBusBridge();
+        !DispenserBusBridge();
+
+        bool Open(String^ portName);
+        bool Open(String^ portName, int baudRate);
+        void Close();
+        property bool IsOpen{ bool get(); }
+
+        property bool EchoCancellation{ void set(bool value); }
+
+        // Bus time weights by post state (Fuelling/Stopped, other active, idle)
+        void SetWeights(int active, int busy, int idle);
+
+        property int MemberCount{ int get(); }
+        property UInt64 Cycles{ UInt64 get(); }
+
+    internal:
+        FuelMaster::DispenserBus* GetNative() { return m_bus; }
+
+    private:
+        FuelMaster::DispenserBus* m_bus;
+        bool m_disposed;
+        void Cleanup();
+    };
+}
@@ -0,0 +1,235 @@
+// ============================================================
+// CodecBenchmarks.cpp — Build / parse / decode throughput
+// ============================================================
+// Latency is the reported time per iteration (one frame built,
+// parsed or decoded); throughput is the items/s and bytes/s
+// counters. Every request builder and every reply parser is
+// measured in both dialects, the stream decoder on a real line
+// capture (noise, a broken CRC, a reply of another post).
+// ============================================================
+
+#include "GasKitFrameDecoder.h"
+#include "GasKitProtocol.h"
+#include "GasKitSamples.h"
+#include <benchmark/benchmark.h>
+#include <iterator>
+#include <string>
+
+using namespace FuelMaster;
+using namespace FuelMaster::Protocol;
+
+namespace
+{
+    // ============================================================
+    // BUILD — one request frame per iteration
+    // ============================================================
+
+    enum class Request : int
+    {
+        Status, VolumePreset, MoneyPreset, Stop, Resume,
+        Volume, Money, Transaction, TotalCounter, EndTransaction
+    };
+
+    template <typename Codec>
+    Frame BuildRequest(Codec& codec, Request request)
+    {
+        switch (request)
+        {
+        case Request::Status:         return codec.BuildStatusRequest();
+        case Request::VolumePreset:   return codec.BuildVolumePreset(1, 5000, 4590);
+        case Request::MoneyPreset:    return codec.BuildMoneyPreset(1, 100000, 4590);
+        case Request::Stop:           return codec.BuildStop();
+        case Request::Resume:         return codec.BuildResume();
+        case Request::Volume:         return codec.BuildVolumeRequest();
+        case Request::Money:          return codec.BuildMoneyRequest();
+        case Request::Transaction:    return codec.BuildTransactionRequest();
+        case Request::TotalCounter:   return codec.BuildTotalCounterRequest(1);
+        default:                      return codec.BuildEndTransaction();
+        }
+    }
+
+    /// addrLo 1 hits the precomputed frames of GasKitCommandTable.h,
+    /// addrLo 40 formats every frame
+    template <typename Codec>
+    void BM_Build(benchmark::State& state, Request request, uint8_t addrLo)
+    {
+        Codec codec(0x00, addrLo);
+        size_t bytes = 0;
+        for (auto _ : state)
+        {
+            Frame frame = BuildRequest(codec, request);
+            benchmark::DoNotOptimize(frame);
+            bytes += frame.size();
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    }
+
+    // ============================================================
+    // PARSE — one reply frame per iteration
+    // ============================================================
+
+    template <typename Codec, typename Parse>
+    void RunParse(benchmark::State& state, const char* payload, Parse parse)
+    {
+        Codec codec;
+        const Test::Bytes frame = Test::MakeFrame(payload);
+        for (auto _ : state)
+        {
+            auto result = parse(codec, std::span<const uint8_t>(frame));
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frame.size()));
+    }
+
+    template <typename Codec>
+    void BM_ParseStatus(benchmark::State& state, const char* payload)
+    {
+        RunParse<Codec>(state, payload, [](Codec& c, auto f) { return c.ParseStatusResponse(f); });
+    }
+
+    template <typename Codec>
+    void BM_ParseVolume(benchmark::State& state, const char* payload)
+    {
+        RunParse<Codec>(state, payload, [](Codec& c, auto f) { return c.ParseVolumeResponse(f); });
+    }
+
+    template <typename Codec>
+    void BM_ParseMoney(benchmark::State& state, const char* payload)
+    {
+        RunParse<Codec>(state, payload, [](Codec& c, auto f) { return c.ParseMoneyResponse(f); });
+    }
+
+    template <typename Codec>
+    void BM_ParseTransaction(benchmark::State& state, const char* payload)
+    {
+        RunParse<Codec>(state, payload, [](Codec& c, auto f) { return c.ParseTransactionResponse(f); });
+    }
+
+    template <typename Codec>
+    void BM_ParseTotalCounter(benchmark::State& state, const char* payload)
+    {
+        RunParse<Codec>(state, payload, [](Codec& c, auto f) { return c.ParseTotalCounterResponse(f); });
+    }
+
+    template <typename Codec>
+    void BM_ParseResponse(benchmark::State& state, const char* payload)
+    {
+        RunParse<Codec>(state, payload, [](Codec& c, auto f) { return c.ParseResponse(f); });
+    }
+
+    // ============================================================
+    // DECODE — stream decoder, then fields of every emitted frame
+    // ============================================================
+
+    /// One reply pushed byte by byte and decoded: the RX path of a poll
+    template <typename Codec>
+    void BM_DecodeReply(benchmark::State& state, const char* payload)
+    {
+        Codec codec;
+        FrameDecoder decoder;
+        decoder.SetDialect<typename Codec::DialectType>();
+        const Test::Bytes frame = Test::MakeFrame(payload);
+
+        for (auto _ : state)
+        {
+            for (uint8_t b : frame)
+            {
+                if (!decoder.Push(b)) continue;
+                Response response = codec.DecodeValidatedFrame(
+                    std::span<const uint8_t>(decoder.GetFrame().data(), decoder.GetFrame().size()));
+                benchmark::DoNotOptimize(response);
+                decoder.ConsumeFrame();
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * frame.size()));
+    }
+
+    /// Line capture through Feed: bytes/s of the decoder alone
+    void BM_DecodeLineCapture(benchmark::State& state)
+    {
+        FrameDecoder decoder;
+        const Test::Bytes line = Test::SampleLineCapture();
+        size_t frames = 0;
+
+        for (auto _ : state)
+        {
+            decoder.Feed(std::span<const uint8_t>(line), [&](const Frame& frame) {
+                benchmark::DoNotOptimize(frame.data());
+                frames++;
+            });
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(frames));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * line.size()));
+    }
+
+    // ============================================================
+    // REGISTRATION
+    // ============================================================
+
+    struct RequestName
+    {
+        Request request;
+        const char* name;
+    };
+
+    const RequestName REQUESTS[] = {
+        { Request::Status, "Status" },
+        { Request::VolumePreset, "VolumePreset" },
+        { Request::MoneyPreset, "MoneyPreset" },
+        { Request::Stop, "Stop" },
+        { Request::Resume, "Resume" },
+        { Request::Volume, "Volume" },
+        { Request::Money, "Money" },
+        { Request::Transaction, "Transaction" },
+        { Request::TotalCounter, "TotalCounter" },
+        { Request::EndTransaction, "EndTransaction" },
+    };
+
+    template <typename Codec>
+    void RegisterReplies(const char* dialect, const Test::SampleReply* replies, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            const Test::SampleReply& reply = replies[i];
+            const std::string suffix = std::string("/") + dialect + "/" + reply.name;
+            switch (reply.payload[0])
+            {
+            case 'S': benchmark::RegisterBenchmark(("BM_ParseStatus" + suffix).c_str(), BM_ParseStatus<Codec>, reply.payload); break;
+            case 'L': benchmark::RegisterBenchmark(("BM_ParseVolume" + suffix).c_str(), BM_ParseVolume<Codec>, reply.payload); break;
+            case 'R': benchmark::RegisterBenchmark(("BM_ParseMoney" + suffix).c_str(), BM_ParseMoney<Codec>, reply.payload); break;
+            case 'T': benchmark::RegisterBenchmark(("BM_ParseTransaction" + suffix).c_str(), BM_ParseTransaction<Codec>, reply.payload); break;
+            case 'C': benchmark::RegisterBenchmark(("BM_ParseTotalCounter" + suffix).c_str(), BM_ParseTotalCounter<Codec>, reply.payload); break;
+            default:  break;
+            }
+            benchmark::RegisterBenchmark(("BM_ParseResponse" + suffix).c_str(), BM_ParseResponse<Codec>, reply.payload);
+            benchmark::RegisterBenchmark(("BM_DecodeReply" + suffix).c_str(), BM_DecodeReply<Codec>, reply.payload);
+        }
+    }
+
+    bool RegisterAll()
+    {
+        for (const RequestName& r : REQUESTS)
+        {
+            const std::string name = r.name;
+            benchmark::RegisterBenchmark(("BM_Build/GasKit/" + name).c_str(),
+                                         BM_Build<GasKitProtocol>, r.request, uint8_t(0x01));
+            benchmark::RegisterBenchmark(("BM_Build/GasKit/" + name + "/formatted").c_str(),
+                                         BM_Build<GasKitProtocol>, r.request, uint8_t(0x28));
+            benchmark::RegisterBenchmark(("BM_Build/Wide/" + name).c_str(),
+                                         BM_Build<GasKitWideProtocol>, r.request, uint8_t(0x28));
+        }
+
+        RegisterReplies<GasKitProtocol>("GasKit", Test::STANDARD_REPLIES, std::size(Test::STANDARD_REPLIES));
+        RegisterReplies<GasKitWideProtocol>("Wide", Test::WIDE_REPLIES, std::size(Test::WIDE_REPLIES));
+        benchmark::RegisterBenchmark("BM_DecodeLineCapture", BM_DecodeLineCapture);
+        return true;
+    }
+
+    const bool REGISTERED = RegisterAll();
+
+} // anonymous namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,176 @@
+// ============================================================
+// FrameAllocBenchmarks.cpp — Heap allocations per built frame
+// ============================================================
+// Global operator new is replaced by a counting one, so every
+// benchmark reports allocs_per_frame next to its time. The
+// Frame builders must stay at zero: a benchmark that sees an
+// allocation fails (and with it the ctest run). The Legacy
+// rows are the std::vector / std::string / ostringstream path
+// the builders replaced. Where mfm_core is built, a whole
+// SendAndReceive over a pty must stay at zero too.
+// ============================================================
+
+#include "GasKitProtocol.h"
+#include "LegacyCodec.h"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#if defined(MFM_BENCH_EXCHANGE)
+#include "GasKitSamples.h"
+#include "PtyTransport.h"
+#include <unistd.h>
+#endif
+
+namespace
+{
+    std::atomic<uint64_t> g_allocations{ 0 };
+
+    /// Every replacement new comes here: one counter, one malloc,
+    /// so each delete below can free() what it gets
+    void* CountedAlloc(size_t size)
+    {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(size_t size) { return CountedAlloc(size); }
+void* operator new[](size_t size) { return CountedAlloc(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+using namespace FuelMaster;
+
+namespace
+{
+    enum class Request : int { Status, VolumePreset, MoneyPreset, TotalCounter, EndTransaction };
+
+    template <typename Codec>
+    auto BuildRequest(Codec& codec, Request request)
+    {
+        switch (request)
+        {
+        case Request::Status:         return codec.BuildStatusRequest();
+        case Request::VolumePreset:   return codec.BuildVolumePreset(1, 5000, 4590);
+        case Request::MoneyPreset:    return codec.BuildMoneyPreset(1, 100000, 4590);
+        case Request::TotalCounter:   return codec.BuildTotalCounterRequest(1);
+        default:                      return codec.BuildEndTransaction();
+        }
+    }
+
+    /// addrLo 40 keeps the precomputed command table out of the way:
+    /// every frame is formatted
+    template <typename Codec>
+    void BM_BuildAllocations(benchmark::State& state, Request request, bool mustNotAllocate)
+    {
+        Codec codec(0x00, 0x28);
+        const uint64_t before = g_allocations.load(std::memory_order_relaxed);
+        for (auto _ : state)
+        {
+            auto frame = BuildRequest(codec, request);
+            benchmark::DoNotOptimize(frame.data());
+        }
+        const uint64_t allocations = g_allocations.load(std::memory_order_relaxed) - before;
+
+        state.counters["allocs_per_frame"] =
+            static_cast<double>(allocations) / static_cast<double>(state.iterations());
+        state.SetItemsProcessed(state.iterations());
+        if (mustNotAllocate && allocations != 0)
+            state.SkipWithError("Frame builder allocated on the heap");
+    }
+
+    struct RequestName
+    {
+        Request request;
+        const char* name;
+    };
+
+    const RequestName REQUESTS[] = {
+        { Request::Status, "Status" },
+        { Request::VolumePreset, "VolumePreset" },
+        { Request::MoneyPreset, "MoneyPreset" },
+        { Request::TotalCounter, "TotalCounter" },
+        { Request::EndTransaction, "EndTransaction" },
+    };
+
+    bool RegisterAll()
+    {
+        for (const RequestName& r : REQUESTS)
+        {
+            const std::string name = r.name;
+            benchmark::RegisterBenchmark(("BM_BuildAllocations/Frame/" + name).c_str(),
+                BM_BuildAllocations<Protocol::GasKitProtocol>, r.request, true);
+            benchmark::RegisterBenchmark(("BM_BuildAllocations/Wide/" + name).c_str(),
+                BM_BuildAllocations<Protocol::GasKitWideProtocol>, r.request, true);
+            benchmark::RegisterBenchmark(("BM_BuildAllocations/Legacy/" + name).c_str(),
+                BM_BuildAllocations<Legacy::GasKitProtocol>, r.request, false);
+        }
+        return true;
+    }
+
+    const bool REGISTERED = RegisterAll();
+
+#if defined(MFM_BENCH_EXCHANGE)
+    /// SR exchange over a pty, the S reply queued before the request
+    /// goes out: TX, drain, decode and the raw bytes for the log
+    void BM_ExchangeAllocations(benchmark::State& state)
+    {
+        PtyTransport pty;
+        if (!pty.Open("pty"))
+        {
+            state.SkipWithError("Opening the pty failed");
+            return;
+        }
+
+        Protocol::GasKitProtocol codec;
+        Protocol::FrameDecoder decoder;
+        const Protocol::Frame request = codec.BuildStatusRequest();
+        const Test::Bytes reply = Test::MakeFrame("S10");
+        uint8_t sent[64];
+
+        const uint64_t before = g_allocations.load(std::memory_order_relaxed);
+        for (auto _ : state)
+        {
+            if (write(pty.GetPeerFd(), reply.data(), reply.size()) != static_cast<ssize_t>(reply.size()))
+            {
+                state.SkipWithError("Writing the reply failed");
+                break;
+            }
+            auto raw = pty.SendAndReceive(request, decoder, 100, 3, false);
+            benchmark::DoNotOptimize(raw.data());
+            if (!decoder.HasFrame())
+            {
+                state.SkipWithError("No reply decoded");
+                break;
+            }
+            decoder.ConsumeFrame();
+            if (read(pty.GetPeerFd(), sent, sizeof(sent)) <= 0)
+            {
+                state.SkipWithError("Request not on the line");
+                break;
+            }
+            benchmark::DoNotOptimize(pty.TakeUnread().size());
+        }
+        const uint64_t allocations = g_allocations.load(std::memory_order_relaxed) - before;
+        if (state.error_occurred()) return;
+
+        state.counters["allocs_per_exchange"] =
+            static_cast<double>(allocations) / static_cast<double>(state.iterations());
+        if (allocations != 0)
+            state.SkipWithError("Exchange allocated on the heap");
+    }
+
+    BENCHMARK(BM_ExchangeAllocations);
+#endif
+
+
+} // anonymous namespace
+
+BENCHMARK_MAIN();
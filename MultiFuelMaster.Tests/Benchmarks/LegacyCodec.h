@@ -0,0 +1,236 @@
+// ============================================================
+// LegacyCodec.h — The pre-Frame codec, kept as a baseline
+// ============================================================
+// What GasKitProtocol did before the fixed-capacity Frame and
+// the span parsers: std::vector frames assembled from a
+// std::string payload, numbers formatted through
+// std::ostringstream, replies copied out by ExtractPayload and
+// decoded with substr + std::stoi inside try/catch. Benchmarks
+// only; the product code never includes this.
+// ============================================================
+
+#pragma once
+
+#include "GasKitFrame.h"
+#include "GasKitProtocol.h"
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace FuelMaster {
+namespace Legacy {
+
+    class GasKitProtocol
+    {
+    public:
+        GasKitProtocol(uint8_t addrHi = 0x00, uint8_t addrLo = 0x01)
+            : m_addrHi(addrHi), m_addrLo(addrLo)
+        {
+        }
+
+        std::vector<uint8_t> BuildStatusRequest() { return BuildFrame("S"); }
+        std::vector<uint8_t> BuildStop() { return BuildFrame("B"); }
+        std::vector<uint8_t> BuildResume() { return BuildFrame("G"); }
+        std::vector<uint8_t> BuildVolumeRequest() { return BuildFrame("L"); }
+        std::vector<uint8_t> BuildMoneyRequest() { return BuildFrame("R"); }
+        std::vector<uint8_t> BuildTransactionRequest() { return BuildFrame("T"); }
+        std::vector<uint8_t> BuildEndTransaction() { return BuildFrame("N"); }
+
+        std::vector<uint8_t> BuildVolumePreset(int nozzle, int volumeCentiliters, int price)
+        {
+            std::string payload = "V";
+            payload += std::to_string(nozzle);
+            payload += ";";
+            payload += FormatNumber(volumeCentiliters, 6);
+            payload += ";";
+            payload += FormatNumber(price, 4);
+            return BuildFrame(payload);
+        }
+
+        std::vector<uint8_t> BuildMoneyPreset(int nozzle, int money, int price)
+        {
+            std::string payload = "M";
+            payload += std::to_string(nozzle);
+            payload += ";";
+            payload += FormatNumber(money, 6);
+            payload += ";";
+            payload += FormatNumber(price, 4);
+            return BuildFrame(payload);
+        }
+
+        std::vector<uint8_t> BuildTotalCounterRequest(int nozzle)
+        {
+            std::string payload = "C";
+            payload += std::to_string(nozzle);
+            return BuildFrame(payload);
+        }
+
+        // --- Response parsing ---
+
+        Protocol::StatusResponse ParseStatusResponse(const std::vector<uint8_t>& frame)
+        {
+            Protocol::StatusResponse result = {};
+            result.valid = false;
+            if (!ValidateCRC(frame)) return result;
+
+            std::string payload = ExtractPayload(frame);
+            if (payload.size() < 3 || payload[0] != 'S') return result;
+
+            int state = payload[1] - '0';
+            int nozzle = payload[2] - '0';
+            if (state < 0 || state > 9) return result;
+            if (nozzle < 0 || nozzle > 6) return result;
+
+            result.state = static_cast<Protocol::DispenserState>(state);
+            result.nozzle = nozzle;
+            result.valid = true;
+            return result;
+        }
+
+        Protocol::VolumeResponse ParseVolumeResponse(const std::vector<uint8_t>& frame)
+        {
+            Protocol::VolumeResponse result = {};
+            result.valid = false;
+            if (!ValidateCRC(frame)) return result;
+
+            std::string payload = ExtractPayload(frame);
+            if (payload.size() < 11 || payload[0] != 'L') return result;
+            if (!ParseHeader(payload, result)) return result;
+
+            try {
+                result.volumeCentiliters = std::stoi(payload.substr(5, 6));
+            }
+            catch (...) { return result; }
+
+            result.valid = true;
+            return result;
+        }
+
+        Protocol::MoneyResponse ParseMoneyResponse(const std::vector<uint8_t>& frame)
+        {
+            Protocol::MoneyResponse result = {};
+            result.valid = false;
+            if (!ValidateCRC(frame)) return result;
+
+            std::string payload = ExtractPayload(frame);
+            if (payload.size() < 11 || payload[0] != 'R') return result;
+            if (!ParseHeader(payload, result)) return result;
+
+            try {
+                result.money = std::stoi(payload.substr(5, 6));
+            }
+            catch (...) { return result; }
+
+            result.valid = true;
+            return result;
+        }
+
+        Protocol::TransactionResponse ParseTransactionResponse(const std::vector<uint8_t>& frame)
+        {
+            Protocol::TransactionResponse result = {};
+            result.valid = false;
+            if (!ValidateCRC(frame)) return result;
+
+            std::string payload = ExtractPayload(frame);
+            if (payload.size() < 23 || payload[0] != 'T') return result;
+            if (!ParseHeader(payload, result)) return result;
+
+            try {
+                result.money = std::stoi(payload.substr(5, 6));
+                if (payload[11] != ';') return result;
+                result.volumeCentiliters = std::stoi(payload.substr(12, 6));
+                if (payload[18] != ';') return result;
+                result.price = std::stoi(payload.substr(19, 4));
+            }
+            catch (...) { return result; }
+
+            result.valid = true;
+            return result;
+        }
+
+        Protocol::TotalCounterResponse ParseTotalCounterResponse(const std::vector<uint8_t>& frame)
+        {
+            Protocol::TotalCounterResponse result = {};
+            result.valid = false;
+            if (!ValidateCRC(frame)) return result;
+
+            std::string payload = ExtractPayload(frame);
+            if (payload.size() < 12 || payload[0] != 'C') return result;
+
+            result.nozzle = payload[1] - '0';
+            if (payload[2] != ';') return result;
+
+            try {
+                result.totalCentiliters = std::stoll(payload.substr(3, 9));
+            }
+            catch (...) { return result; }
+
+            result.valid = true;
+            return result;
+        }
+
+        bool ValidateCRC(const std::vector<uint8_t>& frame)
+        {
+            if (frame.size() < 5) return false;
+            if (frame[0] != Protocol::STX) return false;
+            return CalculateCRC(frame, 1, frame.size() - 2) == frame[frame.size() - 1];
+        }
+
+        std::string ExtractPayload(const std::vector<uint8_t>& frame)
+        {
+            if (frame.size() < 5) return "";
+
+            std::string payload;
+            for (size_t i = 3; i < frame.size() - 1; i++)
+                payload += static_cast<char>(frame[i]);
+            return payload;
+        }
+
+        uint8_t CalculateCRC(const std::vector<uint8_t>& data, size_t from, size_t to)
+        {
+            uint8_t crc = 0;
+            for (size_t i = from; i <= to && i < data.size(); i++)
+                crc ^= data[i];
+            return crc;
+        }
+
+    private:
+        uint8_t m_addrHi;
+        uint8_t m_addrLo;
+
+        /// "gis;" of L/R/T
+        template <typename Response>
+        static bool ParseHeader(const std::string& payload, Response& result)
+        {
+            result.nozzle = payload[1] - '0';
+            result.transactionId = payload[2];
+            int state = payload[3] - '0';
+            if (state < 0 || state > 9) return false;
+            result.state = static_cast<Protocol::DispenserState>(state);
+            return payload[4] == ';';
+        }
+
+        std::vector<uint8_t> BuildFrame(const std::string& payload)
+        {
+            std::vector<uint8_t> frame;
+            frame.push_back(Protocol::STX);
+            frame.push_back(m_addrHi);
+            frame.push_back(m_addrLo);
+            for (char c : payload)
+                frame.push_back(static_cast<uint8_t>(c));
+            frame.push_back(CalculateCRC(frame, 1, frame.size() - 1));
+            return frame;
+        }
+
+        static std::string FormatNumber(int value, int width)
+        {
+            std::ostringstream oss;
+            oss << std::setw(width) << std::setfill('0') << value;
+            return oss.str();
+        }
+    };
+
+} // namespace Legacy
+} // namespace FuelMaster
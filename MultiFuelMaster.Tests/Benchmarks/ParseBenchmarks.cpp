@@ -0,0 +1,133 @@
+// ============================================================
+// ParseBenchmarks.cpp — Span parsers vs the string / stoi path
+// ============================================================
+// Same standard-dialect frames through GasKitProtocol's span
+// parsers and through the former ExtractPayload + substr +
+// std::stoi path (LegacyCodec.h). The "bad digit" rows carry a
+// CRC-valid T reply with garbage in the money field, the case
+// where std::stoi threw on the polling thread. Both paths must
+// agree on every frame; a mismatch fails the benchmark.
+// ============================================================
+
+#include "GasKitProtocol.h"
+#include "GasKitSamples.h"
+#include "LegacyCodec.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+using namespace FuelMaster;
+
+namespace
+{
+    enum class Reply : int { Status, Volume, Money, Transaction, TotalCounter };
+
+    struct ReplyFrame
+    {
+        Reply reply;
+        const char* name;
+        const char* payload;
+    };
+
+    const ReplyFrame REPLIES[] = {
+        { Reply::Status,       "S",             "S61" },
+        { Reply::Volume,       "L",             "L1A6;001234" },
+        { Reply::Money,        "R",             "R1A6;005678" },
+        { Reply::Transaction,  "T",             "T1A9;005678;001234;4590" },
+        { Reply::TotalCounter, "C",             "C1;000123456" },
+        { Reply::Transaction,  "T_bad_digit",   "T1A9;?05678;001234;4590" },
+    };
+
+    /// valid flag plus the numeric fields, whichever the reply has
+    template <typename Codec, typename Frame>
+    long long Parse(Codec& codec, Reply reply, const Frame& frame, bool& valid)
+    {
+        switch (reply)
+        {
+        case Reply::Status:
+        {
+            auto r = codec.ParseStatusResponse(frame);
+            valid = r.valid;
+            return static_cast<long long>(r.state) * 10 + r.nozzle;
+        }
+        case Reply::Volume:
+        {
+            auto r = codec.ParseVolumeResponse(frame);
+            valid = r.valid;
+            return r.volumeCentiliters;
+        }
+        case Reply::Money:
+        {
+            auto r = codec.ParseMoneyResponse(frame);
+            valid = r.valid;
+            return r.money;
+        }
+        case Reply::Transaction:
+        {
+            auto r = codec.ParseTransactionResponse(frame);
+            valid = r.valid;
+            return valid ? (static_cast<long long>(r.money) * 1000000 + r.volumeCentiliters) * 10000 + r.price : 0;
+        }
+        default:
+        {
+            auto r = codec.ParseTotalCounterResponse(frame);
+            valid = r.valid;
+            return r.totalCentiliters;
+        }
+        }
+    }
+
+    void BM_ParseSpan(benchmark::State& state, const ReplyFrame& sample)
+    {
+        Protocol::GasKitProtocol codec;
+        const Test::Bytes bytes = Test::MakeFrame(sample.payload);
+        const std::span<const uint8_t> frame(bytes);
+
+        for (auto _ : state)
+        {
+            bool valid = false;
+            long long value = Parse(codec, sample.reply, frame, valid);
+            benchmark::DoNotOptimize(value);
+            benchmark::DoNotOptimize(valid);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_ParseLegacy(benchmark::State& state, const ReplyFrame& sample)
+    {
+        Legacy::GasKitProtocol codec;
+        const Test::Bytes frame = Test::MakeFrame(sample.payload);
+
+        for (auto _ : state)
+        {
+            bool valid = false;
+            long long value = Parse(codec, sample.reply, frame, valid);
+            benchmark::DoNotOptimize(value);
+            benchmark::DoNotOptimize(valid);
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        // Same verdict and fields from both paths
+        Protocol::GasKitProtocol span;
+        bool legacyValid = false, spanValid = false;
+        const long long legacyValue = Parse(codec, sample.reply, frame, legacyValid);
+        const long long spanValue = Parse(span, sample.reply, std::span<const uint8_t>(frame), spanValid);
+        if (legacyValid != spanValid || (spanValid && legacyValue != spanValue))
+            state.SkipWithError("span parser disagrees with the legacy parser");
+    }
+
+    bool RegisterAll()
+    {
+        for (const ReplyFrame& sample : REPLIES)
+        {
+            const std::string name = sample.name;
+            benchmark::RegisterBenchmark(("BM_Parse/Span/" + name).c_str(), BM_ParseSpan, sample);
+            benchmark::RegisterBenchmark(("BM_Parse/Legacy/" + name).c_str(), BM_ParseLegacy, sample);
+        }
+        return true;
+    }
+
+    const bool REGISTERED = RegisterAll();
+
+} // anonymous namespace
+
+BENCHMARK_MAIN();
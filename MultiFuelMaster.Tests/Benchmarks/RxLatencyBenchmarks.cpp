@@ -0,0 +1,122 @@
+// ============================================================
+// RxLatencyBenchmarks.cpp — Receive wakeups and reply latency
+// ============================================================
+// DispenserController polls an idle post (PtyDispenser.h) over
+// a PtyTransport. One iteration is one SR exchange: the time from
+// the post writing its reply to the controller's status callback
+// (manual time, so the Time column is the mean latency). Counters
+// give the median and p99 of that latency and the transport's RX
+// wakeups, per second and per reply; the CPU column is the whole
+// process (polling thread and simulated post).
+//   ./bench_rx_latency --benchmark_counters_tabular=true
+// ============================================================
+
+#include "DispenserController.h"
+#include "PtyDispenser.h"
+#include "PtyTransport.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace FuelMaster;
+namespace Samples = FuelMaster::Test;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int REPLIES = 200;
+
+    int64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    double Percentile(std::vector<double> samples, double p)
+    {
+        if (samples.empty()) return 0.0;
+        const size_t k = std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())));
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(k), samples.end());
+        return samples[k];
+    }
+
+    /// Arg: idle poll period (ms)
+    void BM_ReplyToCallback(benchmark::State& state)
+    {
+        auto pty = std::make_unique<PtyTransport>();
+        Samples::PtyDispenser dispenser(pty->GetPeerFd());
+        dispenser.SetReplyDelayMs(0);
+
+        std::mutex mutex;
+        std::condition_variable arrived;
+        std::vector<double> latencyUs;
+        latencyUs.reserve(REPLIES * 2);
+
+        DispenserController controller;
+        TimingParams timing = TimingParams::Default();
+        timing.idlePollDelayMs = static_cast<int>(state.range(0));
+        controller.SetTimingParams(timing);
+        controller.SetStatusCallback([&](Protocol::DispenserState, int) {
+            const double us = static_cast<double>(NowNs() - dispenser.GetLastReplyNs()) / 1000.0;
+            std::lock_guard<std::mutex> lock(mutex);
+            latencyUs.push_back(us);
+            arrived.notify_one();
+        });
+
+        if (!controller.Connect(std::move(pty), "pty", "01"))
+        {
+            state.SkipWithError("Connect over the pty failed");
+            return;
+        }
+
+        // Skip the connect-time exchanges
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            arrived.wait_for(lock, std::chrono::seconds(2), [&] { return !latencyUs.empty(); });
+            latencyUs.clear();
+        }
+
+        const uint64_t wakeupsBefore = controller.GetRxWakeups();
+        const auto start = Clock::now();
+        size_t seen = 0;
+
+        for (auto _ : state)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (!arrived.wait_for(lock, std::chrono::seconds(2), [&] { return latencyUs.size() > seen; }))
+            {
+                state.SkipWithError("No status callback within 2 s");
+                break;
+            }
+            state.SetIterationTime(latencyUs[seen] / 1e6);
+            seen = latencyUs.size();
+        }
+
+        const double elapsedSec = std::chrono::duration<double>(Clock::now() - start).count();
+        const uint64_t wakeups = controller.GetRxWakeups() - wakeupsBefore;
+        controller.Disconnect();
+        dispenser.Stop();
+
+        if (state.error_occurred()) return;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        state.counters["median_us"] = Percentile(latencyUs, 0.50);
+        state.counters["p99_us"] = Percentile(latencyUs, 0.99);
+        state.counters["wakeups_per_s"] = static_cast<double>(wakeups) / elapsedSec;
+        state.counters["wakeups_per_reply"] = static_cast<double>(wakeups) / static_cast<double>(latencyUs.size());
+    }
+
+} // anonymous namespace
+
+BENCHMARK(BM_ReplyToCallback)
+    ->Arg(10)->Arg(25)
+    ->Iterations(REPLIES)
+    ->UseManualTime()
+    ->MeasureProcessCPUTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
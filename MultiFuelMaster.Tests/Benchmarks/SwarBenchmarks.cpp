@@ -0,0 +1,156 @@
+// ============================================================
+// SwarBenchmarks.cpp — Digit and checksum kernels
+// ============================================================
+// Per field width: the SWAR kernel, the scalar reference and
+// the former substr + std::stoi decoding. Checksum: XorChecksum
+// (SSE2 where available), the scalar reference and the former
+// byte loop of CalculateCRC (LegacyCodec.h), over one T frame
+// of each dialect and over a 1 MiB archive of captured frames.
+// ============================================================
+
+#include "GasKitSamples.h"
+#include "GasKitSwar.h"
+#include "LegacyCodec.h"
+#include <benchmark/benchmark.h>
+#include <string>
+
+using namespace FuelMaster;
+using namespace FuelMaster::Protocol;
+
+namespace
+{
+    // ============================================================
+    // DIGIT FIELDS
+    // ============================================================
+
+    const char DIGITS[] = "123456789";
+
+    template <size_t Width>
+    void BM_DigitsSwar(benchmark::State& state)
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(DIGITS);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(p);
+            uint32_t value = 0;
+            bool ok = Swar::ParseDigits<Width>(p, value);
+            benchmark::DoNotOptimize(ok);
+            benchmark::DoNotOptimize(value);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    template <size_t Width>
+    void BM_DigitsScalar(benchmark::State& state)
+    {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(DIGITS);
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(p);
+            uint32_t value = 0;
+            bool ok = Swar::ParseDigitsScalar(p, Width, value);
+            benchmark::DoNotOptimize(ok);
+            benchmark::DoNotOptimize(value);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /// What the parsers did before: substr of the payload, then stoll
+    template <size_t Width>
+    void BM_DigitsStoi(benchmark::State& state)
+    {
+        const std::string payload = DIGITS;
+        for (auto _ : state)
+        {
+            long long value = 0;
+            try {
+                value = std::stoll(payload.substr(0, Width));
+            }
+            catch (...) {}
+            benchmark::DoNotOptimize(value);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // ============================================================
+    // XOR CHECKSUM — bytes 1 .. n-2, as ValidateCRC covers them
+    // ============================================================
+
+    Test::Bytes Archive()
+    {
+        // Captured T/L/R/S/C traffic, back to back, ~1 MiB
+        Test::Bytes archive;
+        const Test::Bytes line = Test::SampleLineCapture();
+        while (archive.size() < (1u << 20))
+            archive.insert(archive.end(), line.begin(), line.end());
+        return archive;
+    }
+
+    Test::Bytes Input(int which)
+    {
+        switch (which)
+        {
+        case 0:  return Test::MakeFrame("T1A9;005678;001234;4590");
+        case 1:  return Test::MakeFrame("T1A9;00005678;00001234;004590");
+        default: return Archive();
+        }
+    }
+
+    void BM_XorSwar(benchmark::State& state)
+    {
+        const Test::Bytes data = Input(static_cast<int>(state.range(0)));
+        for (auto _ : state)
+        {
+            uint8_t crc = Swar::XorChecksum(data.data() + 1, data.size() - 2);
+            benchmark::DoNotOptimize(crc);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (data.size() - 2)));
+    }
+
+    void BM_XorScalar(benchmark::State& state)
+    {
+        const Test::Bytes data = Input(static_cast<int>(state.range(0)));
+        for (auto _ : state)
+        {
+            uint8_t crc = Swar::XorChecksumScalar(data.data() + 1, data.size() - 2);
+            benchmark::DoNotOptimize(crc);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (data.size() - 2)));
+    }
+
+    void BM_XorLegacyCalculateCRC(benchmark::State& state)
+    {
+        Legacy::GasKitProtocol codec;
+        const Test::Bytes data = Input(static_cast<int>(state.range(0)));
+        for (auto _ : state)
+        {
+            uint8_t crc = codec.CalculateCRC(data, 1, data.size() - 2);
+            benchmark::DoNotOptimize(crc);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * (data.size() - 2)));
+
+        if (codec.CalculateCRC(data, 1, data.size() - 2) != Swar::XorChecksum(data.data() + 1, data.size() - 2))
+            state.SkipWithError("XorChecksum disagrees with CalculateCRC");
+    }
+
+} // anonymous namespace
+
+BENCHMARK_TEMPLATE(BM_DigitsSwar, 4);
+BENCHMARK_TEMPLATE(BM_DigitsScalar, 4);
+BENCHMARK_TEMPLATE(BM_DigitsStoi, 4);
+BENCHMARK_TEMPLATE(BM_DigitsSwar, 6);
+BENCHMARK_TEMPLATE(BM_DigitsScalar, 6);
+BENCHMARK_TEMPLATE(BM_DigitsStoi, 6);
+BENCHMARK_TEMPLATE(BM_DigitsSwar, 8);
+BENCHMARK_TEMPLATE(BM_DigitsScalar, 8);
+BENCHMARK_TEMPLATE(BM_DigitsStoi, 8);
+BENCHMARK_TEMPLATE(BM_DigitsSwar, 9);
+BENCHMARK_TEMPLATE(BM_DigitsScalar, 9);
+BENCHMARK_TEMPLATE(BM_DigitsStoi, 9);
+
+// Arg: 0 = T frame, 1 = wide T frame, 2 = 1 MiB archive
+BENCHMARK(BM_XorSwar)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(BM_XorScalar)->Arg(0)->Arg(1)->Arg(2);
+BENCHMARK(BM_XorLegacyCalculateCRC)->Arg(0)->Arg(1)->Arg(2);
+
+BENCHMARK_MAIN();
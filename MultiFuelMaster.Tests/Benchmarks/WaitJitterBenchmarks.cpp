@@ -0,0 +1,49 @@
+// ============================================================
+// WaitJitterBenchmarks.cpp — Precise sleeps vs sleep_for
+// ============================================================
+// One MeasureWaitJitter run per requested delay (PreciseWait.h):
+// SleepUs against std::this_thread::sleep_for, achieved mean,
+// p99 and max as counters, the Report() line as the label.
+// SleepUs must never return before the requested delay.
+// ============================================================
+
+#include "PreciseWait.h"
+#include <benchmark/benchmark.h>
+
+using namespace FuelMaster;
+
+namespace
+{
+    /// Args: requested delay (us), samples per method
+    void BM_WaitJitter(benchmark::State& state)
+    {
+        const int requestedUs = static_cast<int>(state.range(0));
+        const int samples = static_cast<int>(state.range(1));
+
+        WaitJitterReport report = {};
+        for (auto _ : state)
+            report = MeasureWaitJitter(requestedUs, samples);
+
+        state.counters["precise_mean_us"] = report.precise.meanUs;
+        state.counters["precise_p99_us"] = report.precise.p99Us;
+        state.counters["precise_max_us"] = report.precise.maxUs;
+        state.counters["sleep_for_mean_us"] = report.baseline.meanUs;
+        state.counters["sleep_for_p99_us"] = report.baseline.p99Us;
+        state.SetLabel(report.Report());
+
+        if (report.precise.minUs < requestedUs)
+            state.SkipWithError("SleepUs returned before the requested delay");
+    }
+
+} // anonymous namespace
+
+// 10 ms: the LM->RS pause and the fuelling poll interval
+BENCHMARK(BM_WaitJitter)
+    ->Args({ 500, 400 })
+    ->Args({ 1000, 200 })
+    ->Args({ 10000, 50 })
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,180 @@
+// ============================================================
+// FuzzCheck.h — Invariants shared by the codec fuzz harnesses
+// ============================================================
+// Each harness feeds the input to both dialects and checks that
+// what the codec accepts is really a well-formed reply: STX,
+// valid CRC, full-length payload, digits that re-parse to the
+// same value with the scalar reference kernel, and agreement
+// between the typed parser and ParseResponse. A violated
+// invariant aborts, which both libFuzzer and the standalone
+// driver report as a crash with the offending input.
+// ============================================================
+
+#pragma once
+
+#include "GasKitProtocol.h"
+#include "GasKitSwar.h"
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <variant>
+
+#define FUZZ_CHECK(cond)                                                        \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            fprintf(stderr, "%s:%d: invariant failed: %s\n", __FILE__, __LINE__, #cond); \
+            abort();                                                            \
+        }                                                                       \
+    } while (0)
+
+namespace FuelMaster {
+namespace Fuzz {
+
+    using Protocol::ParseError;
+
+    /// Value of `width` digits at p by the scalar reference (-1 if not digits)
+    inline long long ReferenceDigits(const uint8_t* p, size_t width)
+    {
+        uint32_t value = 0;
+        if (!Protocol::Swar::ParseDigitsScalar(p, width, value)) return -1;
+        return value;
+    }
+
+    /// Checks every accepted frame must pass, whatever its command
+    template <typename Codec, typename Result>
+    void CheckEnvelope(Codec& codec, std::span<const uint8_t> frame, const Result& r,
+                       char cmd, size_t payloadSize)
+    {
+        using Layout = typename Codec::Layout;
+        if (!r.valid)
+        {
+            FUZZ_CHECK(r.error != ParseError::None);
+            return;
+        }
+        FUZZ_CHECK(r.error == ParseError::None);
+        FUZZ_CHECK(frame.size() >= Layout::Overhead + payloadSize);
+        FUZZ_CHECK(frame[0] == Protocol::STX);
+        FUZZ_CHECK(frame[Layout::PayloadOffset] == static_cast<uint8_t>(cmd));
+        FUZZ_CHECK(codec.ValidateCRC(frame));
+    }
+
+    /// "gis;" header of L/R/T against the raw payload
+    template <typename Result>
+    void CheckNozzleTxnState(const uint8_t* payload, const Result& r)
+    {
+        FUZZ_CHECK(r.nozzle == payload[1] - '0' && r.nozzle >= 0 && r.nozzle <= 9);
+        FUZZ_CHECK(r.transactionId == static_cast<char>(payload[2]));
+        FUZZ_CHECK(static_cast<int>(r.state) == payload[3] - '0');
+        FUZZ_CHECK(payload[4] == ';');
+    }
+
+    // ============================================================
+    // Per-parser checks
+    // ============================================================
+
+    template <typename Codec>
+    void CheckStatus(Codec& codec, std::span<const uint8_t> frame)
+    {
+        using Layout = typename Codec::Layout;
+        Protocol::StatusResponse r = codec.ParseStatusResponse(frame);
+        CheckEnvelope(codec, frame, r, 'S', Layout::StatusPayload);
+        if (!r.valid) return;
+
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        FUZZ_CHECK(static_cast<int>(r.state) == payload[1] - '0');
+        FUZZ_CHECK(r.nozzle == payload[2] - '0' && r.nozzle >= 0 && r.nozzle <= 6);
+    }
+
+    template <typename Codec>
+    void CheckVolume(Codec& codec, std::span<const uint8_t> frame)
+    {
+        using Layout = typename Codec::Layout;
+        using Dialect = typename Codec::DialectType;
+        Protocol::VolumeResponse r = codec.ParseVolumeResponse(frame);
+        CheckEnvelope(codec, frame, r, 'L', Layout::VolumePayload);
+        if (!r.valid) return;
+
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        CheckNozzleTxnState(payload, r);
+        FUZZ_CHECK(r.volumeCentiliters == ReferenceDigits(payload + 5, Dialect::VolumeDigits));
+    }
+
+    template <typename Codec>
+    void CheckMoney(Codec& codec, std::span<const uint8_t> frame)
+    {
+        using Layout = typename Codec::Layout;
+        using Dialect = typename Codec::DialectType;
+        Protocol::MoneyResponse r = codec.ParseMoneyResponse(frame);
+        CheckEnvelope(codec, frame, r, 'R', Layout::MoneyPayload);
+        if (!r.valid) return;
+
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        CheckNozzleTxnState(payload, r);
+        FUZZ_CHECK(r.money == ReferenceDigits(payload + 5, Dialect::MoneyDigits));
+    }
+
+    template <typename Codec>
+    void CheckTransaction(Codec& codec, std::span<const uint8_t> frame)
+    {
+        using Layout = typename Codec::Layout;
+        using Dialect = typename Codec::DialectType;
+        Protocol::TransactionResponse r = codec.ParseTransactionResponse(frame);
+        CheckEnvelope(codec, frame, r, 'T', Layout::TransactionPayload);
+        if (!r.valid) return;
+
+        constexpr size_t moneyPos = 5;
+        constexpr size_t volumePos = moneyPos + Dialect::MoneyDigits + 1;
+        constexpr size_t pricePos = volumePos + Dialect::VolumeDigits + 1;
+
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        CheckNozzleTxnState(payload, r);
+        FUZZ_CHECK(r.money == ReferenceDigits(payload + moneyPos, Dialect::MoneyDigits));
+        FUZZ_CHECK(r.volumeCentiliters == ReferenceDigits(payload + volumePos, Dialect::VolumeDigits));
+        FUZZ_CHECK(r.price == ReferenceDigits(payload + pricePos, Dialect::PriceDigits));
+    }
+
+    template <typename Codec>
+    void CheckTotalCounter(Codec& codec, std::span<const uint8_t> frame)
+    {
+        using Layout = typename Codec::Layout;
+        using Dialect = typename Codec::DialectType;
+        Protocol::TotalCounterResponse r = codec.ParseTotalCounterResponse(frame);
+        CheckEnvelope(codec, frame, r, 'C', Layout::TotalPayload);
+        if (!r.valid) return;
+
+        const uint8_t* payload = frame.data() + Layout::PayloadOffset;
+        FUZZ_CHECK(r.nozzle == payload[1] - '0' && r.nozzle >= 0 && r.nozzle <= 9);
+        FUZZ_CHECK(payload[2] == ';');
+        FUZZ_CHECK(r.totalCentiliters == ReferenceDigits(payload + 3, Dialect::TotalDigits));
+    }
+
+    /// ParseResponse must pick the typed parser of the command letter,
+    /// and DecodeValidatedFrame must agree with it on CRC-valid frames
+    template <typename Codec>
+    void CheckDispatch(Codec& codec, std::span<const uint8_t> frame)
+    {
+        using Layout = typename Codec::Layout;
+        Protocol::Response r = codec.ParseResponse(frame);
+        if (std::holds_alternative<std::monostate>(r))
+        {
+            if (codec.ValidateCRC(frame))
+                FUZZ_CHECK(std::holds_alternative<std::monostate>(codec.DecodeValidatedFrame(frame)));
+            return;
+        }
+
+        FUZZ_CHECK(codec.ValidateCRC(frame));
+        FUZZ_CHECK(codec.DecodeValidatedFrame(frame).index() == r.index());
+
+        switch (static_cast<char>(frame[Layout::PayloadOffset]))
+        {
+        case 'S': FUZZ_CHECK(std::holds_alternative<Protocol::StatusResponse>(r)); break;
+        case 'L': FUZZ_CHECK(std::holds_alternative<Protocol::VolumeResponse>(r)); break;
+        case 'R': FUZZ_CHECK(std::holds_alternative<Protocol::MoneyResponse>(r)); break;
+        case 'T': FUZZ_CHECK(std::holds_alternative<Protocol::TransactionResponse>(r)); break;
+        case 'C': FUZZ_CHECK(std::holds_alternative<Protocol::TotalCounterResponse>(r)); break;
+        default:  FUZZ_CHECK(!"unknown command decoded");
+        }
+    }
+
+} // namespace Fuzz
+} // namespace FuelMaster
@@ -0,0 +1,184 @@
+// ============================================================
+// FuzzDriver.cpp — Standalone driver for the fuzz harnesses
+// ============================================================
+// Used when the harnesses are not linked with libFuzzer (GCC,
+// MSVC, MFM_LIBFUZZER=OFF). Replays the seed corpus, then runs
+// a fixed-seed sequence of mutated seeds (bit flips, byte
+// replace / insert / erase, truncation, splicing two seeds) so
+// ctest exercises every harness deterministically.
+//   <harness> [-runs=N] [-seed=N] [file|dir ...]
+//   <harness> --write-corpus DIR     seeds as files, for libFuzzer
+// Files and directories given on the command line are replayed
+// as-is (crash reproducers, libFuzzer corpora).
+// ============================================================
+
+#include "FuzzSeeds.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#ifndef MFM_FUZZ_SEED_SET
+#define MFM_FUZZ_SEED_SET Frame
+#endif
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+using namespace FuelMaster::Fuzz;
+
+namespace
+{
+    class XorShift
+    {
+    public:
+        explicit XorShift(uint64_t seed) : m_state(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+        uint64_t Next()
+        {
+            m_state ^= m_state << 13;
+            m_state ^= m_state >> 7;
+            m_state ^= m_state << 17;
+            return m_state;
+        }
+
+        size_t Below(size_t n) { return n ? static_cast<size_t>(Next() % n) : 0; }
+
+    private:
+        uint64_t m_state;
+    };
+
+    /// Bytes a dispenser line is likely to carry: STX, separators, digits, letters
+    uint8_t InterestingByte(XorShift& rng)
+    {
+        static const uint8_t BYTES[] = {
+            0x02, 0x00, 0x01, 0xFF, ';', '0', '9', '/', ':',
+            'S', 'L', 'R', 'T', 'C', 'A'
+        };
+        if (rng.Below(2)) return static_cast<uint8_t>(rng.Next());
+        return BYTES[rng.Below(sizeof(BYTES))];
+    }
+
+    Bytes Mutate(const std::vector<Bytes>& seeds, XorShift& rng)
+    {
+        Bytes input = seeds[rng.Below(seeds.size())];
+        const size_t steps = 1 + rng.Below(4);
+
+        for (size_t step = 0; step < steps; step++)
+        {
+            switch (rng.Below(6))
+            {
+            case 0:     // flip one bit
+                if (!input.empty()) input[rng.Below(input.size())] ^= static_cast<uint8_t>(1u << rng.Below(8));
+                break;
+            case 1:     // replace a byte
+                if (!input.empty()) input[rng.Below(input.size())] = InterestingByte(rng);
+                break;
+            case 2:     // insert a byte
+                input.insert(input.begin() + static_cast<std::ptrdiff_t>(rng.Below(input.size() + 1)),
+                             InterestingByte(rng));
+                break;
+            case 3:     // erase a byte
+                if (!input.empty()) input.erase(input.begin() + static_cast<std::ptrdiff_t>(rng.Below(input.size())));
+                break;
+            case 4:     // truncate
+                input.resize(rng.Below(input.size() + 1));
+                break;
+            default:    // splice the tail of another seed
+            {
+                const Bytes& other = seeds[rng.Below(seeds.size())];
+                const size_t from = rng.Below(other.size() + 1);
+                input.resize(rng.Below(input.size() + 1));
+                input.insert(input.end(), other.begin() + static_cast<std::ptrdiff_t>(from), other.end());
+                break;
+            }
+            }
+        }
+        return input;
+    }
+
+    void RunOne(const Bytes& input)
+    {
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+
+    bool ReplayFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            fprintf(stderr, "cannot read %s\n", path.string().c_str());
+            return false;
+        }
+        Bytes input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        RunOne(input);
+        return true;
+    }
+
+    bool WriteCorpus(const std::vector<Bytes>& seeds, const std::filesystem::path& dir)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        for (size_t i = 0; i < seeds.size(); i++)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "seed-%04zu", i);
+            std::ofstream file(dir / name, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(seeds[i].data()),
+                       static_cast<std::streamsize>(seeds[i].size()));
+            if (!file)
+            {
+                fprintf(stderr, "cannot write %s\n", (dir / name).string().c_str());
+                return false;
+            }
+        }
+        printf("%zu seeds written to %s\n", seeds.size(), dir.string().c_str());
+        return true;
+    }
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const std::vector<Bytes> seeds = SeedInputs(SeedSet::MFM_FUZZ_SEED_SET);
+    unsigned long runs = 20000;
+    unsigned long long seed = 1;
+    size_t replayed = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        if (strncmp(arg, "-runs=", 6) == 0)
+            runs = strtoul(arg + 6, nullptr, 10);
+        else if (strncmp(arg, "-seed=", 6) == 0)
+            seed = strtoull(arg + 6, nullptr, 10);
+        else if (strcmp(arg, "--write-corpus") == 0 && i + 1 < argc)
+            return WriteCorpus(seeds, argv[++i]) ? 0 : 1;
+        else if (std::filesystem::is_directory(arg))
+        {
+            for (const auto& entry : std::filesystem::directory_iterator(arg))
+            {
+                if (!entry.is_regular_file()) continue;
+                if (!ReplayFile(entry.path())) return 1;
+                replayed++;
+            }
+        }
+        else
+        {
+            if (!ReplayFile(arg)) return 1;
+            replayed++;
+        }
+    }
+
+    for (const Bytes& input : seeds)
+        RunOne(input);
+
+    XorShift rng(seed);
+    for (unsigned long run = 0; run < runs; run++)
+        RunOne(Mutate(seeds, rng));
+
+    printf("%zu seeds, %zu files, %lu mutated inputs (seed %llu): no invariant failed\n",
+           seeds.size(), replayed, runs, seed);
+    return 0;
+}
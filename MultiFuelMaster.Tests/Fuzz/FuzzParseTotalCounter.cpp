@@ -0,0 +1,20 @@
+// ============================================================
+// FuzzParseTotalCounter.cpp — Fuzz harness: ParseTotalCounterResponse
+// ============================================================
+// The input is one candidate frame, parsed by both dialects.
+// ============================================================
+
+#include "FuzzCheck.h"
+
+using namespace FuelMaster;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    std::span<const uint8_t> frame(data, size);
+
+    Protocol::GasKitProtocol standard;
+    Protocol::GasKitWideProtocol wide;
+    Fuzz::CheckTotalCounter(standard, frame);
+    Fuzz::CheckTotalCounter(wide, frame);
+    return 0;
+}
@@ -0,0 +1,20 @@
+// ============================================================
+// FuzzParseTransaction.cpp — Fuzz harness: ParseTransactionResponse
+// ============================================================
+// The input is one candidate frame, parsed by both dialects.
+// ============================================================
+
+#include "FuzzCheck.h"
+
+using namespace FuelMaster;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    std::span<const uint8_t> frame(data, size);
+
+    Protocol::GasKitProtocol standard;
+    Protocol::GasKitWideProtocol wide;
+    Fuzz::CheckTransaction(standard, frame);
+    Fuzz::CheckTransaction(wide, frame);
+    return 0;
+}
@@ -0,0 +1,37 @@
+// ============================================================
+// FuzzSeeds.cpp — Seed inputs of the codec fuzz harnesses
+// ============================================================
+
+#include "FuzzSeeds.h"
+#include "GasKitSamples.h"
+
+namespace FuelMaster {
+namespace Fuzz {
+
+    std::vector<Bytes> SeedInputs(SeedSet set)
+    {
+        std::vector<Bytes> frames = Test::AllSampleFrames();
+        if (set == SeedSet::Frame)
+            return frames;
+
+        // Decoder: each reply alone and the whole capture, under every
+        // dialect / filter / expected-command setup the harness knows
+        Bytes capture = Test::SampleLineCapture();
+        frames.push_back(capture);
+
+        std::vector<Bytes> inputs;
+        for (uint8_t setup = 0; setup < 0x18; setup++)
+        {
+            for (const Bytes& line : frames)
+            {
+                Bytes input;
+                input.push_back(setup);
+                input.insert(input.end(), line.begin(), line.end());
+                inputs.push_back(input);
+            }
+        }
+        return inputs;
+    }
+
+} // namespace Fuzz
+} // namespace FuelMaster
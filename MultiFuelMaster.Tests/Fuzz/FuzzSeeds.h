@@ -0,0 +1,28 @@
+// ============================================================
+// FuzzSeeds.h — Seed inputs of the codec fuzz harnesses
+// ============================================================
+// Real S/L/R/T/C replies of both dialects (GasKitSamples.h),
+// plus a line capture with noise and a broken CRC.
+// ============================================================
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace FuelMaster {
+namespace Fuzz {
+
+    using Bytes = std::vector<uint8_t>;
+
+    enum class SeedSet : int
+    {
+        Frame = 0,      // one candidate frame per input (Parse* harnesses)
+        Decoder = 1     // setup byte + line bytes (FrameDecoder harness)
+    };
+
+    /// Seed corpus of a harness kind
+    std::vector<Bytes> SeedInputs(SeedSet set);
+
+} // namespace Fuzz
+} // namespace FuelMaster
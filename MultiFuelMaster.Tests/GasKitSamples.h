@@ -0,0 +1,100 @@
+// ============================================================
+// GasKitSamples.h — Real GasKitLink frames for tests and benches
+// ============================================================
+// Replies as a dispenser sends them (post 1, address {00, 01}):
+// STX, address, payload, XOR CRC over address + payload.
+// Payloads follow the formats of GasKitProtocol.h per dialect.
+// ============================================================
+
+#pragma once
+
+#include "GasKitProtocol.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace FuelMaster {
+namespace Test {
+
+    using Bytes = std::vector<uint8_t>;
+
+    /// Wrap an ASCII payload into a complete frame with a valid CRC
+    inline Bytes MakeFrame(const char* payload, uint8_t addrHi = 0x00, uint8_t addrLo = 0x01)
+    {
+        Bytes frame;
+        frame.push_back(Protocol::STX);
+        frame.push_back(addrHi);
+        frame.push_back(addrLo);
+        frame.insert(frame.end(), payload, payload + strlen(payload));
+
+        uint8_t crc = 0;
+        for (size_t i = 1; i < frame.size(); i++)
+            crc ^= frame[i];
+        frame.push_back(crc);
+        return frame;
+    }
+
+    struct SampleReply
+    {
+        const char* name;
+        const char* payload;
+    };
+
+    // Standard dialect: 6-digit volume/money, 4-digit price, 9-digit totals
+    inline constexpr SampleReply STANDARD_REPLIES[] = {
+        { "S idle",        "S10" },
+        { "S calling",     "S21" },
+        { "S fuelling",    "S61" },
+        { "S end of txn",  "S91" },
+        { "L",             "L1A6;001234" },
+        { "R",             "R1A6;005678" },
+        { "T",             "T1A9;005678;001234;4590" },
+        { "C",             "C1;000123456" },
+    };
+
+    // Wide dialect: 8-digit volume/money, 6-digit price
+    inline constexpr SampleReply WIDE_REPLIES[] = {
+        { "S idle",        "S10" },
+        { "S fuelling",    "S61" },
+        { "L",             "L1A6;00001234" },
+        { "R",             "R1A6;00005678" },
+        { "T",             "T1A9;00005678;00001234;004590" },
+        { "C",             "C1;000123456" },
+    };
+
+    /// Every sample reply of both dialects as a frame
+    inline std::vector<Bytes> AllSampleFrames()
+    {
+        std::vector<Bytes> frames;
+        for (const SampleReply& reply : STANDARD_REPLIES)
+            frames.push_back(MakeFrame(reply.payload));
+        for (const SampleReply& reply : WIDE_REPLIES)
+            frames.push_back(MakeFrame(reply.payload));
+        return frames;
+    }
+
+    /// Standard-dialect line capture: noise, replies, a broken CRC,
+    /// a reply from another post — what the decoder sees in practice
+    inline Bytes SampleLineCapture()
+    {
+        Bytes line = { 0x00, 0xFF, 0x7E };
+        for (const SampleReply& reply : STANDARD_REPLIES)
+        {
+            Bytes frame = MakeFrame(reply.payload);
+            line.insert(line.end(), frame.begin(), frame.end());
+        }
+
+        Bytes corrupt = MakeFrame("L1A6;001234");
+        corrupt.back() ^= 0x01;
+        line.insert(line.end(), corrupt.begin(), corrupt.end());
+
+        Bytes otherPost = MakeFrame("S61", 0x00, 0x02);
+        line.insert(line.end(), otherPost.begin(), otherPost.end());
+
+        Bytes tail = MakeFrame("S91");
+        line.insert(line.end(), tail.begin(), tail.end());
+        return line;
+    }
+
+} // namespace Test
+} // namespace FuelMaster
@@ -0,0 +1,172 @@
+// ============================================================
+// PtyDispenser.h — Simulated GasKitLink post on a pty (Linux)
+// ============================================================
+// Sits on the master side of a PtyTransport and answers the
+// controller like a standard-dialect dispenser: SR with the
+// current state and nozzle, LM/RS/TU/C0 with the configured
+// values, every other command (V, M, B, G, N) with a status
+// reply. The state is set by the test; requests are counted
+// per command letter.
+// ============================================================
+
+#pragma once
+
+#include "GasKitSamples.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+
+namespace FuelMaster {
+namespace Test {
+
+    class PtyDispenser
+    {
+    public:
+        /// fd: PtyTransport::GetPeerFd(); addrLo: the post's address
+        explicit PtyDispenser(int fd, uint8_t addrLo = 0x01)
+            : m_fd(fd), m_addrLo(addrLo)
+        {
+            m_thread = std::thread(&PtyDispenser::Run, this);
+        }
+
+        ~PtyDispenser() { Stop(); }
+
+        PtyDispenser(const PtyDispenser&) = delete;
+        PtyDispenser& operator=(const PtyDispenser&) = delete;
+
+        void Stop()
+        {
+            m_running.store(false);
+            if (m_thread.joinable())
+                m_thread.join();
+        }
+
+        // --- What the post reports ---
+        void SetState(Protocol::DispenserState state) { m_state.store(static_cast<int>(state)); }
+        void SetNozzle(int nozzle) { m_nozzle.store(nozzle); }
+        void SetVolume(int centiliters) { m_volume.store(centiliters); }
+        void SetMoney(int money) { m_money.store(money); }
+        void SetPrice(int price) { m_price.store(price); }
+        void SetTotal(long long centiliters) { m_total.store(centiliters); }
+
+        /// Turnaround before each reply (ms)
+        void SetReplyDelayMs(int ms) { m_replyDelayMs.store(ms); }
+
+        /// Further delay before replies to one command letter (ms)
+        void SetExtraDelayMs(char cmd, int ms) { m_extraDelayMs[static_cast<uint8_t>(cmd) & 0x7F].store(ms); }
+
+        /// Requests received with this command letter
+        uint64_t GetRequests(char cmd) const { return m_requests[static_cast<uint8_t>(cmd) & 0x7F].load(); }
+        uint64_t GetReplies() const { return m_replies.load(); }
+
+        /// steady_clock time (ns since epoch) the last reply was written
+        int64_t GetLastReplyNs() const { return m_lastReplyNs.load(); }
+
+    private:
+        int m_fd;
+        uint8_t m_addrLo;
+        std::thread m_thread;
+        std::atomic<bool> m_running{ true };
+
+        std::atomic<int> m_state{ static_cast<int>(Protocol::DispenserState::Idle) };
+        std::atomic<int> m_nozzle{ 1 };
+        std::atomic<int> m_volume{ 0 };
+        std::atomic<int> m_money{ 0 };
+        std::atomic<int> m_price{ 4590 };
+        std::atomic<long long> m_total{ 123456 };
+        std::atomic<int> m_replyDelayMs{ 2 };
+        std::atomic<int> m_extraDelayMs[128] = {};
+
+        std::atomic<uint64_t> m_requests[128] = {};
+        std::atomic<uint64_t> m_replies{ 0 };
+        std::atomic<int64_t> m_lastReplyNs{ 0 };
+
+        /// Request frame length by command letter (standard dialect)
+        static size_t RequestLength(char cmd)
+        {
+            switch (cmd)
+            {
+            case 'C':           return 6;           // C + nozzle
+            case 'V': case 'M': return 5 + 13;      // Vg;vvvvvv;pppp
+            default:            return 5;
+            }
+        }
+
+        void Run()
+        {
+            Bytes buf;
+            uint8_t chunk[256];
+
+            while (m_running.load())
+            {
+                pollfd pfd = { m_fd, POLLIN, 0 };
+                if (poll(&pfd, 1, 20) <= 0) continue;
+
+                const ssize_t n = read(m_fd, chunk, sizeof(chunk));
+                if (n <= 0) continue;
+                buf.insert(buf.end(), chunk, chunk + n);
+
+                while (!buf.empty())
+                {
+                    if (buf[0] != Protocol::STX) { buf.erase(buf.begin()); continue; }
+                    if (buf.size() < 4) break;
+
+                    const char cmd = static_cast<char>(buf[3]);
+                    const size_t length = RequestLength(cmd);
+                    if (buf.size() < length) break;
+
+                    uint8_t crc = 0;
+                    for (size_t i = 1; i + 1 < length; i++)
+                        crc ^= buf[i];
+                    const bool ok = crc == buf[length - 1] && buf[2] == m_addrLo;
+                    buf.erase(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(length));
+
+                    if (!ok) continue;
+                    m_requests[static_cast<uint8_t>(cmd) & 0x7F].fetch_add(1);
+                    Reply(cmd);
+                }
+            }
+        }
+
+        void Reply(char cmd)
+        {
+            char payload[32];
+            const int state = m_state.load();
+            const int nozzle = m_nozzle.load();
+
+            switch (cmd)
+            {
+            case 'L':
+                snprintf(payload, sizeof(payload), "L%dA%d;%06d", nozzle, state, m_volume.load());
+                break;
+            case 'R':
+                snprintf(payload, sizeof(payload), "R%dA%d;%06d", nozzle, state, m_money.load());
+                break;
+            case 'T':
+                snprintf(payload, sizeof(payload), "T%dA%d;%06d;%06d;%04d", nozzle, state,
+                         m_money.load(), m_volume.load(), m_price.load());
+                break;
+            case 'C':
+                snprintf(payload, sizeof(payload), "C%d;%09lld", nozzle, m_total.load());
+                break;
+            default:
+                snprintf(payload, sizeof(payload), "S%d%d", state, nozzle);
+                break;
+            }
+
+            const int delayMs = m_replyDelayMs.load() + m_extraDelayMs[static_cast<uint8_t>(cmd) & 0x7F].load();
+            if (delayMs > 0) usleep(static_cast<useconds_t>(delayMs) * 1000);
+
+            const Bytes frame = MakeFrame(payload, 0x00, m_addrLo);
+            m_lastReplyNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+            if (write(m_fd, frame.data(), frame.size()) == static_cast<ssize_t>(frame.size()))
+                m_replies.fetch_add(1);
+        }
+    };
+
+} // namespace Test
+} // namespace FuelMaster
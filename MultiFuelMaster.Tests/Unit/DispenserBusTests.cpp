@@ -0,0 +1,104 @@
+// ============================================================
+// DispenserBusTests.cpp — Shared line lifetime (Linux, pty)
+// ============================================================
+
+#include "DispenserBus.h"
+#include "DispenserController.h"
+#include "PtyTransport.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+using namespace FuelMaster;
+
+namespace
+{
+    /// PtyTransport that counts its Close calls (the counter outlives it)
+    class ClosingPty : public PtyTransport
+    {
+    public:
+        explicit ClosingPty(std::shared_ptr<std::atomic<int>> closes) : m_closes(std::move(closes)) {}
+
+        void Close() override
+        {
+            m_closes->fetch_add(1);
+            PtyTransport::Close();
+        }
+
+    private:
+        std::shared_ptr<std::atomic<int>> m_closes;
+    };
+} // anonymous namespace
+
+TEST(DispenserBus, CloseDetachesControllers)
+{
+    DispenserBus bus;
+    ASSERT_TRUE(bus.Open(std::make_unique<PtyTransport>(), "pty"));
+
+    DispenserController first;
+    DispenserController second;
+    ASSERT_TRUE(first.Connect(bus, "01"));
+    ASSERT_TRUE(second.Connect(bus, "02"));
+    EXPECT_EQ(bus.GetMemberCount(), 2u);
+
+    bus.Close();
+    EXPECT_EQ(bus.GetMemberCount(), 0u);
+
+    first.Disconnect();
+    second.Disconnect();
+}
+
+TEST(DispenserBus, ControllerOutlivesBus)
+{
+    // Disconnect and queued commands after the bus is gone must not
+    // reach it (AddressSanitizer reports the stale pointer otherwise)
+    DispenserController controller;
+    {
+        DispenserBus bus;
+        ASSERT_TRUE(bus.Open(std::make_unique<PtyTransport>(), "pty"));
+        ASSERT_TRUE(controller.Connect(bus, "01"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    controller.QueueStop();
+    controller.Disconnect();
+    EXPECT_FALSE(controller.IsConnected());
+}
+
+TEST(DispenserBus, DisconnectAfterCloseLeavesTheBusTransportAlone)
+{
+    auto closes = std::make_shared<std::atomic<int>>(0);
+    DispenserController controller;
+    {
+        DispenserBus bus;
+        ASSERT_TRUE(bus.Open(std::make_unique<ClosingPty>(closes), "pty"));
+        ASSERT_TRUE(controller.Connect(bus, "01"));
+        EXPECT_TRUE(controller.IsConnected());
+
+        bus.Close();
+        EXPECT_FALSE(controller.IsConnected());
+    }
+    const int closedByBus = closes->load();
+
+    controller.Disconnect();
+    EXPECT_EQ(closes->load(), closedByBus);
+    EXPECT_FALSE(controller.IsConnected());
+}
+
+TEST(DispenserBus, FailedAttachIsNotConnected)
+{
+    DispenserBus bus;
+    ASSERT_TRUE(bus.Open(std::make_unique<PtyTransport>(), "pty"));
+
+    DispenserController first;
+    DispenserController second;
+    ASSERT_TRUE(first.Connect(bus, "01"));
+    EXPECT_FALSE(second.Connect(bus, "01"));   // address taken
+    EXPECT_FALSE(second.IsConnected());
+
+    second.Disconnect();
+    EXPECT_TRUE(first.IsConnected());
+    first.Disconnect();
+    EXPECT_FALSE(first.IsConnected());
+}
@@ -0,0 +1,240 @@
+// ============================================================
+// DispenserControllerPtyTests.cpp — Controller over a pty loopback
+// ============================================================
+// DispenserController drives a PtyTransport whose other end is a
+// simulated post (PtyDispenser.h): the real polling thread,
+// transport, decoder and FSM, with no hardware on the line.
+// ============================================================
+
+#include "DispenserController.h"
+#include "PtyDispenser.h"
+#include "PtyTransport.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace FuelMaster;
+using Protocol::DispenserState;
+namespace Samples = FuelMaster::Test;
+
+namespace
+{
+    /// Poll a condition for up to timeoutMs
+    template <typename Predicate>
+    bool WaitFor(Predicate predicate, int timeoutMs = 3000)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            if (predicate()) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return predicate();
+    }
+
+    class ControllerOverPty : public ::testing::Test
+    {
+    protected:
+        DispenserController controller;
+        std::unique_ptr<Samples::PtyDispenser> dispenser;
+
+        void SetUp() override
+        {
+            auto pty = std::make_unique<PtyTransport>();
+            ASSERT_GE(pty->GetPeerFd(), 0);
+            dispenser = std::make_unique<Samples::PtyDispenser>(pty->GetPeerFd());
+            ASSERT_TRUE(controller.Connect(std::move(pty), "pty", "01"));
+        }
+
+        void TearDown() override
+        {
+            controller.Disconnect();
+            dispenser->Stop();
+        }
+    };
+
+    /// One attempt per request, and replies to one letter that come
+    /// well after responseTimeoutMs: they can only arrive as late frames
+    class LateRepliesOverPty : public ::testing::Test
+    {
+    protected:
+        DispenserController controller;
+        std::unique_ptr<Samples::PtyDispenser> dispenser;
+
+        void Start(char lateCmd)
+        {
+            TimingParams timing = TimingParams::Default();
+            timing.maxRetries = 1;
+            controller.SetTimingParams(timing);
+
+            auto pty = std::make_unique<PtyTransport>();
+            ASSERT_GE(pty->GetPeerFd(), 0);
+            dispenser = std::make_unique<Samples::PtyDispenser>(pty->GetPeerFd());
+            dispenser->SetExtraDelayMs(lateCmd, timing.responseTimeoutMs + 70);
+            ASSERT_TRUE(controller.Connect(std::move(pty), "pty", "01"));
+        }
+
+        void TearDown() override
+        {
+            controller.Disconnect();
+            if (dispenser) dispenser->Stop();
+        }
+    };
+} // anonymous namespace
+
+TEST_F(ControllerOverPty, FollowsTheDispenserState)
+{
+    EXPECT_TRUE(controller.IsConnected());
+    EXPECT_TRUE(WaitFor([&] { return dispenser->GetRequests('S') >= 2; }));
+    EXPECT_EQ(controller.GetCurrentState(), DispenserState::Idle);
+
+    dispenser->SetState(DispenserState::Calling);
+    EXPECT_TRUE(WaitFor([&] { return controller.GetCurrentState() == DispenserState::Calling; }));
+    EXPECT_EQ(controller.GetCurrentNozzle(), 1);
+    EXPECT_EQ(controller.GetNoResponseCount(), 0);
+    EXPECT_EQ(controller.GetCrcErrorCount(), 0);
+}
+
+TEST_F(ControllerOverPty, FuellingPollsVolumeAndMoney)
+{
+    std::atomic<int> fuelCallbacks{ 0 };
+    controller.SetFuelDataCallback([&](double, double) { fuelCallbacks++; });
+
+    dispenser->SetVolume(1234);
+    dispenser->SetMoney(5678);
+    dispenser->SetState(DispenserState::Fuelling);
+
+    EXPECT_TRUE(WaitFor([&] {
+        return controller.GetCurrentLiters() == 12.34 && controller.GetCurrentMoney() == 5678.0;
+    }));
+    EXPECT_GT(dispenser->GetRequests('L'), 0u);
+    EXPECT_GT(dispenser->GetRequests('R'), 0u);
+    EXPECT_GT(fuelCallbacks.load(), 0);
+}
+
+TEST_F(ControllerOverPty, StoppedFetchesTransactionAndTotalsOnce)
+{
+    dispenser->SetState(DispenserState::Fuelling);
+    ASSERT_TRUE(WaitFor([&] { return controller.GetCurrentState() == DispenserState::Fuelling; }));
+
+    dispenser->SetVolume(2500);
+    dispenser->SetMoney(11475);
+    dispenser->SetTotal(9876543);
+    dispenser->SetState(DispenserState::Stopped);
+
+    ASSERT_TRUE(WaitFor([&] { return controller.IsTransactionDataReady() && controller.GetTotalCounter() > 0; }));
+    EXPECT_DOUBLE_EQ(controller.GetCurrentLiters(), 25.0);
+    EXPECT_DOUBLE_EQ(controller.GetCurrentMoney(), 11475.0);
+    EXPECT_DOUBLE_EQ(controller.GetTotalCounter(), 98765.43);
+
+    // Further S81 replies only poll SR
+    const uint64_t requestsT = dispenser->GetRequests('T');
+    ASSERT_TRUE(WaitFor([&] { return dispenser->GetRequests('S') >= 5; }));
+    EXPECT_EQ(dispenser->GetRequests('T'), requestsT);
+    EXPECT_EQ(requestsT, 1u);
+
+    dispenser->SetState(DispenserState::EndOfTransaction);
+    EXPECT_TRUE(WaitFor([&] { return dispenser->GetRequests('N') == 1; }));
+}
+
+TEST_F(ControllerOverPty, QueuedCommandReachesTheLine)
+{
+    dispenser->SetState(DispenserState::Fuelling);
+    ASSERT_TRUE(WaitFor([&] { return controller.GetCurrentState() == DispenserState::Fuelling; }));
+
+    controller.QueueStop();
+    EXPECT_TRUE(WaitFor([&] { return dispenser->GetRequests('B') == 1; }));
+    EXPECT_FALSE(controller.HasPendingCommands());
+}
+
+TEST_F(ControllerOverPty, PassiveModeWaitsForTheNextConnect)
+{
+    std::atomic<int> errors{ 0 };
+    controller.SetErrorCallback([&](const std::string&) { errors++; });
+
+    // Requested mid-session: this session keeps polling and sending
+    controller.SetPassiveMode(true);
+    EXPECT_TRUE(controller.IsPassiveMode());
+    EXPECT_FALSE(controller.IsPassiveSession());
+
+    controller.QueueStop();
+    EXPECT_TRUE(WaitFor([&] { return dispenser->GetRequests('B') == 1; }));
+    EXPECT_EQ(errors.load(), 0);
+
+    const uint64_t polled = dispenser->GetRequests('S');
+    EXPECT_TRUE(WaitFor([&] { return dispenser->GetRequests('S') > polled; }));
+}
+
+TEST_F(ControllerOverPty, DisconnectStopsPolling)
+{
+    ASSERT_TRUE(WaitFor([&] { return dispenser->GetRequests('S') >= 1; }));
+    controller.Disconnect();
+
+    const uint64_t polled = dispenser->GetRequests('S');
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(dispenser->GetRequests('S'), polled);
+    EXPECT_FALSE(controller.IsConnected());
+}
+
+TEST_F(ControllerOverPty, FuellingPollsBackToBackByDefault)
+{
+    dispenser->SetState(DispenserState::Fuelling);
+    ASSERT_TRUE(WaitFor([&] { return controller.GetCurrentState() == DispenserState::Fuelling; }));
+    controller.ResetPollCadence();
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+
+    // SR, LM and RS each followed by the line gap, then the next cycle at once
+    const TimingParams timing = TimingParams::Default();
+    const PollPhaseStats active = controller.GetPollCadence().Of(PollPhase::Active);
+    EXPECT_EQ(active.targetMs, 0);
+    ASSERT_GT(active.periods, 5u);
+    EXPECT_GE(active.meanMs, 3.0 * timing.interCommandDelayMs - 1.0);
+    EXPECT_LT(active.meanMs, 3.0 * timing.interCommandDelayMs + 40.0);
+    EXPECT_EQ(active.overruns, 0u);
+}
+
+TEST_F(LateRepliesOverPty, LateStatusStillDrivesTheFsm)
+{
+    Start('S');
+    dispenser->SetVolume(1234);
+    dispenser->SetState(DispenserState::Fuelling);
+
+    // Every SR times out; the FSM follows the S replies that come after
+    EXPECT_TRUE(WaitFor([&] { return controller.GetCurrentState() == DispenserState::Fuelling; }));
+    EXPECT_TRUE(WaitFor([&] { return controller.GetCurrentLiters() == 12.34; }));
+    EXPECT_GT(controller.GetLateFrames(), 0u);
+    EXPECT_GT(controller.GetNoResponseCount(), 0);
+}
+
+TEST_F(LateRepliesOverPty, LateTransactionIsReportedOnce)
+{
+    Start('T');
+    std::atomic<int> completions{ 0 };
+    double liters = 0.0, money = 0.0;
+    controller.SetTransactionCompleteCallback([&](double l, double m, int) {
+        liters = l;
+        money = m;
+        completions++;
+    });
+
+    dispenser->SetState(DispenserState::Fuelling);
+    ASSERT_TRUE(WaitFor([&] { return controller.GetCurrentState() == DispenserState::Fuelling; }));
+
+    dispenser->SetVolume(2500);
+    dispenser->SetMoney(11475);
+    dispenser->SetState(DispenserState::Stopped);
+
+    // TU is one-shot and times out; its T reply still completes the transaction
+    ASSERT_TRUE(WaitFor([&] { return completions.load() > 0; }));
+    EXPECT_TRUE(controller.IsTransactionDataReady());
+    EXPECT_DOUBLE_EQ(liters, 25.0);
+    EXPECT_DOUBLE_EQ(money, 11475.0);
+    EXPECT_GT(controller.GetLateFrames(), 0u);
+
+    ASSERT_TRUE(WaitFor([&] { return dispenser->GetRequests('S') >= 10; }));
+    EXPECT_EQ(dispenser->GetRequests('T'), 1u);
+    EXPECT_EQ(completions.load(), 1);
+}
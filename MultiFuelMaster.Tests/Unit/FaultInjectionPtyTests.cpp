@@ -0,0 +1,159 @@
+// ============================================================
+// FaultInjectionPtyTests.cpp — Update rate and recovery under faults
+// ============================================================
+// DispenserController polls a fuelling post (PtyDispenser.h)
+// through FaultInjectionTransport(PtyTransport). Each profile
+// runs with a fixed seed for a fixed time; the LinkStats the
+// controller keeps, and the line FaultInjectionTransport::Report
+// prints from them, are checked against what the faults imply.
+// ============================================================
+
+#include "DispenserController.h"
+#include "FaultInjectionTransport.h"
+#include "PtyDispenser.h"
+#include "PtyTransport.h"
+#include <chrono>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace FuelMaster;
+using Protocol::DispenserState;
+namespace Samples = FuelMaster::Test;
+
+namespace
+{
+    constexpr int RUN_MS = 1500;
+
+    struct RunResult
+    {
+        LinkStats link;
+        FaultStats faults;
+        std::string report;
+    };
+
+    /// Poll a fuelling post through the given profile for RUN_MS
+    RunResult RunProfile(const FaultProfile& profile)
+    {
+        auto pty = std::make_unique<PtyTransport>();
+        EXPECT_GE(pty->GetPeerFd(), 0);
+        Samples::PtyDispenser dispenser(pty->GetPeerFd());
+        dispenser.SetVolume(1234);
+        dispenser.SetMoney(5678);
+        dispenser.SetState(DispenserState::Fuelling);
+
+        auto faulty = std::make_unique<FaultInjectionTransport>(std::move(pty), profile);
+        FaultInjectionTransport* transport = faulty.get();
+
+        DispenserController controller;
+        EXPECT_TRUE(controller.Connect(std::move(faulty), "pty", "01"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(RUN_MS));
+
+        RunResult result;
+        result.link = controller.GetLinkStats();
+        result.faults = transport->GetFaultStats();
+        result.report = transport->Report(result.link);
+
+        controller.Disconnect();
+        dispenser.Stop();
+        return result;
+    }
+
+    /// The "<rate> updates/s" figure as Report prints it
+    std::string RateText(const LinkStats& link)
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "%.1f updates/s", link.UpdateRate());
+        return text;
+    }
+
+    double RecoveringShare(const LinkStats& link)
+    {
+        return static_cast<double>(link.recoveryUs) / 1e6 / link.elapsedSec;
+    }
+} // anonymous namespace
+
+TEST(FaultInjectionOverPty, CleanLineNeverRecovers)
+{
+    const RunResult r = RunProfile(FaultProfile::Default());
+
+    EXPECT_EQ(r.link.failedAttempts, 0u);
+    EXPECT_EQ(r.link.recoveries, 0u);
+    EXPECT_EQ(r.link.recoveryUs, 0u);
+    EXPECT_GE(r.link.elapsedSec, RUN_MS / 1000.0);
+
+    // SR+LM+RS every active poll period
+    EXPECT_GE(r.link.UpdateRate(), 10.0);
+    EXPECT_EQ(r.faults.droppedBytes + r.faults.flippedBytes + r.faults.delays, 0u);
+
+    EXPECT_EQ(r.report.rfind("clean: ", 0), 0u) << r.report;
+    EXPECT_NE(r.report.find(RateText(r.link)), std::string::npos) << r.report;
+    EXPECT_NE(r.report.find("recovering 0.0% (0 episodes"), std::string::npos) << r.report;
+}
+
+TEST(FaultInjectionOverPty, NoisyLineRecoversAndKeepsUpdating)
+{
+    FaultProfile profile = FaultProfile::NoisyLine();
+    profile.byteDrop = 0.02;
+    profile.bitFlip = 0.02;
+    profile.seed = 1234;
+
+    const RunResult clean = RunProfile(FaultProfile::Default());
+    const RunResult r = RunProfile(profile);
+
+    EXPECT_GT(r.faults.droppedBytes + r.faults.flippedBytes, 0u);
+    EXPECT_GT(r.link.failedAttempts, 0u);
+    EXPECT_GT(r.link.recoveries, 0u);
+    EXPECT_LE(r.link.recoveries, r.link.failedAttempts);
+    EXPECT_GT(r.link.recoveryUs, 0u);
+    EXPECT_LE(r.link.maxRecoveryUs, r.link.recoveryUs);
+    EXPECT_LT(RecoveringShare(r.link), 1.0);
+
+    // Retries cost line time, but the post is still followed
+    EXPECT_GT(r.link.UpdateRate(), 0.0);
+    EXPECT_LT(r.link.UpdateRate(), clean.link.UpdateRate());
+
+    EXPECT_EQ(r.report.rfind("noisy-line: ", 0), 0u) << r.report;
+    EXPECT_NE(r.report.find(RateText(r.link)), std::string::npos) << r.report;
+}
+
+TEST(FaultInjectionOverPty, LateRepliesCountAsRecoveryTime)
+{
+    FaultProfile profile = FaultProfile::SlowDispenser();
+    profile.delay = 0.2;
+    profile.seed = 42;
+
+    const TimingParams timing = TimingParams::Default();
+    const RunResult r = RunProfile(profile);
+
+    EXPECT_GT(r.faults.delays, 0u);
+    EXPECT_GT(r.link.recoveries, 0u);
+    EXPECT_GT(r.link.failedAttempts, 0u);
+
+    // A reply past the timeout costs at least one more attempt
+    EXPECT_GE(r.link.maxRecoveryUs, static_cast<uint64_t>(timing.responseTimeoutMs) * 1000 / 2);
+    EXPECT_GT(RecoveringShare(r.link), 0.0);
+
+    char episodes[64];
+    snprintf(episodes, sizeof(episodes), "(%llu episodes",
+             static_cast<unsigned long long>(r.link.recoveries));
+    EXPECT_EQ(r.report.rfind("slow-dispenser: ", 0), 0u) << r.report;
+    EXPECT_NE(r.report.find(episodes), std::string::npos) << r.report;
+    EXPECT_NE(r.report.find(RateText(r.link)), std::string::npos) << r.report;
+}
+
+TEST(FaultInjectionOverPty, FragmentedRepliesStillAssemble)
+{
+    FaultProfile profile = FaultProfile::FragmentingAdapter();
+    profile.splitGapMaxMs = 5;
+    profile.seed = 7;
+
+    const RunResult r = RunProfile(profile);
+
+    // Short gaps stay inside the inter-byte allowance: no retries
+    EXPECT_GT(r.faults.splits, 0u);
+    EXPECT_EQ(r.link.failedAttempts, 0u);
+    EXPECT_GE(r.link.UpdateRate(), 10.0);
+}
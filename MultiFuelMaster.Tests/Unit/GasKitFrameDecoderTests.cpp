@@ -0,0 +1,140 @@
+// ============================================================
+// GasKitFrameDecoderTests.cpp — Stream decoder resync cases
+// ============================================================
+
+#include "GasKitFrameDecoder.h"
+#include "GasKitSamples.h"
+#include <gtest/gtest.h>
+#include <utility>
+
+using namespace FuelMaster;
+using namespace FuelMaster::Protocol;
+namespace Samples = FuelMaster::Test;
+
+namespace
+{
+    /// Push bytes one at a time; frames in order of completion,
+    /// with the index of the byte that completed each
+    struct Decoded
+    {
+        std::vector<Samples::Bytes> frames;
+        std::vector<size_t> completedAt;
+    };
+
+    Decoded PushAll(FrameDecoder& decoder, const Samples::Bytes& line)
+    {
+        Decoded out;
+        for (size_t i = 0; i < line.size(); i++)
+        {
+            if (!decoder.Push(line[i])) continue;
+            do
+            {
+                const Frame& frame = decoder.GetFrame();
+                out.frames.emplace_back(frame.data(), frame.data() + frame.size());
+                out.completedAt.push_back(i);
+                decoder.ConsumeFrame();
+            } while (decoder.Drain());
+        }
+        return out;
+    }
+
+    Samples::Bytes Concat(std::initializer_list<Samples::Bytes> parts)
+    {
+        Samples::Bytes line;
+        for (const Samples::Bytes& part : parts)
+            line.insert(line.end(), part.begin(), part.end());
+        return line;
+    }
+} // anonymous namespace
+
+TEST(FrameDecoder, SampleCaptureYieldsEveryValidReply)
+{
+    FrameDecoder decoder;
+    decoder.SetAddressFilter(0x00, 0x01);
+    Decoded out = PushAll(decoder, Samples::SampleLineCapture());
+
+    // 8 sample replies + the trailing S; the corrupt L and post 2 are dropped
+    ASSERT_EQ(out.frames.size(), std::size(Samples::STANDARD_REPLIES) + 1);
+    EXPECT_EQ(out.frames.back(), Samples::MakeFrame("S91"));
+    EXPECT_EQ(decoder.GetCrcErrors(), 1u);
+}
+
+TEST(FrameDecoder, ShortReplyBehindNoiseHeaderIsNotSwallowed)
+{
+    // Noise that looks like the header of a 27-byte T reply, then
+    // the real 7-byte S reply: it must come out when its CRC arrives,
+    // not after the T candidate gives up
+    const Samples::Bytes noise = { STX, 0x00, 0x01, 'T' };
+    const Samples::Bytes reply = Samples::MakeFrame("S61");
+    const Samples::Bytes line = Concat({ noise, reply });
+
+    FrameDecoder decoder;
+    decoder.SetAddressFilter(0x00, 0x01);
+    Decoded out = PushAll(decoder, line);
+
+    ASSERT_EQ(out.frames.size(), 1u);
+    EXPECT_EQ(out.frames[0], reply);
+    EXPECT_EQ(out.completedAt[0], line.size() - 1);
+    EXPECT_EQ(decoder.GetBytesDiscarded(), noise.size());
+    EXPECT_FALSE(decoder.HasPartialFrame());
+}
+
+TEST(FrameDecoder, BytesNeededAllowsForAReplyBehindANoiseHeader)
+{
+    FrameDecoder decoder;
+    for (uint8_t b : { STX, uint8_t(0x00), uint8_t(0x01), uint8_t('T') })
+        decoder.Push(b);
+
+    // The T candidate needs 23 more, but a 7-byte S may start next
+    EXPECT_EQ(decoder.BytesNeeded(), 7u);
+
+    decoder.Push(STX);
+    decoder.Push(0x00);
+    EXPECT_EQ(decoder.BytesNeeded(), 5u);
+}
+
+TEST(FrameDecoder, ReplyOfPostTwoIsNotCutAtItsAddressByte)
+{
+    // addrLo 0x02 equals STX: the inner "STX" must not produce a frame
+    const Samples::Bytes reply = Samples::MakeFrame("T1A9;005678;001234;4590", 0x00, 0x02);
+
+    FrameDecoder decoder;
+    decoder.SetAddressFilter(0x00, 0x02);
+    Decoded out = PushAll(decoder, reply);
+
+    ASSERT_EQ(out.frames.size(), 1u);
+    EXPECT_EQ(out.frames[0], reply);
+}
+
+TEST(FrameDecoder, AddressByteEqualToStxDoesNotShrinkBytesNeeded)
+{
+    // A T header waits for the shortest reply whatever the address:
+    // an address byte equal to STX is not an inner frame start
+    const std::pair<uint8_t, uint8_t> addresses[] = { { 0x00, 0x01 }, { 0x00, 0x02 }, { 0x02, 0x00 } };
+    for (const auto& [addrHi, addrLo] : addresses)
+    {
+        const Samples::Bytes reply = Samples::MakeFrame("T1A9;005678;001234;4590", addrHi, addrLo);
+
+        FrameDecoder decoder;
+        for (size_t i = 0; i < 4; i++)
+            decoder.Push(reply[i]);
+        EXPECT_EQ(decoder.BytesNeeded(), 7u) << "address " << int(addrHi) << "/" << int(addrLo);
+
+        for (size_t i = 4; i < reply.size(); i++)
+            decoder.Push(reply[i]);
+        EXPECT_TRUE(decoder.HasFrame());
+        EXPECT_EQ(decoder.GetBytesDiscarded(), 0u);
+    }
+}
+
+TEST(FrameDecoder, CompleteCandidateWinsOverInnerFrame)
+{
+    // A valid frame with nothing inside: emitted whole, nothing discarded
+    const Samples::Bytes line = Concat({ Samples::MakeFrame("L1A6;001234"), Samples::MakeFrame("S10") });
+
+    FrameDecoder decoder;
+    Decoded out = PushAll(decoder, line);
+
+    ASSERT_EQ(out.frames.size(), 2u);
+    EXPECT_EQ(decoder.GetBytesDiscarded(), 0u);
+}
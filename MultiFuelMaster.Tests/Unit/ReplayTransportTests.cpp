@@ -0,0 +1,58 @@
+// ============================================================
+// ReplayTransportTests.cpp — Port name parsing of ReplayTransport
+// ============================================================
+
+#include "GasKitSamples.h"
+#include "ReplayTransport.h"
+#include "WireCapture.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+
+using namespace FuelMaster;
+namespace Samples = FuelMaster::Test;
+
+namespace
+{
+    class ReplayPortName : public ::testing::Test
+    {
+    protected:
+        std::string path;
+
+        void SetUp() override
+        {
+            path = "/tmp/mfm_replay_" + std::to_string(getpid()) + ".cap";
+
+            WireCapture capture;
+            ASSERT_TRUE(capture.Open(path, "COM3"));
+            const Samples::Bytes request = Samples::MakeFrame("S");
+            const Samples::Bytes reply = Samples::MakeFrame("S10");
+            capture.Record(WireDirection::Tx, 0x01, request.data(), request.size());
+            capture.Record(WireDirection::Rx, 0x01, reply.data(), reply.size());
+            capture.Close();
+        }
+
+        void TearDown() override { std::remove(path.c_str()); }
+    };
+} // anonymous namespace
+
+TEST_F(ReplayPortName, SpeedSuffixIsParsed)
+{
+    ReplayTransport replay;
+    ASSERT_TRUE(replay.Open("replay:" + path + "?speed=10")) << replay.GetLastError();
+    EXPECT_DOUBLE_EQ(replay.GetSpeed(), 10.0);
+    EXPECT_EQ(replay.GetCapturedPortName(), "COM3");
+    EXPECT_EQ(replay.GetRecordCount(), 2u);
+}
+
+TEST_F(ReplayPortName, ReopenWithoutSuffixPlaysAtRecordedSpeed)
+{
+    ReplayTransport replay;
+    ASSERT_TRUE(replay.Open("replay:" + path + "?speed=0"));
+    EXPECT_DOUBLE_EQ(replay.GetSpeed(), 0.0);
+
+    replay.Close();
+    ASSERT_TRUE(replay.Open("replay:" + path));
+    EXPECT_DOUBLE_EQ(replay.GetSpeed(), 1.0);
+}
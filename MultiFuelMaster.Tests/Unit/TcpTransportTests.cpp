@@ -0,0 +1,288 @@
+// ============================================================
+// TcpTransportTests.cpp — TcpTransport against a loopback server
+// ============================================================
+// A listening socket on 127.0.0.1 stands in for the Ethernet
+// serial server: it records what the transport sends and plays
+// back replies, split, wrapped in telnet commands or escaped,
+// the way a real server delivers them.
+// ============================================================
+
+#include "GasKitFrameDecoder.h"
+#include "GasKitProtocol.h"
+#include "GasKitSamples.h"
+#include "TcpTransport.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <span>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+using namespace FuelMaster;
+namespace Samples = FuelMaster::Test;
+
+namespace
+{
+    constexpr uint8_t IAC = 255;
+    constexpr uint8_t SB = 250;
+    constexpr uint8_t SE = 240;
+    constexpr uint8_t WILL = 251;
+    constexpr uint8_t WONT = 252;
+    constexpr uint8_t DO = 253;
+    constexpr uint8_t COM_PORT = 44;
+
+    /// One-connection stand-in for a serial server
+    class LoopbackServer
+    {
+    public:
+        LoopbackServer()
+        {
+            m_listen = socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr = {};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = 0;
+            bind(m_listen, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            listen(m_listen, 1);
+
+            socklen_t len = sizeof(addr);
+            getsockname(m_listen, reinterpret_cast<sockaddr*>(&addr), &len);
+            m_port = ntohs(addr.sin_port);
+        }
+
+        ~LoopbackServer()
+        {
+            if (m_peer >= 0) close(m_peer);
+            close(m_listen);
+        }
+
+        std::string Url(const char* scheme) const
+        {
+            return std::string(scheme) + "127.0.0.1:" + std::to_string(m_port);
+        }
+
+        bool Accept()
+        {
+            pollfd pfd = { m_listen, POLLIN, 0 };
+            if (poll(&pfd, 1, 2000) <= 0) return false;
+            m_peer = accept(m_listen, nullptr, nullptr);
+            return m_peer >= 0;
+        }
+
+        /// Everything that arrives within `quietMs` of the previous chunk
+        Samples::Bytes ReadAll(int quietMs = 100)
+        {
+            Samples::Bytes bytes;
+            uint8_t chunk[256];
+            pollfd pfd = { m_peer, POLLIN, 0 };
+            while (poll(&pfd, 1, quietMs) > 0)
+            {
+                const ssize_t n = recv(m_peer, chunk, sizeof(chunk), 0);
+                if (n <= 0) break;
+                bytes.insert(bytes.end(), chunk, chunk + n);
+            }
+            return bytes;
+        }
+
+        /// Exactly `size` bytes, or fewer on timeout
+        Samples::Bytes Read(size_t size, int timeoutMs = 2000)
+        {
+            Samples::Bytes bytes;
+            uint8_t chunk[256];
+            pollfd pfd = { m_peer, POLLIN, 0 };
+            while (bytes.size() < size && poll(&pfd, 1, timeoutMs) > 0)
+            {
+                const ssize_t n = recv(m_peer, chunk, std::min(sizeof(chunk), size - bytes.size()), 0);
+                if (n <= 0) break;
+                bytes.insert(bytes.end(), chunk, chunk + n);
+            }
+            return bytes;
+        }
+
+        void Hangup()
+        {
+            close(m_peer);
+            m_peer = -1;
+        }
+
+        void Send(const Samples::Bytes& bytes)
+        {
+            send(m_peer, bytes.data(), bytes.size(), MSG_NOSIGNAL);
+        }
+
+    private:
+        int m_listen = -1;
+        int m_peer = -1;
+        uint16_t m_port = 0;
+    };
+
+    Samples::Bytes Concat(std::initializer_list<Samples::Bytes> parts)
+    {
+        Samples::Bytes line;
+        for (const Samples::Bytes& part : parts)
+            line.insert(line.end(), part.begin(), part.end());
+        return line;
+    }
+
+    /// 0xFF doubled, as telnet carries a data byte
+    Samples::Bytes Escape(const Samples::Bytes& bytes)
+    {
+        Samples::Bytes out;
+        for (uint8_t b : bytes)
+        {
+            out.push_back(b);
+            if (b == IAC) out.push_back(IAC);
+        }
+        return out;
+    }
+
+    bool Contains(const Samples::Bytes& haystack, const Samples::Bytes& needle)
+    {
+        return std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end()) != haystack.end();
+    }
+
+    /// CPU time of the calling thread (ms)
+    double ThreadCpuMs()
+    {
+        timespec ts = {};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<double>(ts.tv_sec) * 1e3 + static_cast<double>(ts.tv_nsec) / 1e6;
+    }
+
+    Samples::Bytes ToBytes(std::span<const uint8_t> bytes)
+    {
+        return Samples::Bytes(bytes.begin(), bytes.end());
+    }
+} // anonymous namespace
+
+TEST(TcpTransportLoopback, RawModeExchangesFramesAsIs)
+{
+    LoopbackServer server;
+    TcpTransport tcp;
+    ASSERT_TRUE(tcp.Open(server.Url("tcp://"))) << tcp.GetLastError();
+    ASSERT_TRUE(server.Accept());
+    EXPECT_EQ(tcp.GetMode(), TcpTransport::Mode::Raw);
+    EXPECT_TRUE(server.ReadAll(50).empty());   // no negotiation in raw mode
+
+    Protocol::GasKitProtocol codec;
+    const Protocol::Frame request = codec.BuildTransactionRequest();
+    const Samples::Bytes reply = Samples::MakeFrame("T1A9;005678;001234;4590");
+
+    // Reply delivered in two segments 50 ms apart, the first one shorter
+    // than any reply: the wait must sleep through the gap, not spin
+    // (no gap limit, so the read waits for the second segment)
+    std::thread post([&] {
+        EXPECT_EQ(server.Read(request.size()), ToBytes(request));
+        server.Send(Samples::Bytes(reply.begin(), reply.begin() + 3));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        server.Send(Samples::Bytes(reply.begin() + 3, reply.end()));
+    });
+
+    Protocol::FrameDecoder decoder;
+    const double cpuBefore = ThreadCpuMs();
+    const Samples::Bytes received = ToBytes(tcp.SendAndReceive(request, decoder, 500, 0, false));
+    const double cpuMs = ThreadCpuMs() - cpuBefore;
+    post.join();
+
+    EXPECT_LT(cpuMs, 15.0);
+    EXPECT_EQ(received, reply);
+    ASSERT_TRUE(decoder.HasFrame());
+    EXPECT_EQ(ToBytes(decoder.GetFrame()), reply);
+}
+
+TEST(TcpTransportLoopback, Rfc2217NegotiatesAndSendsLineSettings)
+{
+    LoopbackServer server;
+    TcpTransport tcp;
+    ASSERT_TRUE(tcp.Open(server.Url("rfc2217://"))) << tcp.GetLastError();
+    ASSERT_TRUE(server.Accept());
+    EXPECT_EQ(tcp.GetMode(), TcpTransport::Mode::Rfc2217);
+
+    const Samples::Bytes sent = server.ReadAll();
+    const Samples::Bytes hello = {
+        IAC, WILL, COM_PORT,
+        IAC, WILL, 0, IAC, DO, 0,
+        IAC, WILL, 3, IAC, DO, 3
+    };
+    ASSERT_GE(sent.size(), hello.size());
+    EXPECT_TRUE(std::equal(hello.begin(), hello.end(), sent.begin()));
+
+    // 9600 8N1, no flow control
+    EXPECT_TRUE(Contains(sent, { IAC, SB, COM_PORT, 1, 0x00, 0x00, 0x25, 0x80, IAC, SE }));
+    EXPECT_TRUE(Contains(sent, { IAC, SB, COM_PORT, 2, 8, IAC, SE }));
+    EXPECT_TRUE(Contains(sent, { IAC, SB, COM_PORT, 3, 1, IAC, SE }));
+    EXPECT_TRUE(Contains(sent, { IAC, SB, COM_PORT, 4, 1, IAC, SE }));
+    EXPECT_TRUE(Contains(sent, { IAC, SB, COM_PORT, 5, 1, IAC, SE }));
+
+    // A new speed goes to the server at once
+    SerialSettings fast = SerialSettings::Default();
+    fast.baudRate = 19200;
+    ASSERT_TRUE(tcp.Configure(fast));
+    EXPECT_TRUE(Contains(server.ReadAll(), { IAC, SB, COM_PORT, 1, 0x00, 0x00, 0x4B, 0x00, IAC, SE }));
+}
+
+TEST(TcpTransportLoopback, Rfc2217EscapesFFAndStripsTelnetCommands)
+{
+    LoopbackServer server;
+    TcpTransport tcp;
+    ASSERT_TRUE(tcp.Open(server.Url("rfc2217://"))) << tcp.GetLastError();
+    ASSERT_TRUE(server.Accept());
+    server.ReadAll();
+
+    // Post address 0xFF: the request and the reply both carry a data 0xFF
+    Protocol::GasKitProtocol codec(0x00, 0xFF);
+    const Protocol::Frame request = codec.BuildStatusRequest();
+    const Samples::Bytes reply = Samples::MakeFrame("S10", 0x00, 0xFF);
+    const Samples::Bytes escapedRequest = Escape(ToBytes(request));
+    ASSERT_GT(escapedRequest.size(), request.size());
+
+    // Reply interleaved with an option request, a COM-PORT notification
+    // and a NOP; the option must be refused
+    const Samples::Bytes escapedReply = Escape(reply);
+    const Samples::Bytes line = Concat({
+        Samples::Bytes(escapedReply.begin(), escapedReply.begin() + 4),
+        { IAC, DO, 99 },
+        { IAC, SB, COM_PORT, 107, 0x30, IAC, SE },
+        Samples::Bytes(escapedReply.begin() + 4, escapedReply.end() - 1),
+        { IAC, 241 },
+        Samples::Bytes(escapedReply.end() - 1, escapedReply.end()),
+    });
+
+    Samples::Bytes onWire;
+    std::thread post([&] {
+        onWire = server.Read(escapedRequest.size());
+        server.Send(line);
+    });
+
+    Protocol::FrameDecoder decoder;
+    const Samples::Bytes received = ToBytes(tcp.SendAndReceive(request, decoder, 500, 20, false));
+    post.join();
+
+    EXPECT_EQ(onWire, escapedRequest);
+    EXPECT_EQ(received, reply);
+    ASSERT_TRUE(decoder.HasFrame());
+    EXPECT_EQ(ToBytes(decoder.GetFrame()), reply);
+    EXPECT_EQ(server.ReadAll(), Samples::Bytes({ IAC, WONT, 99 }));
+}
+
+TEST(TcpTransportLoopback, ServerClosingIsReported)
+{
+    LoopbackServer server;
+    TcpTransport tcp;
+    ASSERT_TRUE(tcp.Open(server.Url("tcp://")));
+    ASSERT_TRUE(server.Accept());
+    server.Hangup();
+
+    Protocol::GasKitProtocol codec;
+    Protocol::FrameDecoder decoder;
+    const std::span<const uint8_t> received = tcp.SendAndReceive(codec.BuildStatusRequest(), decoder, 200, 20, false);
+
+    EXPECT_TRUE(received.empty());
+    EXPECT_FALSE(tcp.IsOpen());
+}
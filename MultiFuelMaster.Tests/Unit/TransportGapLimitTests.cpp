@@ -0,0 +1,116 @@
+// ============================================================
+// TransportGapLimitTests.cpp — interByteTimeoutMs during reception
+// ============================================================
+// Transport::SendAndReceive over a PtyTransport; the test plays
+// the post on the master side and stalls inside its reply.
+// ============================================================
+
+#include "GasKitFrameDecoder.h"
+#include "GasKitProtocol.h"
+#include "GasKitSamples.h"
+#include "PtyTransport.h"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <span>
+#include <thread>
+#include <unistd.h>
+
+using namespace FuelMaster;
+namespace Samples = FuelMaster::Test;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int RESPONSE_TIMEOUT_MS = 400;
+
+    class GapLimit : public ::testing::Test
+    {
+    protected:
+        PtyTransport pty;
+        Protocol::GasKitProtocol codec;
+        Protocol::FrameDecoder decoder;
+        const Samples::Bytes reply = Samples::MakeFrame("L1A6;001234");
+
+        void SetUp() override
+        {
+            ASSERT_GE(pty.GetPeerFd(), 0);
+            ASSERT_TRUE(pty.Open("pty"));
+        }
+
+        /// Answer the next request with `head` bytes of the reply, then
+        /// the rest after `gapMs` (never, if gapMs < 0)
+        std::thread Post(size_t head, int gapMs)
+        {
+            return std::thread([this, head, gapMs] {
+                uint8_t request[32];
+                pollfd pfd = { pty.GetPeerFd(), POLLIN, 0 };
+                if (poll(&pfd, 1, 1000) <= 0) return;
+                if (read(pty.GetPeerFd(), request, sizeof(request)) <= 0) return;
+
+                EXPECT_EQ(write(pty.GetPeerFd(), reply.data(), head), static_cast<ssize_t>(head));
+                if (gapMs < 0) return;
+                std::this_thread::sleep_for(std::chrono::milliseconds(gapMs));
+                const size_t rest = reply.size() - head;
+                EXPECT_EQ(write(pty.GetPeerFd(), reply.data() + head, rest), static_cast<ssize_t>(rest));
+            });
+        }
+
+        /// SendAndReceive of an LM request; elapsed time in ms
+        long long Exchange(int interByteTimeoutMs, std::vector<uint8_t>& received)
+        {
+            const auto start = Clock::now();
+            const std::span<const uint8_t> raw = pty.SendAndReceive(codec.BuildVolumeRequest(), decoder,
+                RESPONSE_TIMEOUT_MS, interByteTimeoutMs, false);
+            received.assign(raw.begin(), raw.end());
+            return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+        }
+    };
+} // anonymous namespace
+
+TEST_F(GapLimit, StalledReplyEndsTheReadEarly)
+{
+    std::thread post = Post(6, -1);
+    std::vector<uint8_t> received;
+    const long long elapsedMs = Exchange(3, received);
+    post.join();
+
+    // Rest of the reply at 9600 (~8 ms) + 3 ms, not the 400 ms timeout
+    EXPECT_LT(elapsedMs, RESPONSE_TIMEOUT_MS / 4);
+    EXPECT_EQ(received, Samples::Bytes(reply.begin(), reply.begin() + 6));
+    EXPECT_FALSE(decoder.HasFrame());
+}
+
+TEST_F(GapLimit, ZeroWaitsForTheResponseTimeout)
+{
+    std::thread post = Post(6, -1);
+    std::vector<uint8_t> received;
+    const long long elapsedMs = Exchange(0, received);
+    post.join();
+
+    EXPECT_GE(elapsedMs, RESPONSE_TIMEOUT_MS - 5);
+    EXPECT_FALSE(decoder.HasFrame());
+}
+
+TEST_F(GapLimit, GapWithinTheLimitCompletesTheFrame)
+{
+    std::thread post = Post(6, 20);
+    std::vector<uint8_t> received;
+    Exchange(30, received);
+    post.join();
+
+    EXPECT_EQ(received, reply);
+    EXPECT_TRUE(decoder.HasFrame());
+}
+
+TEST_F(GapLimit, GapBeyondTheLimitDropsTheFrame)
+{
+    std::thread post = Post(6, 60);
+    std::vector<uint8_t> received;
+    const long long elapsedMs = Exchange(3, received);
+    post.join();
+
+    EXPECT_LT(elapsedMs, 60);
+    EXPECT_FALSE(decoder.HasFrame());
+}